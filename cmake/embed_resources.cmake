@@ -0,0 +1,84 @@
+# Generates a C++ source embedding every file under RESOURCE_DIR as a constexpr byte array, plus a
+# sorted lookup table used by `tmig::util::getEmbeddedResource`
+#
+# Usage: cmake -DRESOURCE_DIR=<dir> -DRESOURCE_PREFIX=<prefix> -DOUTPUT=<file.cpp> -P embed_resources.cmake
+#
+# Entries are keyed by RESOURCE_PREFIX followed by their path relative to RESOURCE_DIR, matching the
+# paths accepted by `util::getResourcePath`.
+
+if (NOT RESOURCE_DIR OR NOT OUTPUT)
+    message(FATAL_ERROR "embed_resources.cmake requires RESOURCE_DIR and OUTPUT")
+endif()
+
+file(GLOB_RECURSE RESOURCE_FILES RELATIVE ${RESOURCE_DIR} ${RESOURCE_DIR}/*)
+list(SORT RESOURCE_FILES)
+
+# CMake regexes have no {n} quantifier, so spell out a row of 16 bytes for line wrapping
+string(REPEAT "0x[0-9a-f][0-9a-f]," 16 BYTE_ROW)
+
+set(ARRAYS "")
+set(ENTRIES "")
+set(INDEX 0)
+foreach(RESOURCE ${RESOURCE_FILES})
+    file(READ ${RESOURCE_DIR}/${RESOURCE} HEX_CONTENT HEX)
+    file(SIZE ${RESOURCE_DIR}/${RESOURCE} RESOURCE_SIZE)
+
+    # Trailing zero keeps text resources usable as C strings; it is not counted in the size
+    string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," BYTES "${HEX_CONTENT}")
+    string(REGEX REPLACE "(${BYTE_ROW})" "\\1\n    " BYTES "${BYTES}")
+
+    string(APPEND ARRAYS "// ${RESOURCE_PREFIX}${RESOURCE}\nconstexpr unsigned char resource${INDEX}[] = {\n    ${BYTES}0x00\n};\n\n")
+    string(APPEND ENTRIES "    {\"${RESOURCE_PREFIX}${RESOURCE}\", resource${INDEX}, ${RESOURCE_SIZE}},\n")
+    math(EXPR INDEX "${INDEX} + 1")
+endforeach()
+
+if (INDEX EQUAL 0)
+    # Keep the table non-empty so the generated source always compiles
+    set(ENTRIES "    {\"\", nullptr, 0},\n")
+endif()
+
+set(CONTENT "// Generated by cmake/embed_resources.cmake, do not edit
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+
+#include \"tmig/util/resources.hpp\"
+
+namespace tmig::util {
+
+namespace {
+
+struct EmbeddedResource {
+    std::string_view path;
+    const unsigned char* data;
+    size_t size;
+};
+
+${ARRAYS}// Sorted by path for binary search
+constexpr EmbeddedResource embeddedResources[] = {
+${ENTRIES}};
+
+} // namespace
+
+std::optional<std::string_view> getEmbeddedResource(std::string_view path) {
+    const auto it = std::lower_bound(
+        std::begin(embeddedResources), std::end(embeddedResources), path,
+        [](const EmbeddedResource& resource, std::string_view value) { return resource.path < value; }
+    );
+    if (it == std::end(embeddedResources) || it->path != path || it->data == nullptr) {
+        return std::nullopt;
+    }
+    return std::string_view{reinterpret_cast<const char*>(it->data), it->size};
+}
+
+} // namespace tmig::util
+")
+
+# Only touch the output when something changed, so unrelated builds don't recompile it
+if (EXISTS ${OUTPUT})
+    file(READ ${OUTPUT} OLD_CONTENT)
+    if (OLD_CONTENT STREQUAL CONTENT)
+        return()
+    endif()
+endif()
+file(WRITE ${OUTPUT} "${CONTENT}")
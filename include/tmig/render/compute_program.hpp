@@ -0,0 +1,174 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "tmig/render/shader.hpp"
+#include "tmig/render/data_buffer.hpp"
+#include "tmig/render/storage_buffer.hpp"
+#include "tmig/render/texture2D.hpp"
+
+namespace tmig::render {
+
+/// @brief Memory barrier bits, describing how data written by shaders will be accessed afterwards.
+/// Combine them with `|` and pass to `memoryBarrier`
+enum class MemoryBarrierBit : uint32_t {
+    /// @brief Vertex data sourced from buffers written by shaders
+    VERTEX_ATTRIB_ARRAY = 1 << 0,
+
+    /// @brief Index data sourced from buffers written by shaders
+    ELEMENT_ARRAY = 1 << 1,
+
+    /// @brief Uniform blocks sourced from buffers written by shaders
+    UNIFORM = 1 << 2,
+
+    /// @brief Texture sampling of images written by shaders
+    TEXTURE_FETCH = 1 << 3,
+
+    /// @brief Image load/store of images written by shaders
+    SHADER_IMAGE_ACCESS = 1 << 4,
+
+    /// @brief Indirect draw/dispatch commands sourced from buffers written by shaders
+    COMMAND = 1 << 5,
+
+    /// @brief Pixel pack/unpack operations on buffers written by shaders
+    PIXEL_BUFFER = 1 << 6,
+
+    /// @brief Texture uploads/downloads of images written by shaders
+    TEXTURE_UPDATE = 1 << 7,
+
+    /// @brief Buffer reads/writes through the API (e.g. `DataBuffer::setSubset`)
+    BUFFER_UPDATE = 1 << 8,
+
+    /// @brief Framebuffer rendering to images written by shaders
+    FRAMEBUFFER = 1 << 9,
+
+    /// @brief Shader storage block access of buffers written by shaders
+    SHADER_STORAGE = 1 << 10,
+
+    /// @brief Every barrier above
+    ALL = 0xFFFFFFFF,
+};
+
+/// @brief Combine two sets of memory barrier bits
+inline MemoryBarrierBit operator|(MemoryBarrierBit a, MemoryBarrierBit b) {
+    return static_cast<MemoryBarrierBit>(static_cast<uint32_t>(a) | static_cast<uint32_t>(b));
+}
+
+/// @brief Orders shader writes before the accesses described by `barriers`
+/// @note Call this between a dispatch that writes data and any command that reads it
+void memoryBarrier(MemoryBarrierBit barriers);
+
+/// @brief Access mode for an image bound to a compute program
+enum class ImageAccess {
+    /// @brief Image is only read with `imageLoad`
+    READ_ONLY,
+
+    /// @brief Image is only written with `imageStore`
+    WRITE_ONLY,
+
+    /// @brief Image is both read and written
+    READ_WRITE,
+};
+
+/// @brief Layout of a single indirect dispatch command, as read by `ComputeProgram::dispatchIndirect`
+struct DispatchIndirectCommand {
+    uint32_t numGroupsX = 1;
+    uint32_t numGroupsY = 1;
+    uint32_t numGroupsZ = 1;
+};
+
+/// @brief OpenGL compute shader program wrapper class
+///
+/// Uniforms are set with the regular `ShaderProgram` setters. Buffers and images are bound to the
+/// binding points declared in the shader with `bindStorageBuffer` and `bindImage`.
+/// @note - Dispatches are asynchronous; use `memoryBarrier` before consuming their results
+/// @note - This is a non-copyable class, meaning you cannot create a copy of it
+class ComputeProgram : public ShaderProgram {
+public:
+    /// @brief Constructor
+    /// @note Does nothing on its own; you need to call `compileFromFile` or `compileFromSource` to make the program valid
+    ComputeProgram() = default;
+
+    /// @brief Attempts to compile from the given compute shader file
+    /// @return Whether compilation and linking succeeded
+    bool compileFromFile(const std::string& path);
+
+    /// @brief Attempts to compile from compute shader source code
+    /// @return Whether compilation and linking succeeded
+    bool compileFromSource(const std::string& source);
+
+    /// @brief Attempts to load the SPIR-V binary precompiled at build time for the given compute shader
+    /// resource, falling back to compiling its GLSL
+    /// @param path Path relative to resources/, loaded through `util::readResource`
+    /// @note See `ShaderProgram::compilePrecompiled` for when the GLSL is used instead
+    bool compilePrecompiled(const std::string& path, const std::vector<SpecializationConstant>& constants = {});
+
+    /// @brief Compute programs only have a compute stage
+    bool compileFromFiles(const std::string&, const std::string&) = delete;
+
+    /// @brief Compute programs cannot be used in program pipelines
+    bool compileStageFromFile(ShaderStage, const std::string&) = delete;
+
+    /// @brief Compute programs cannot be used in program pipelines
+    bool compileStageFromSource(ShaderStage, const std::string&) = delete;
+
+    /// @brief Compute programs cannot be used in program pipelines
+    bool compileStagePrecompiled(ShaderStage, const std::string&, const std::vector<SpecializationConstant>& = {}) = delete;
+
+    /// @brief Local work group size declared in the shader
+    glm::uvec3 workGroupSize() const { return _workGroupSize; }
+
+    /// @brief Bind the program and launch `x * y * z` work groups
+    void dispatch(uint32_t x, uint32_t y = 1, uint32_t z = 1) const;
+
+    /// @brief Bind the program and launch enough work groups to cover `x * y * z` invocations, rounding
+    /// up by the work group size
+    void dispatchInvocations(uint32_t x, uint32_t y = 1, uint32_t z = 1) const;
+
+    /// @brief Bind the program and launch work groups with the counts stored in a GPU buffer
+    /// @param buffer Buffer holding the dispatch commands, possibly written by a previous dispatch
+    /// @param index Index of the command to use inside `buffer`
+    /// @note If the buffer was written by a shader, call `memoryBarrier(MemoryBarrierBit::COMMAND)` first
+    void dispatchIndirect(const DataBuffer<DispatchIndirectCommand>& buffer, size_t index = 0) const;
+
+    /// @brief Bind a buffer to a shader storage block binding point
+    template<typename T>
+    void bindStorageBuffer(uint32_t binding, const DataBuffer<T>& buffer) const;
+
+    /// @brief Bind a `[offset, offset + count)` element range of a buffer to a shader storage block binding point
+    /// @note `offset * sizeof(T)` must respect `GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT`
+    template<typename T>
+    void bindStorageBuffer(uint32_t binding, const DataBuffer<T>& buffer, size_t offset, size_t count) const;
+
+    /// @brief Bind a storage buffer to a shader storage block binding point
+    /// @note - The binding refers to the current storage; bind again after the buffer grows
+    /// @note - Like `StorageBuffer::bindTo`, an empty buffer is bound with one element
+    template<typename T>
+    void bindStorageBuffer(uint32_t binding, const StorageBuffer<T>& buffer) const;
+
+    /// @brief Bind a texture level to an image unit for `imageLoad`/`imageStore`
+    /// @param unit Image unit, matching the `binding` of the image uniform in the shader
+    /// @param level Mipmap level to bind
+    /// @note The image format declared in the shader must match the texture format. Three-channel, sRGB
+    /// and depth/stencil formats cannot be bound as images
+    void bindImage(uint32_t unit, const Texture2D& texture, ImageAccess access, uint32_t level = 0) const;
+
+private:
+    /// @brief Local work group size, queried after linking
+    glm::uvec3 _workGroupSize{1};
+
+    /// @brief Link a compiled compute shader into a new program, deleting the shader object
+    /// @return Whether linking succeeded; on failure the program is released
+    bool linkComputeProgram(uint32_t shader);
+
+    /// @brief Bind a byte range of a buffer to a shader storage binding point
+    void bindStorageRange(uint32_t binding, uint32_t buffer, size_t offset, size_t size) const;
+};
+
+} // namespace tmig::render
+
+#include "tmig/render/compute_program.inl"
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <algorithm>
+
+#include "tmig/render/compute_program.hpp"
+
+namespace tmig::render {
+
+template<typename T>
+void ComputeProgram::bindStorageBuffer(uint32_t binding, const DataBuffer<T>& buffer) const {
+    bindStorageRange(binding, buffer.id(), 0, buffer.count() * sizeof(T));
+}
+
+template<typename T>
+void ComputeProgram::bindStorageBuffer(uint32_t binding, const DataBuffer<T>& buffer, size_t offset, size_t count) const {
+    bindStorageRange(binding, buffer.id(), offset * sizeof(T), count * sizeof(T));
+}
+
+template<typename T>
+void ComputeProgram::bindStorageBuffer(uint32_t binding, const StorageBuffer<T>& buffer) const {
+    bindStorageRange(binding, buffer.id(), 0, std::max<size_t>(buffer.count(), 1) * sizeof(T));
+}
+
+} // namespace tmig::render
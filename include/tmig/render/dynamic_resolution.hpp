@@ -0,0 +1,137 @@
+#pragma once
+
+#include <optional>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "tmig/core/non_copyable.hpp"
+#include "tmig/render/texture2D.hpp"
+#include "tmig/render/renderbuffer.hpp"
+#include "tmig/render/framebuffer.hpp"
+#include "tmig/render/gpu_timer.hpp"
+
+namespace tmig::render {
+
+/// @brief Struct passed on DynamicResolution constructor for configuration
+struct DynamicResolutionConfig {
+    /// @brief Width of the scene target; the render size never goes above it
+    uint32_t maxWidth = 1920;
+
+    /// @brief Height of the scene target; the render size never goes above it
+    uint32_t maxHeight = 1080;
+
+    /// @brief Format of the scene color texture
+    TextureFormat format = TextureFormat::RGBA8;
+
+    /// @brief Format of the scene depth renderbuffer; none if empty
+    std::optional<DepthAttachmentFormat> depthFormat = DepthAttachmentFormat::DEPTH24_STENCIL8;
+
+    /// @brief GPU time to fit each frame in, in milliseconds
+    float targetFrameTime = 1000.0f / 60.0f;
+
+    /// @brief Lowest render scale, relative to the output size
+    float minScale = 0.5f;
+
+    /// @brief Highest render scale, relative to the output size
+    float maxScale = 1.0f;
+};
+
+/// @brief Renders the scene at a resolution that keeps the GPU frame time under a target
+///
+/// The scene target is allocated once at its maximum size; each frame the scene is drawn into the
+/// bottom-left part of it, `renderWidth` x `renderHeight`, through the viewport. Changing resolution
+/// therefore never reallocates anything. A frame goes like:
+///
+/// 1. `beginFrame` reads the GPU time of earlier frames (a few frames late, without stalling) and picks
+///    the render scale for this one, then starts timing
+///
+/// 2. `bind` binds the scene target with the viewport set to the render size; draw the scene
+///
+/// 3. Upscale `texture` to the output size, e.g. with `postprocessing::UpscaleEffect` and `uvScale`
+///
+/// 4. `endFrame` stops timing, once everything for the frame has been drawn
+///
+/// Rendering cost mostly follows pixel count, so the scale moves towards `sqrt(target / measured)` of the
+/// current one, a few percent per measurement to ride out noise and the latency of the measurements.
+/// @note - Only the render area of `texture` holds the scene; sample it through `uvScale`
+/// @note - This is a non-copyable class, meaning you cannot create a copy of it
+class DynamicResolution : protected core::NonCopyable {
+public:
+    /// @brief Constructor with configuration
+    /// @throws std::runtime_error if the scene target can't be set up
+    DynamicResolution(const DynamicResolutionConfig& config = {});
+
+    /// @brief Update the render scale from finished measurements and start timing the frame
+    /// @param outputWidth Width the scene is upscaled to, usually the window width
+    /// @param outputHeight Height the scene is upscaled to, usually the window height
+    void beginFrame(uint32_t outputWidth, uint32_t outputHeight);
+
+    /// @brief Stop timing the frame
+    void endFrame();
+
+    /// @brief Bind the scene target, with the viewport set to the render size
+    /// @note Clears only touch the render area; `options.setViewport` is ignored
+    void bind(const FramebufferBindOptions& options = {}) const;
+
+    /// @brief Scene color texture, at its maximum size
+    const Texture2D& texture() const { return _texture; }
+
+    /// @brief Scene framebuffer, at its maximum size
+    const Framebuffer& framebuffer() const { return _framebuffer; }
+
+    /// @brief Width of the area rendered this frame
+    uint32_t renderWidth() const { return _renderWidth; }
+
+    /// @brief Height of the area rendered this frame
+    uint32_t renderHeight() const { return _renderHeight; }
+
+    /// @brief Part of `texture` rendered this frame, in texture coordinates
+    glm::vec2 uvScale() const;
+
+    /// @brief Current render scale, relative to the output size
+    float scale() const { return _scale; }
+
+    /// @brief Force a render scale; clamped to the scale range. Only lasts until the next measurement
+    /// unless automatic scaling is disabled
+    void setScale(float scale);
+
+    /// @brief Enable or disable scaling from measured frame times
+    /// @note By default it is enabled
+    void setAutomatic(bool automatic) { _automatic = automatic; }
+
+    /// @brief Whether scaling follows measured frame times
+    bool automatic() const { return _automatic; }
+
+    /// @brief Set the GPU time to fit each frame in, in milliseconds
+    void setTargetFrameTime(float milliseconds) { _config.targetFrameTime = milliseconds; }
+
+    /// @brief GPU time to fit each frame in, in milliseconds
+    float targetFrameTime() const { return _config.targetFrameTime; }
+
+    /// @brief Set the range the render scale stays in
+    void setScaleRange(float minScale, float maxScale);
+
+    /// @brief Smoothed GPU frame time, in milliseconds; 0 until the first measurement arrives
+    float gpuFrameTime() const { return _gpuFrameTime; }
+
+private:
+    /// @brief Move the scale towards the one that fits the target frame time, from the smoothed frame time
+    void updateScale();
+
+    DynamicResolutionConfig _config;
+
+    Texture2D _texture;
+    Renderbuffer _depthBuffer;
+    Framebuffer _framebuffer;
+    GpuTimer _timer;
+
+    float _scale = 1.0f;
+    float _gpuFrameTime = 0.0f;
+    bool _automatic = true;
+
+    uint32_t _renderWidth = 0;
+    uint32_t _renderHeight = 0;
+};
+
+} // namespace tmig::render
@@ -3,9 +3,11 @@
 #include <ostream>
 #include <unordered_map>
 #include <optional>
+#include <vector>
 
 #include "tmig/core/non_copyable.hpp"
 #include "tmig/render/texture2D.hpp"
+#include "tmig/render/renderbuffer.hpp"
 
 namespace tmig::render {
 
@@ -29,38 +31,58 @@ enum class DepthAttachmentFormat {
 
 /// @brief Describes a single color attachment to be used in a framebuffer.
 ///
-/// This structure defines which texture will be used for a specific color attachment index,
-/// and what format the framebuffer should expect for that attachment.
+/// This structure defines which texture (or renderbuffer) will be used for a specific color attachment
+/// index, and what format the framebuffer should expect for that attachment.
+/// @note - Exactly one of `texture` and `renderbuffer` must be set
 /// @note - The framebuffer does not own the texture and will not delete it upon destruction
 /// @note - The texture's current format will be ignored and replaced by the format defined here
 struct FramebufferAttachment {
     /// @brief Pointer to the attached texture (must outlive the framebuffer)
-    Texture2D* texture;
+    Texture2D* texture = nullptr;
 
     /// @brief Format of the attachment
     TextureFormat format;
+
+    /// @brief Pointer to the attached renderbuffer (must outlive the framebuffer), for write-only attachments
+    Renderbuffer* renderbuffer = nullptr;
+
+    /// @brief Whether the content is only needed while the framebuffer is bound. Transient attachments are
+    /// invalidated when another framebuffer gets bound and after `resolveTo`, so the driver can skip
+    /// writing them back to memory
+    bool transient = false;
 };
 
 /// @brief Describes the depth (or depth-stencil) attachment used in a framebuffer.
 ///
-/// This structure specifies a single depth attachment texture and the format it is expected to use.
+/// This structure specifies a single depth attachment texture (or renderbuffer) and the format it is
+/// expected to use.
+/// @note - Exactly one of `texture` and `renderbuffer` must be set
 /// @note - The framebuffer does not own the texture and will not delete it upon destruction
 /// @note - The texture's current format will be ignored and replaced by the format defined here
 struct FramebufferDepthAttachment {
     /// @brief Pointer to the depth texture (must outlive the framebuffer)
-    Texture2D* texture;
+    Texture2D* texture = nullptr;
 
     /// @brief Format of the depth (or depth-stencil) attachment
     DepthAttachmentFormat format;
+
+    /// @brief Pointer to the depth renderbuffer (must outlive the framebuffer); the usual choice when depth
+    /// is never sampled
+    Renderbuffer* renderbuffer = nullptr;
+
+    /// @brief Whether the content is only needed while the framebuffer is bound, see
+    /// `FramebufferAttachment::transient`
+    bool transient = false;
 };
 
 /// @brief Configuration used to initialize a framebuffer.
 ///
 /// This structure describes the dimensions and attachments of a framebuffer.
-/// All attachments will be resized to match dimensions with the framebuffer.
+/// All attachments will be resized to match dimensions with the framebuffer; attachments whose storage
+/// already matches are kept as they are, so a texture can be attached to several framebuffers.
 /// Color attachments are indexed by their key on the attachment map.
 ///
-/// @note - Must have at least one color attachment
+/// @note - Must have at least one color or depth attachment
 /// @note - The framebuffer does not take ownership of the provided textures.
 struct FramebufferConfig {
     /// @brief Width of the framebuffer and all attachments in pixels
@@ -76,6 +98,10 @@ struct FramebufferConfig {
     /// @brief Optional depth (or depth-stencil) attachment. If not provided, the framebuffer will not
     /// have depth or stencil capability.
     std::optional<FramebufferDepthAttachment> depthAttachment = std::nullopt;
+
+    /// @brief Samples per pixel. Above 1, every attachment becomes a multisample texture, which can't be
+    /// sampled directly: render into it, then `resolveTo` a single sample framebuffer
+    uint32_t samples = 1;
 };
 
 /// @brief Options for binding a framebuffer for rendering.
@@ -152,12 +178,35 @@ public:
     /// @param height New height in pixels
     void resize(uint32_t width, uint32_t height);
 
+    /// @brief Framebuffer ID; used internally
+    uint32_t id() const { return _id; }
+
     /// @brief Current framebuffer width
     uint32_t width() const { return _width; }
 
     /// @brief Current framebuffer height
     uint32_t height() const { return _height; }
 
+    /// @brief Samples per pixel; greater than 1 for multisampled framebuffers
+    uint32_t samples() const { return _samples; }
+
+    /// @brief Tell the driver the content of some attachments is no longer needed, so it doesn't have to
+    /// be preserved (or written back to memory on tile-based GPUs)
+    /// @param colorIndices Color attachment indices to invalidate
+    /// @param depth Whether to invalidate the depth (and stencil) attachment
+    /// @note Invalidated attachments have undefined content until rendered into again
+    void invalidate(const std::vector<uint32_t>& colorIndices, bool depth = false) const;
+
+    /// @brief Resolve (or copy) the attachments into `target`, averaging the samples of multisampled ones
+    ///
+    /// Every color attachment index present in both framebuffers is blitted to the same index of `target`.
+    /// @param includeDepth Whether to also copy the depth (and stencil) attachment, taking one sample per
+    /// pixel since depth can't be averaged
+    /// @note - Both framebuffers must have the same size when either is multisampled
+    /// @note - Changes the read buffer of this framebuffer; `target` keeps its draw buffers
+    /// @note - Transient attachments of this framebuffer are invalidated afterwards
+    void resolveTo(Framebuffer& target, bool includeDepth = false) const;
+
     /// @brief Bind the default (screen) framebuffer.
     ///
     /// This binds OpenGL's default framebuffer (usually the window surface).
@@ -165,6 +214,16 @@ public:
     static void bindDefault(uint32_t width, uint32_t height, const FramebufferBindOptions& options = {});
 
 private:
+    /// @brief (Re)allocate the storage of every attachment at the current size and sample count and
+    /// attach it
+    void allocateAttachments();
+
+    /// @brief Route fragment outputs to the color attachments, by index
+    void applyDrawBuffers() const;
+
+    /// @brief Invalidate the attachments marked as transient
+    void invalidateTransient() const;
+
     /// @brief OpenGL ID of the framebuffer
     uint32_t _id = 0;
 
@@ -174,6 +233,9 @@ private:
     /// @brief Height in pixels
     uint32_t _height = 0;
 
+    /// @brief Samples per pixel
+    uint32_t _samples = 1;
+
     /// @brief Whether setup was already called
     bool setupCalled = false;
 
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "tmig/core/non_copyable.hpp"
+
+namespace tmig::render {
+
+/// @brief Measures GPU time spent between `begin` and `end` with `GL_TIME_ELAPSED` queries
+///
+/// Results arrive a few frames late: each measurement uses the next query of a small ring, and `poll`
+/// only reads queries the GPU has finished, so measuring never stalls the CPU waiting for the GPU. If
+/// every query is still in flight when `begin` is called, that measurement is skipped.
+/// @note - `GL_TIME_ELAPSED` queries can't be nested; only one timer can be running at a time
+/// @note - This is a non-copyable class, meaning you cannot create a copy of it
+class GpuTimer : protected core::NonCopyable {
+public:
+    /// @brief Number of measurements that can be in flight at once
+    static constexpr uint32_t QUERY_COUNT = 4;
+
+    /// @brief Constructor
+    GpuTimer();
+
+    /// @brief Destructor
+    ~GpuTimer();
+
+    /// @brief Move constructor
+    GpuTimer(GpuTimer&& other) noexcept;
+
+    /// @brief Move assignment
+    GpuTimer& operator=(GpuTimer&& other) noexcept;
+
+    /// @brief Start measuring GPU commands issued from now on
+    void begin();
+
+    /// @brief Stop measuring; the result is available to `poll` once the GPU is done
+    void end();
+
+    /// @brief Read the measurements the GPU has finished, without waiting for the others
+    /// @return Whether a new measurement arrived; also called by `begin`
+    bool poll();
+
+    /// @brief Whether at least one measurement arrived
+    bool hasResult() const { return _hasResult; }
+
+    /// @brief Latest finished measurement, in milliseconds; 0 until `hasResult`
+    double milliseconds() const { return static_cast<double>(_lastNanoseconds) / 1e6; }
+
+private:
+    /// @brief OpenGL query identifiers
+    std::array<uint32_t, QUERY_COUNT> _queries{};
+
+    /// @brief Index of the oldest query waiting for its result
+    uint32_t _oldest = 0;
+
+    /// @brief Number of queries waiting for their result
+    uint32_t _pending = 0;
+
+    /// @brief Whether a measurement is running, i.e. `begin` got a free query
+    bool _running = false;
+
+    bool _hasResult = false;
+    uint64_t _lastNanoseconds = 0;
+};
+
+} // namespace tmig::render
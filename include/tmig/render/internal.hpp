@@ -1,5 +1,9 @@
 #pragma once
 
+#include <cstdint>
+
+#include "tmig/render/texture2D.hpp"
+
 struct GLFWwindow;
 
 namespace tmig::render::window {
@@ -9,3 +13,36 @@ namespace tmig::render::window {
 GLFWwindow* getGlfwWindow();
 
 } // namespace tmig::render::window
+
+
+namespace tmig::render {
+
+/// @brief Convert a `TextureFormat` into a sized OpenGL internal format
+/// @note This function is not supposed to be used directly
+uint32_t toInternalFormat(TextureFormat format);
+
+/// @brief Convert a `TextureFormat` into an OpenGL pixel data format
+/// @note This function is not supposed to be used directly
+uint32_t toFormat(TextureFormat format);
+
+/// @brief Convert a `TextureFormat` into an OpenGL pixel data type
+/// @note This function is not supposed to be used directly
+uint32_t toType(TextureFormat format);
+
+/// @brief Source format matching the pixel layout of an uncompressed internal format
+/// @note This function is not supposed to be used directly
+TextureFormat sourceFormatFor(TextureFormat format);
+
+/// @brief Convert a `TextureWrapMode` into an OpenGL wrap mode
+/// @note This function is not supposed to be used directly
+uint32_t toGL(TextureWrapMode wrap);
+
+/// @brief Convert a `TextureMinFilter` into an OpenGL filter
+/// @note This function is not supposed to be used directly
+uint32_t toGL(TextureMinFilter filter);
+
+/// @brief Convert a `TextureMagFilter` into an OpenGL filter
+/// @note This function is not supposed to be used directly
+uint32_t toGL(TextureMagFilter filter);
+
+} // namespace tmig::render
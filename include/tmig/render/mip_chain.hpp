@@ -0,0 +1,83 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include "tmig/render/texture2D.hpp"
+
+namespace tmig::render {
+
+/// @brief Downsampling filter used by `MipChain::build`
+enum class MipFilter {
+    /// @brief 2x2 average; fast, slightly blurry
+    BOX,
+
+    /// @brief 4x4 Kaiser-windowed sinc; sharper, keeps more detail in distant textures
+    KAISER,
+};
+
+/// @brief Options for `MipChain::build`
+struct MipChainOptions {
+    /// @brief Downsampling filter
+    MipFilter filter = MipFilter::BOX;
+
+    /// @brief Whether the RGB channels of 3 and 4 channel images are sRGB encoded and must be averaged in
+    /// linear space. Alpha, and every channel of 1 and 2 channel images, is always treated as linear
+    bool srgb = false;
+
+    /// @brief Number of threads used per level; 0 picks the hardware concurrency
+    uint32_t threadCount = 0;
+};
+
+/// @brief A single level of a `MipChain`
+struct MipLevel {
+    uint32_t width = 0;
+    uint32_t height = 0;
+
+    /// @brief Tightly packed 8-bit pixels, `width * height * channels` bytes
+    std::vector<uint8_t> pixels;
+};
+
+/// @brief Full mip chain of an 8-bit image, built on the CPU
+///
+/// An offline alternative to `Texture2D::generateMipmaps`: the chain can be built on worker threads,
+/// kept around (e.g. cached to disk) and uploaded level by level while streaming.
+class MipChain {
+public:
+    /// @brief Build the full chain of a `width` by `height` image with `channels` 8-bit channels
+    /// @param pixels Tightly packed base level pixels; copied as level 0
+    /// @note Levels are computed from a linear float copy of the previous level, so rounding errors
+    /// don't accumulate down the chain
+    static MipChain build(
+        const uint8_t* pixels,
+        uint32_t width,
+        uint32_t height,
+        uint32_t channels,
+        const MipChainOptions& options = {}
+    );
+
+    /// @brief Every level, level 0 being the base image
+    const std::vector<MipLevel>& levels() const { return _levels; }
+
+    /// @brief Number of 8-bit channels per pixel
+    uint32_t channels() const { return _channels; }
+
+    /// @brief Allocate `texture` with a full chain matching this one
+    /// @param srgb Whether 3 and 4 channel chains are stored as `SRGB8`/`SRGBA8`
+    void allocate(Texture2D& texture, bool srgb = false) const;
+
+    /// @brief Upload a single level into a texture allocated by `allocate`
+    void uploadLevel(Texture2D& texture, uint32_t level) const;
+
+    /// @brief Allocate `texture` and upload every level
+    void upload(Texture2D& texture, bool srgb = false) const;
+
+private:
+    /// @brief Levels of the chain
+    std::vector<MipLevel> _levels;
+
+    /// @brief Number of 8-bit channels per pixel
+    uint32_t _channels = 0;
+};
+
+} // namespace tmig::render
\ No newline at end of file
@@ -1,23 +1,45 @@
+#include <memory>
+#include <vector>
+
 #include "tmig/render/postprocessing/effect.hpp"
-#include "tmig/render/framebuffer.hpp"
+#include "tmig/render/render_target_pool.hpp"
 #include "tmig/render/shader.hpp"
+#include "tmig/render/program_pipeline.hpp"
 #include "tmig/render/mesh.hpp"
 #include "tmig/render/postprocessing/blur.hpp"
 
 namespace tmig::render::postprocessing {
 
+/// @brief How `BloomEffect` spreads the excess light
+enum class BloomMode {
+    /// @brief Full resolution bright pass, then `BlurEffect`'s ping-pong Gaussian passes at a fixed size
+    GAUSSIAN,
+
+    /// @brief Downsample through a chain of halving `R11F_G11F_B10F` targets with a 13-tap filter, then
+    /// upsample back with a tent filter, adding every level up. Each pass touches a quarter of the pixels
+    /// of the previous one, so a wide radius costs little more than a full resolution pass
+    PROGRESSIVE,
+};
+
 /// @brief Struct passed on BloomEffect constructor for configuration
 struct BloomConfig {
-    /// @brief Width of the bright pass framebuffer. Should be the window size or larger
+    /// @brief Bloom algorithm
+    BloomMode mode = BloomMode::GAUSSIAN;
+
+    /// @brief Number of downsampled levels in `PROGRESSIVE` mode, the first being half the input size.
+    /// More levels give a wider bloom; the chain stops early when levels get smaller than 2 pixels
+    uint32_t mipCount = 6;
+
+    /// @brief Width of the bright pass framebuffer. Should be the window size or larger; `GAUSSIAN` only
     uint32_t brightPassWidth = 1920;
 
-    /// @brief Height of the bright pass framebuffer. Should be the window size or larger
+    /// @brief Height of the bright pass framebuffer. Should be the window size or larger; `GAUSSIAN` only
     uint32_t brightPassHeight = 1080;
 
-    /// @brief Width of the blur framebuffer. Quite expensive so should be smaller
+    /// @brief Width of the blur framebuffer. Quite expensive so should be smaller; `GAUSSIAN` only
     uint32_t blurWidth = 800;
 
-    /// @brief Height of the blur framebuffer. Quite expensive so should be smaller
+    /// @brief Height of the blur framebuffer. Quite expensive so should be smaller; `GAUSSIAN` only
     uint32_t blurHeight = 800;
 
     /// @brief Width of the output framebuffer. Very fast so could be very big
@@ -25,6 +47,14 @@ struct BloomConfig {
 
     /// @brief Height of the output framebuffer. Very fast so could be very big
     uint32_t outputHeight = 1440;
+
+    /// @brief Format of the output framebuffer. `RGBA8` clamps the result to [0, 1]; use a float format
+    /// such as `RGBA16F` when a `ToneMappingEffect` follows, so it sees the HDR values
+    TextureFormat outputFormat = TextureFormat::RGBA8;
+
+    /// @brief Pool every intermediate target (including the blur's) comes from;
+    /// `getSharedRenderTargetPool` if null
+    std::shared_ptr<RenderTargetPool> pool = nullptr;
 };
 
 /// @brief Class representing a bloom effect for post-processing in a rendering pipeline.
@@ -37,6 +67,12 @@ struct BloomConfig {
 /// 2. Apply a blur to the extracted excess light texture to create a soft glow
 ///
 /// 3. Combine the blurred excess light texture with the original scene to produce the final image
+///
+/// In `BloomMode::PROGRESSIVE`, steps 1 and 2 become a downsample chain, the first downsample keeping
+/// only the excess light, followed by an upsample chain (see `BloomMode`).
+///
+/// The bright pass, blur and mip targets are borrowed from a `RenderTargetPool` only while the effect
+/// runs; the output stays held until the next `apply`.
 class BloomEffect : public Effect {
 public:
     /// @brief Constructor with configuration
@@ -53,13 +89,20 @@ public:
     /// @brief Get current bright excess threshold
     float getThreshold() const { return threshold; }
 
-    /// @brief Set the scale for sampling offsets from the texture on the blur pass
-    /// @note By default it is 1.5f
+    /// @brief Set the scale for sampling offsets from the texture on the blur pass, or of the upsample
+    /// tent filter in `PROGRESSIVE` mode
+    /// @note By default it is 1.0f
     void setOffsetScale(float offsetScale);
 
     /// @brief Get current offset scale
     float getOffsetScale() const { return blurEffect.getOffsetScale(); }
 
+    /// @brief Switch the bloom algorithm
+    void setMode(BloomMode mode) { config.mode = mode; }
+
+    /// @brief Get current bloom algorithm
+    BloomMode getMode() const { return config.mode; }
+
     /// @brief Set the strength of the bloom when applied on the final output
     /// @note By default it is 0.5f
     void setStrength(float strength);
@@ -70,24 +113,34 @@ public:
     virtual const Texture2D& apply(const Texture2D& input, const PostProcessContext& ctx = {}) override;
 
 protected:
+    /// @brief Bright pass and Gaussian blur, into `blurEffect`'s output
+    const Texture2D& gaussianBloom(const Texture2D& input);
+
+    /// @brief Downsample and upsample chains; the result is in `levels[0]`
+    void progressiveBloom(const Texture2D& input, std::vector<RenderTargetPool::Handle>& levels);
+
     // Parameters
     float threshold = 1.5f;
     float strength = 0.5f;
+    BloomConfig config;
+
+    // Targets come from here; declared before the handles so it outlives them
+    std::shared_ptr<RenderTargetPool> pool;
+    RenderTargetPool::Handle output;
 
     // Blur effect used on bright areas
     BlurEffect blurEffect;
 
-    // Framebuffers
-    Framebuffer brightPassFramebuffer;
-    Framebuffer outputFramebuffer;
-
-    // Shaders
+    // Shaders; the screen quad vertex stage is shared with every other effect
+    std::shared_ptr<ShaderProgram> screenQuadStage;
     ShaderProgram brightPassShader;
     ShaderProgram outputShader;
-
-    // Textures
-    Texture2D brightPassTexture;
-    Texture2D outputTexture;
+    ShaderProgram downsampleShader;
+    ShaderProgram upsampleShader;
+    ProgramPipeline brightPassPipeline;
+    ProgramPipeline outputPipeline;
+    ProgramPipeline downsamplePipeline;
+    ProgramPipeline upsamplePipeline;
 
     // Data for the screen quad for intermediate renders
     struct quadVert {
@@ -1,13 +1,29 @@
 #pragma once
 
+#include <memory>
+#include <algorithm>
+
 #include "tmig/render/postprocessing/effect.hpp"
-#include "tmig/render/framebuffer.hpp"
+#include "tmig/render/render_target_pool.hpp"
 #include "tmig/render/shader.hpp"
+#include "tmig/render/program_pipeline.hpp"
+#include "tmig/render/compute_program.hpp"
 #include "tmig/render/texture2D.hpp"
 #include "tmig/render/mesh.hpp"
 
 namespace tmig::render::postprocessing {
 
+/// @brief How `BlurEffect` runs its separable passes
+enum class BlurMethod {
+    /// @brief Full-screen fragment passes; pairs of kernel weights are folded into single bilinear taps,
+    /// so a radius `r` costs `r / 2 + 1` fetches per side and pixel
+    FRAGMENT,
+
+    /// @brief Compute passes loading a row (or column) tile plus its apron into shared memory once, so any
+    /// radius costs about one texture read per pixel and direction
+    COMPUTE,
+};
+
 /// @brief Configuration for the BlurEffect
 struct BlurConfig {
     /// @brief Framebuffer width
@@ -15,11 +31,29 @@ struct BlurConfig {
 
     /// @brief Framebuffer height
     uint32_t height = 720;
+
+    /// @brief Pool the ping-pong targets come from; `getSharedRenderTargetPool` if null
+    std::shared_ptr<RenderTargetPool> pool = nullptr;
+
+    /// @brief How the passes run
+    BlurMethod method = BlurMethod::FRAGMENT;
+
+    /// @brief Kernel radius in texels, up to `BlurEffect::MAX_RADIUS`
+    uint32_t radius = 4;
 };
 
 /// @brief Applies a Gaussian blur effect to a texture
+///
+/// Kernel weights are computed on the CPU from the radius. Each iteration is a horizontal then a vertical
+/// pass, run either as fragment or compute passes (see `BlurMethod`).
+///
+/// Ping-pong targets are borrowed from a `RenderTargetPool` during `apply`; only the output stays
+/// held, until the next `apply` or `releaseOutput`
 class BlurEffect : public Effect {
 public:
+    /// @brief Largest supported kernel radius, in texels
+    static constexpr uint32_t MAX_RADIUS = 64;
+
     /// @brief Constructor with configuration
     BlurEffect(const BlurConfig& config = {});
 
@@ -27,29 +61,66 @@ public:
     ~BlurEffect();
 
     /// @brief Set the scale for sampling offsets from the texture. Larger values create a wider, more diffuse blur
-    /// @note By default it is 1.0f
+    /// @note - By default it is 1.0f
+    /// @note - The radius and standard deviation are scaled before the kernel is built, so it stays an exact
+    /// Gaussian; the scaled radius is rounded to whole texels and clamped to `MAX_RADIUS`
     void setOffsetScale(float offsetScale);
 
     /// @brief Get current offset scale
     float getOffsetScale() const { return offsetScale; }
 
+    /// @brief Set the kernel radius in texels, clamped to `MAX_RADIUS`
+    /// @param sigma Standard deviation of the Gaussian; 0 picks `radius / 2`
+    void setRadius(uint32_t radius, float sigma = 0.0f);
+
+    /// @brief Get current kernel radius, before `offsetScale` is applied
+    uint32_t getRadius() const { return radius; }
+
+    /// @brief Switch between fragment and compute passes
+    void setMethod(BlurMethod method) { this->method = method; }
+
+    /// @brief Get current pass method
+    BlurMethod getMethod() const { return method; }
+
     virtual const Texture2D& apply(const Texture2D& input, const PostProcessContext& ctx = {}) override;
 
+    /// @brief Give the output of the last `apply` back to the pool, once it has been consumed
+    void releaseOutput() { output.release(); }
+
     /// @brief Number of blur iterations. More iterations create a smoother, heavier blur but cost more performance
+    /// @note At least one iteration is always applied, so the output is a vertical pass result
     uint32_t blurIterations = 5;
 
 protected:
-    // Parameters
-    float offsetScale = 1.0f;
+    /// @brief Number of passes of one `apply`: a horizontal and a vertical one per iteration, at least one each
+    uint32_t passCount() const { return std::max(blurIterations, 1u) * 2; }
 
-    // Ping-pong framebuffers
-    Framebuffer blurFramebuffers[2];
+    /// @brief Build the kernel from `radius` and `sigma` scaled by `offsetScale`, and upload it to both programs
+    void updateKernel();
 
-    // Blur shader
-    ShaderProgram blurShader;
+    /// @brief Horizontal then vertical fragment passes, `blurIterations` times
+    void applyFragment(const Texture2D& input, RenderTargetPool::Handle (&targets)[2]);
+
+    /// @brief Horizontal then vertical compute passes, `blurIterations` times
+    void applyCompute(const Texture2D& input, RenderTargetPool::Handle (&targets)[2]);
 
-    // Ping-pong textures
-    Texture2D blurTextures[2];
+    // Parameters
+    float offsetScale = 1.0f;
+    uint32_t width;
+    uint32_t height;
+    BlurMethod method;
+    uint32_t radius = 0;
+    float sigma = 0.0f;
+
+    // Ping-pong targets come from here; declared before the handles so it outlives them
+    std::shared_ptr<RenderTargetPool> pool;
+    RenderTargetPool::Handle output;
+
+    // Blur shader; the screen quad vertex stage is shared with every other effect
+    std::shared_ptr<ShaderProgram> screenQuadStage;
+    ShaderProgram blurShader;
+    ProgramPipeline blurPipeline;
+    ComputeProgram blurCompute;
 
     // Data for the screen quad for intermediate renders
     struct quadVert {
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "tmig/render/postprocessing/effect.hpp"
+#include "tmig/render/postprocessing/pointwise.hpp"
+#include "tmig/render/render_target_pool.hpp"
+#include "tmig/render/shader.hpp"
+#include "tmig/render/program_pipeline.hpp"
+#include "tmig/render/mesh.hpp"
+
+namespace tmig::render::postprocessing {
+
+/// @brief Configuration for the PostProcessChain
+struct PostProcessChainConfig {
+    /// @brief Pool the targets of fused passes come from; `getSharedRenderTargetPool` if null
+    std::shared_ptr<RenderTargetPool> pool = nullptr;
+};
+
+/// @brief Applies effects one after the other, fusing runs of point-wise effects into single passes
+///
+/// Effects are applied in the order they were added. Consecutive `PointwiseEffect`s are merged into one
+/// generated shader, rendered into a target the size and format of its input; any other effect is
+/// applied on its own, through its `apply`. Intermediate targets thus only exist around effects that
+/// need neighbouring texels.
+///
+/// Generated shaders are cached by source, so rebuilding the chain with `clear` / `add` every frame
+/// (e.g. to toggle effects) only compiles each combination once.
+/// @note - Effects are not owned and must outlive their use by the chain
+/// @note - The result of the last fused pass stays held until the next `apply`
+class PostProcessChain : public Effect {
+public:
+    /// @brief Constructor with configuration
+    PostProcessChain(const PostProcessChainConfig& config = {});
+
+    /// @brief Destructor
+    ~PostProcessChain();
+
+    /// @brief Append an effect
+    void add(Effect& effect);
+
+    /// @brief Remove every effect
+    void clear();
+
+    /// @brief Number of effects in the chain
+    size_t size() const { return effects.size(); }
+
+    /// @brief Number of full-screen passes (fused or not) the chain takes; the input is returned as is
+    /// when there are none
+    size_t passCount() const;
+
+    virtual const Texture2D& apply(const Texture2D& input, const PostProcessContext& ctx = {}) override;
+
+protected:
+    /// @brief Program fusing a run of point-wise effects
+    struct FusedPass {
+        ShaderProgram shader;
+        ProgramPipeline pipeline;
+    };
+
+    /// @brief Get (compiling it on first use) the program fusing `run`
+    FusedPass& fusedPass(const std::vector<PointwiseEffect*>& run);
+
+    std::vector<Effect*> effects;
+
+    // Fused pass targets come from here; declared before the handle so it outlives it
+    std::shared_ptr<RenderTargetPool> pool;
+    RenderTargetPool::Handle output;
+
+    // Generated programs by fragment shader source; the screen quad vertex stage is shared with every
+    // other effect
+    std::shared_ptr<ShaderProgram> screenQuadStage;
+    std::unordered_map<std::string, std::unique_ptr<FusedPass>> fusedPasses;
+
+    // Data for the screen quad
+    struct quadVert {
+        glm::vec3 pos;
+        glm::vec2 uv;
+    };
+
+    DataBuffer<quadVert>* _vertBuffer;
+    DataBuffer<uint32_t>* _indexBuffer;
+    Mesh<quadVert> _screenQuad;
+};
+
+} // namespace tmig::render::postprocessing
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "tmig/render/postprocessing/effect.hpp"
+#include "tmig/render/shader.hpp"
+
+namespace tmig::render::postprocessing {
+
+class PostProcessChain;
+
+/// @brief Effect computing each output pixel from the input pixel at the same position only
+///
+/// Such effects don't need their input in a texture: `PostProcessChain` concatenates consecutive
+/// point-wise effects into one generated shader, so a whole run of them costs a single full-screen
+/// pass instead of one read and one write of the image per effect.
+///
+/// Subclasses provide a GLSL snippet defining `vec4 EFFECT(vec4 color, vec2 uv)`, where `color` is the
+/// result of the previous effect at texture coordinate `uv`. Every `EFFECT` token is renamed when
+/// generating the shader, so uniforms named `EFFECT_something` don't clash between effects.
+class PointwiseEffect : public Effect {
+public:
+    /// @brief Constructor
+    PointwiseEffect();
+
+    /// @brief Destructor
+    ~PointwiseEffect();
+
+    /// @brief GLSL snippet of the effect; see the class description
+    /// @note Must not change over the lifetime of the effect
+    virtual std::string source() const = 0;
+
+    /// @brief Set the uniforms of the snippet on `program`; `prefix` is what `EFFECT` was renamed to
+    virtual void setUniforms(ShaderProgram& program, const std::string& prefix) const = 0;
+
+    /// @brief Applies the effect alone, in one pass
+    virtual const Texture2D& apply(const Texture2D& input, const PostProcessContext& ctx = {}) override;
+
+private:
+    /// @brief Chain of just this effect, created on first standalone `apply`
+    std::unique_ptr<PostProcessChain> _standalone;
+};
+
+/// @brief Inverts colors
+class InvertEffect : public PointwiseEffect {
+public:
+    /// @brief Set how much of the inverted color is used, from 0 (none) to 1
+    /// @note By default it is 1.0f
+    void setStrength(float strength) { this->strength = strength; }
+
+    /// @brief Get current strength
+    float getStrength() const { return strength; }
+
+    virtual std::string source() const override;
+    virtual void setUniforms(ShaderProgram& program, const std::string& prefix) const override;
+
+protected:
+    float strength = 1.0f;
+};
+
+/// @brief Desaturates colors, using Rec. 709 luminance
+class GrayscaleEffect : public PointwiseEffect {
+public:
+    /// @brief Set how much of the gray color is used, from 0 (none) to 1
+    /// @note By default it is 1.0f
+    void setStrength(float strength) { this->strength = strength; }
+
+    /// @brief Get current strength
+    float getStrength() const { return strength; }
+
+    virtual std::string source() const override;
+    virtual void setUniforms(ShaderProgram& program, const std::string& prefix) const override;
+
+protected:
+    float strength = 1.0f;
+};
+
+/// @brief Darkens the image towards its borders
+class VignetteEffect : public PointwiseEffect {
+public:
+    /// @brief Set how dark the borders get, from 0 (no vignette) to 1
+    /// @note By default it is 1.0f
+    void setStrength(float strength) { this->strength = strength; }
+
+    /// @brief Get current strength
+    float getStrength() const { return strength; }
+
+    /// @brief Set the distance from the center where darkening starts and where it is complete
+    /// @note By default they are 0.25f and 0.85f
+    void setRadius(float inner, float outer) { innerRadius = inner; outerRadius = outer; }
+
+    virtual std::string source() const override;
+    virtual void setUniforms(ShaderProgram& program, const std::string& prefix) const override;
+
+protected:
+    float strength = 1.0f;
+    float innerRadius = 0.25f;
+    float outerRadius = 0.85f;
+};
+
+} // namespace tmig::render::postprocessing
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <memory>
+
+#include "tmig/render/postprocessing/effect.hpp"
+#include "tmig/render/render_target_pool.hpp"
+#include "tmig/render/shader.hpp"
+#include "tmig/render/program_pipeline.hpp"
+#include "tmig/render/texture2D.hpp"
+#include "tmig/render/mesh.hpp"
+
+namespace tmig::render::postprocessing {
+
+/// @brief How `ReducedResolutionEffect` brings the result of the wrapped effect back to full resolution
+enum class UpsampleFilter {
+    /// @brief Plain bilinear filtering; the result bleeds across depth edges
+    BILINEAR,
+
+    /// @brief Bilinear weights, scaled down for low resolution samples whose depth or normal differ from
+    /// the full resolution pixel
+    BILATERAL,
+
+    /// @brief Of the 4 nearest low resolution samples, take the one closest in depth
+    NEAREST_DEPTH,
+};
+
+/// @brief Configuration for the ReducedResolutionEffect
+struct ReducedResolutionConfig {
+    /// @brief The wrapped effect runs at the input size divided by this, e.g. 2 for half and 4 for
+    /// quarter resolution
+    uint32_t divisor = 2;
+
+    /// @brief Filter used to upsample the result
+    UpsampleFilter upsample = UpsampleFilter::BILATERAL;
+
+    /// @brief Pool the reduced and output targets come from; `getSharedRenderTargetPool` if null
+    std::shared_ptr<RenderTargetPool> pool = nullptr;
+};
+
+/// @brief Runs another effect at a reduced resolution, then upsamples its result to the input size
+///
+/// The input is box-filtered down by `divisor`. When the context has a `gPosition`, it (and `gNormal`, if
+/// present) is downsampled too, keeping in each block the texel closest to the camera, and the wrapped
+/// effect receives these reduced G-buffer textures in its context. The full resolution G-buffer then
+/// guides the upsample (see `UpsampleFilter`), so low-frequency effects such as ambient occlusion or
+/// volumetrics keep sharp edges at a quarter (or sixteenth) of the cost.
+/// @note - The wrapped effect is not owned and must outlive this one
+/// @note - The wrapped effect should render at the size of its input
+/// @note - `gPosition` and `gNormal` must be the size of the input; normals are expected in [-1, 1]
+/// @note - Depth is the distance to `PostProcessContext::camera`, or to the origin without a camera
+/// @note - Without `gPosition`, the upsample is always bilinear
+class ReducedResolutionEffect : public Effect {
+public:
+    /// @brief Constructor wrapping `effect`
+    ReducedResolutionEffect(Effect& effect, const ReducedResolutionConfig& config = {});
+
+    /// @brief Destructor
+    ~ReducedResolutionEffect();
+
+    /// @brief Set the resolution divisor, at least 1
+    void setDivisor(uint32_t divisor);
+
+    /// @brief Get current resolution divisor
+    uint32_t getDivisor() const { return config.divisor; }
+
+    /// @brief Set the upsample filter
+    void setUpsampleFilter(UpsampleFilter filter) { config.upsample = filter; }
+
+    /// @brief Get current upsample filter
+    UpsampleFilter getUpsampleFilter() const { return config.upsample; }
+
+    /// @brief Set the depth difference, relative to the pixel depth, at which bilateral weights fall to 1/e
+    /// @note By default it is 0.05f
+    void setDepthSigma(float sigma);
+
+    /// @brief Get current depth sigma
+    float getDepthSigma() const { return depthSigma; }
+
+    /// @brief Set the exponent applied to normal similarity in bilateral weights; 0 ignores normals
+    /// @note By default it is 8.0f
+    void setNormalPower(float power);
+
+    /// @brief Get current normal exponent
+    float getNormalPower() const { return normalPower; }
+
+    virtual const Texture2D& apply(const Texture2D& input, const PostProcessContext& ctx = {}) override;
+
+protected:
+    /// @brief Downsample `image` into a target of the reduced size; with `guide`, keep the texel of each
+    /// block closest to the camera instead of averaging
+    RenderTargetPool::Handle downsample(
+        const Texture2D& image,
+        const Texture2D* guide,
+        uint32_t width, uint32_t height,
+        const glm::vec3& eye
+    );
+
+    Effect* effect;
+
+    // Parameters
+    float depthSigma = 0.05f;
+    float normalPower = 8.0f;
+    ReducedResolutionConfig config;
+
+    // Targets come from here; declared before the handle so it outlives it
+    std::shared_ptr<RenderTargetPool> pool;
+    RenderTargetPool::Handle output;
+
+    // Shaders; the screen quad vertex stage is shared with every other effect
+    std::shared_ptr<ShaderProgram> screenQuadStage;
+    ShaderProgram downsampleShader;
+    ProgramPipeline downsamplePipeline;
+    ShaderProgram upsampleShader;
+    ProgramPipeline upsamplePipeline;
+
+    // Data for the screen quad
+    struct quadVert {
+        glm::vec3 pos;
+        glm::vec2 uv;
+    };
+
+    DataBuffer<quadVert>* _vertBuffer;
+    DataBuffer<uint32_t>* _indexBuffer;
+    Mesh<quadVert> _screenQuad;
+};
+
+} // namespace tmig::render::postprocessing
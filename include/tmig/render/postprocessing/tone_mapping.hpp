@@ -0,0 +1,142 @@
+#pragma once
+
+#include <memory>
+
+#include "tmig/render/postprocessing/effect.hpp"
+#include "tmig/render/render_target_pool.hpp"
+#include "tmig/render/shader.hpp"
+#include "tmig/render/program_pipeline.hpp"
+#include "tmig/render/compute_program.hpp"
+#include "tmig/render/storage_buffer.hpp"
+#include "tmig/render/texture2D.hpp"
+#include "tmig/render/mesh.hpp"
+
+namespace tmig::render::postprocessing {
+
+/// @brief Curve mapping exposed HDR colors to [0, 1]
+enum class ToneMapOperator {
+    /// @brief `c / (1 + c)` per channel
+    REINHARD,
+
+    /// @brief Fitted ACES filmic curve (Narkowicz), with more contrast and a soft shoulder
+    ACES,
+};
+
+/// @brief Configuration for the ToneMappingEffect
+struct ToneMappingConfig {
+    /// @brief Tone mapping curve
+    ToneMapOperator tonemapOperator = ToneMapOperator::ACES;
+
+    /// @brief Output format
+    TextureFormat format = TextureFormat::RGBA8;
+
+    /// @brief Pool the output target comes from; `getSharedRenderTargetPool` if null
+    std::shared_ptr<RenderTargetPool> pool = nullptr;
+};
+
+/// @brief Exposes an HDR image, automatically or manually, and tone maps it to [0, 1]
+///
+/// Auto-exposure runs entirely on the GPU, without reading anything back:
+/// 1. A compute pass builds a histogram of the log2 luminance of the input, each work group counting
+///    into shared memory before adding its counts to a storage buffer
+/// 2. A single work group averages the histogram (ignoring black pixels), adapts the previous average
+///    towards it over time and stores the result in a one-element storage buffer, clearing the histogram
+///    for the next frame
+/// 3. The tone mapping pass reads the adapted luminance from that buffer and exposes it to middle gray
+///
+/// @note - Feed it a float image (e.g. a `BloomEffect` with an `RGBA16F` `outputFormat`); 8-bit inputs
+/// are already clamped to [0, 1], so neither the exposure nor the curve's shoulder see any HDR
+/// @note - Call `setDeltaTime` every frame for the adaptation to follow real time
+/// @note - No gamma is applied; the output stays in the color space of the input
+class ToneMappingEffect : public Effect {
+public:
+    /// @brief Number of histogram bins; bin 0 holds pixels darker than the luminance range
+    static constexpr uint32_t HISTOGRAM_BINS = 256;
+
+    /// @brief Constructor with configuration
+    ToneMappingEffect(const ToneMappingConfig& config = {});
+
+    /// @brief Destructor
+    ~ToneMappingEffect();
+
+    /// @brief Set the tone mapping curve
+    void setOperator(ToneMapOperator tonemapOperator);
+
+    /// @brief Get current tone mapping curve
+    ToneMapOperator getOperator() const { return config.tonemapOperator; }
+
+    /// @brief Enable or disable auto-exposure; without it, the exposure is `2^compensation`
+    /// @note By default it is enabled
+    void setAutoExposure(bool enabled);
+
+    /// @brief Whether auto-exposure is enabled
+    bool isAutoExposure() const { return autoExposure; }
+
+    /// @brief Set the exposure compensation, in stops (EV)
+    /// @note By default it is 0.0f
+    void setExposureCompensation(float ev);
+
+    /// @brief Get current exposure compensation
+    float getExposureCompensation() const { return exposureCompensation; }
+
+    /// @brief Set the log2 luminance range covered by the histogram; luminance outside of it is clamped
+    /// @note By default it is [-10, 6]
+    void setLuminanceRange(float minLog2, float maxLog2);
+
+    /// @brief Set how fast the exposure follows luminance changes, in 1/seconds; higher is faster
+    /// @note By default it is 1.5f
+    void setAdaptationRate(float rate);
+
+    /// @brief Get current adaptation rate
+    float getAdaptationRate() const { return adaptationRate; }
+
+    /// @brief Set the time elapsed since the previous `apply`, in seconds
+    void setDeltaTime(float dt) { deltaTime = dt; }
+
+    /// @brief Make the next `apply` use the measured luminance as is, skipping adaptation (e.g. after a
+    /// camera cut)
+    void resetAdaptation() { resetPending = true; }
+
+    virtual const Texture2D& apply(const Texture2D& input, const PostProcessContext& ctx = {}) override;
+
+protected:
+    /// @brief Build the luminance histogram of `input` and update the adapted luminance
+    void measureLuminance(const Texture2D& input);
+
+    // Parameters
+    bool autoExposure = true;
+    float exposureCompensation = 0.0f;
+    float minLogLuminance = -10.0f;
+    float maxLogLuminance = 6.0f;
+    float adaptationRate = 1.5f;
+    float deltaTime = 1.0f / 60.0f;
+    bool resetPending = true;
+    ToneMappingConfig config;
+
+    // Histogram counts, and the adapted average luminance; both only ever touched by shaders
+    StorageBuffer<uint32_t> histogram;
+    StorageBuffer<float> adaptedLuminance;
+
+    // The output target comes from here; declared before the handle so it outlives it
+    std::shared_ptr<RenderTargetPool> pool;
+    RenderTargetPool::Handle output;
+
+    // Shaders; the screen quad vertex stage is shared with every other effect
+    ComputeProgram histogramProgram;
+    ComputeProgram averageProgram;
+    std::shared_ptr<ShaderProgram> screenQuadStage;
+    ShaderProgram toneMapShader;
+    ProgramPipeline toneMapPipeline;
+
+    // Data for the screen quad
+    struct quadVert {
+        glm::vec3 pos;
+        glm::vec2 uv;
+    };
+
+    DataBuffer<quadVert>* _vertBuffer;
+    DataBuffer<uint32_t>* _indexBuffer;
+    Mesh<quadVert> _screenQuad;
+};
+
+} // namespace tmig::render::postprocessing
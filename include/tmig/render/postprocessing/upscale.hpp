@@ -0,0 +1,91 @@
+#pragma once
+
+#include <memory>
+
+#include "tmig/render/postprocessing/effect.hpp"
+#include "tmig/render/render_target_pool.hpp"
+#include "tmig/render/shader.hpp"
+#include "tmig/render/program_pipeline.hpp"
+#include "tmig/render/texture2D.hpp"
+#include "tmig/render/mesh.hpp"
+
+namespace tmig::render::postprocessing {
+
+/// @brief Configuration for the UpscaleEffect
+struct UpscaleConfig {
+    /// @brief Output width, usually the window width
+    uint32_t width = 1920;
+
+    /// @brief Output height, usually the window height
+    uint32_t height = 1080;
+
+    /// @brief Output format
+    TextureFormat format = TextureFormat::RGBA8;
+
+    /// @brief Pool the output target comes from; `getSharedRenderTargetPool` if null
+    std::shared_ptr<RenderTargetPool> pool = nullptr;
+};
+
+/// @brief Upscales part of a texture to the output size, sharpening it to win back detail
+///
+/// Meant as the last scene pass of dynamic resolution (see `DynamicResolution`): the input is sampled
+/// bilinearly inside `sourceRegion` only, then a contrast adaptive sharpening filter adds back some of
+/// the detail lost to the lower resolution. Sharpening is weaker where local contrast is already high, so
+/// edges don't ring.
+/// @note - Sharpening assumes colors in [0, 1] and fades out above 1; apply it after tone mapping for full effect
+/// @note - The result is clamped to [0, 1] only for normalized output formats; float outputs keep HDR values
+class UpscaleEffect : public Effect {
+public:
+    /// @brief Constructor with configuration
+    UpscaleEffect(const UpscaleConfig& config = {});
+
+    /// @brief Destructor
+    ~UpscaleEffect();
+
+    /// @brief Set the output size
+    void setOutputSize(uint32_t width, uint32_t height);
+
+    /// @brief Set the part of the input holding the picture, in texture coordinates from the bottom-left
+    /// corner, e.g. `DynamicResolution::uvScale`
+    /// @note By default it is the whole texture
+    void setSourceRegion(const glm::vec2& region);
+
+    /// @brief Get the part of the input holding the picture
+    const glm::vec2& getSourceRegion() const { return sourceRegion; }
+
+    /// @brief Set the sharpening strength, from 0 (plain bilinear) to 1
+    /// @note By default it is 0.5f
+    void setSharpness(float sharpness);
+
+    /// @brief Get current sharpening strength
+    float getSharpness() const { return sharpness; }
+
+    virtual const Texture2D& apply(const Texture2D& input, const PostProcessContext& ctx = {}) override;
+
+protected:
+    // Parameters
+    float sharpness = 0.5f;
+    glm::vec2 sourceRegion{1.0f};
+    UpscaleConfig config;
+
+    // The output target comes from here; declared before the handle so it outlives it
+    std::shared_ptr<RenderTargetPool> pool;
+    RenderTargetPool::Handle output;
+
+    // Shaders; the screen quad vertex stage is shared with every other effect
+    std::shared_ptr<ShaderProgram> screenQuadStage;
+    ShaderProgram upscaleShader;
+    ProgramPipeline upscalePipeline;
+
+    // Data for the screen quad
+    struct quadVert {
+        glm::vec3 pos;
+        glm::vec2 uv;
+    };
+
+    DataBuffer<quadVert>* _vertBuffer;
+    DataBuffer<uint32_t>* _indexBuffer;
+    Mesh<quadVert> _screenQuad;
+};
+
+} // namespace tmig::render::postprocessing
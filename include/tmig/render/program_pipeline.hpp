@@ -0,0 +1,57 @@
+#pragma once
+
+#include <string>
+#include <memory>
+#include <cstdint>
+
+#include "tmig/render/shader.hpp"
+#include "tmig/core/non_copyable.hpp"
+
+namespace tmig::render {
+
+/// @brief OpenGL program pipeline wrapper class
+///
+/// A program pipeline mixes separable stage programs (see `ShaderProgram::compileStageFromFile`) at bind
+/// time, so a stage shared by many pipelines is compiled and linked only once.
+/// Uniforms are still set on the stage programs themselves.
+/// @note - The pipeline does not own the stage programs; they must outlive it
+/// @note - This is a non-copyable class, meaning you cannot create a copy of it
+class ProgramPipeline : protected core::NonCopyable {
+public:
+    /// @brief Constructor
+    ProgramPipeline();
+
+    /// @brief Destructor
+    ~ProgramPipeline();
+
+    /// @brief Move constructor
+    ProgramPipeline(ProgramPipeline&& other) noexcept;
+
+    /// @brief Move assignment
+    ProgramPipeline& operator=(ProgramPipeline&& other) noexcept;
+
+    /// @brief Use `program` for its stage in this pipeline, replacing the previous program of that stage
+    /// @note Will throw an `std::runtime_error` if `program` is not a linked separable program
+    void setStage(const ShaderProgram& program);
+
+    /// @brief Bind this pipeline for rendering
+    /// @note Any program bound with `ShaderProgram::use` takes precedence over pipelines, so this unbinds it
+    void use() const;
+
+    /// @brief Returns pipeline id
+    uint32_t id() const { return _id; }
+
+private:
+    /// @brief OpenGL identifier
+    uint32_t _id = 0;
+};
+
+/// @brief Returns a separable program for `stage` compiled from the resource at `path`
+///
+/// Programs are cached by stage and path while at least one returned pointer is alive, so every caller
+/// asking for the same resource shares one compiled program.
+/// @param path Resource path relative to resources/, loaded with `ShaderProgram::compileStagePrecompiled`
+/// @return The shared program, or `nullptr` if compilation failed
+std::shared_ptr<ShaderProgram> getSharedStage(ShaderStage stage, const std::string& path);
+
+} // namespace tmig::render
@@ -0,0 +1,243 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <unordered_map>
+#include <optional>
+#include <cstdint>
+#include <cstddef>
+
+#include "tmig/core/non_copyable.hpp"
+#include "tmig/render/texture2D.hpp"
+#include "tmig/render/renderbuffer.hpp"
+#include "tmig/render/framebuffer.hpp"
+
+namespace tmig::render {
+
+/// @brief Describes a transient texture of a `RenderGraph`
+struct RenderGraphTextureDesc {
+    uint32_t width = 0;
+    uint32_t height = 0;
+
+    /// @brief Internal format; depth formats can only be written with `writeDepth`
+    TextureFormat format = TextureFormat::RGBA8;
+
+    /// @brief Samples per pixel, see `FramebufferConfig::samples`
+    uint32_t samples = 1;
+
+    bool operator==(const RenderGraphTextureDesc& other) const {
+        return width == other.width && height == other.height && format == other.format && samples == other.samples;
+    }
+};
+
+/// @brief Handle to a texture of a `RenderGraph`, valid until the next `reset`
+struct RenderGraphTexture {
+    uint32_t index = ~0u;
+
+    /// @brief Whether the handle refers to a texture
+    bool valid() const { return index != ~0u; }
+};
+
+/// @brief Frame graph: passes declare the textures they read and write, and the graph works out the rest
+///
+/// Each frame, `reset` the graph, add passes, then `execute`. Compiling the graph:
+///
+/// 1. Orders passes so every pass runs after the passes writing what it reads. A pass reading a texture
+///    sees it once every pass writing it (added in any order) has run; several writers of the same texture
+///    run in the order they were added
+///
+/// 2. Culls passes whose results are never used: only passes contributing to an imported texture or
+///    marked with `sideEffect` (e.g. drawing to the screen) survive
+///
+/// 3. Computes the lifetime of every transient texture, from the first to the last surviving pass using
+///    it, and lets textures with identical descriptions and disjoint lifetimes share the same storage.
+///    Textures no surviving pass reads (e.g. a depth buffer only used for depth testing) are backed by
+///    renderbuffers
+///
+/// 4. Builds one framebuffer per pass from the textures it writes, invalidating attachments whose previous
+///    content isn't needed (first write) or won't be needed (last use), so the driver can skip loads and
+///    stores
+///
+/// Transient textures, their storage and the framebuffers are kept across frames, so a graph rebuilt
+/// identically every frame allocates nothing after the first one.
+/// @note - The content of a transient texture is undefined when first written; passes clear their
+/// framebuffer on bind by default
+/// @note - This is a non-copyable class, meaning you cannot create a copy of it
+class RenderGraph : protected core::NonCopyable {
+public:
+    /// @brief Declares the resources of a pass; only valid inside the setup function of `addPass`
+    class PassBuilder {
+    public:
+        /// @brief Create a transient texture, owned by the graph
+        RenderGraphTexture create(const std::string& name, const RenderGraphTextureDesc& desc);
+
+        /// @brief Declare that the pass samples `texture`
+        RenderGraphTexture read(RenderGraphTexture texture);
+
+        /// @brief Declare that the pass renders into `texture`, as color attachment `index`
+        RenderGraphTexture write(RenderGraphTexture texture, uint32_t index = 0);
+
+        /// @brief Declare that the pass renders into depth (or depth-stencil) `texture`
+        RenderGraphTexture writeDepth(RenderGraphTexture texture);
+
+        /// @brief Keep the pass even if nothing uses its outputs, e.g. when it draws to the screen
+        void sideEffect();
+
+        /// @brief How the pass framebuffer is bound before the pass runs
+        void setBindOptions(const FramebufferBindOptions& options);
+
+    private:
+        friend class RenderGraph;
+
+        PassBuilder(RenderGraph& graph, uint32_t pass) : _graph{graph}, _pass{pass} {}
+
+        RenderGraph& _graph;
+        uint32_t _pass;
+    };
+
+    /// @brief What a pass can access while running
+    class PassContext {
+    public:
+        /// @brief Texture behind a handle declared by the pass
+        const Texture2D& texture(RenderGraphTexture texture) const;
+
+        /// @brief Framebuffer of the pass, already bound; `nullptr` if the pass writes no texture
+        Framebuffer* framebuffer() const { return _framebuffer; }
+
+    private:
+        friend class RenderGraph;
+
+        PassContext(const RenderGraph& graph, Framebuffer* framebuffer) : _graph{graph}, _framebuffer{framebuffer} {}
+
+        const RenderGraph& _graph;
+        Framebuffer* _framebuffer;
+    };
+
+    using SetupFunction = std::function<void(PassBuilder&)>;
+    using ExecuteFunction = std::function<void(const PassContext&)>;
+
+    /// @brief Constructor
+    RenderGraph() = default;
+
+    /// @brief Forget every pass and texture handle, to build the next frame; storage and framebuffers are
+    /// kept for reuse
+    void reset();
+
+    /// @brief Make an external texture usable by passes. Imported textures are never aliased nor
+    /// invalidated, and passes writing them are never culled
+    /// @note The texture must already have storage; it is attached as it is
+    RenderGraphTexture importTexture(const std::string& name, Texture2D& texture);
+
+    /// @brief Add a pass: `setup` runs immediately to declare its resources, `execute` runs during `execute`
+    void addPass(const std::string& name, const SetupFunction& setup, ExecuteFunction execute);
+
+    /// @brief Order and cull passes, assign storage to transient textures and build framebuffers
+    /// @note Called by `execute` if needed
+    /// @throws std::runtime_error if passes depend on each other in a cycle
+    void compile();
+
+    /// @brief Run the surviving passes in order; compiles first if needed
+    void execute();
+
+    /// @brief Texture behind a handle, once compiled
+    /// @note - Transient textures past their last use may have been invalidated or reused by another texture
+    /// @note - Transient textures never read by a pass are renderbuffers and have no texture
+    const Texture2D& texture(RenderGraphTexture texture) const;
+
+    /// @brief Number of passes added since `reset`
+    size_t passCount() const { return _passes.size(); }
+
+    /// @brief Number of passes removed by the last `compile`
+    size_t culledPassCount() const { return _passes.size() - _order.size(); }
+
+    /// @brief Names of the surviving passes in execution order
+    std::vector<std::string> executionOrder() const;
+
+    /// @brief Number of transient textures used by the surviving passes
+    size_t transientTextureCount() const { return _usedTransientCount; }
+
+    /// @brief Number of allocated textures and renderbuffers backing the transient textures
+    size_t physicalTextureCount() const { return _physical.size(); }
+
+    /// @brief Estimated GPU memory used by the transient textures, in bytes
+    size_t memorySize() const;
+
+private:
+    struct Resource {
+        std::string name;
+        RenderGraphTextureDesc desc;
+
+        /// @brief Imported texture; `nullptr` for transient textures
+        Texture2D* imported = nullptr;
+
+        /// @brief Index in `_physical`, for used transient textures
+        uint32_t physical = ~0u;
+
+        /// @brief Position in `_order` of the first and last surviving pass using the texture
+        uint32_t firstUse = ~0u;
+        uint32_t lastUse = 0;
+
+        /// @brief Whether a surviving pass reads the texture; if not, it is backed by a renderbuffer
+        bool sampled = false;
+    };
+
+    struct Pass {
+        std::string name;
+        ExecuteFunction execute;
+        std::vector<uint32_t> reads;
+
+        /// @brief Written textures and their color attachment index
+        std::vector<std::pair<uint32_t, uint32_t>> writes;
+        std::optional<uint32_t> depthWrite;
+
+        bool sideEffect = false;
+        FramebufferBindOptions bindOptions;
+
+        /// @brief Framebuffer built by `compile`; owned by `_framebuffers`
+        Framebuffer* framebuffer = nullptr;
+    };
+
+    /// @brief Storage shared by transient textures; either a texture or a renderbuffer
+    struct PhysicalTexture {
+        RenderGraphTextureDesc desc;
+        std::unique_ptr<Texture2D> texture;
+        std::unique_ptr<Renderbuffer> renderbuffer;
+    };
+
+    /// @brief Whether pass `pass` writes `resource`
+    bool writes(const Pass& pass, uint32_t resource) const;
+
+    /// @brief Texture backing a resource, once compiled
+    Texture2D& resourceTexture(uint32_t resource) const;
+
+    /// @brief Renderbuffer backing a resource, once compiled; `nullptr` if it is backed by a texture
+    Renderbuffer* resourceRenderbuffer(uint32_t resource) const;
+
+    /// @brief Create a framebuffer attaching the textures written by a pass
+    std::unique_ptr<Framebuffer> framebufferFor(const Pass& pass) const;
+
+    /// @brief Invalidate the attachments of `pass` whose transient texture starts (or ends) its lifetime at
+    /// `position`
+    void invalidateAttachments(const Pass& pass, uint32_t position, bool first) const;
+
+    std::vector<Resource> _resources;
+    std::vector<Pass> _passes;
+
+    /// @brief Surviving passes in execution order
+    std::vector<uint32_t> _order;
+
+    /// @brief Whether passes or textures changed since the last `compile`
+    bool _dirty = true;
+
+    size_t _usedTransientCount = 0;
+
+    /// @brief Storage of transient textures, kept across frames
+    std::vector<PhysicalTexture> _physical;
+
+    /// @brief Framebuffers by attached texture ids, kept across frames
+    std::unordered_map<std::string, std::unique_ptr<Framebuffer>> _framebuffers;
+};
+
+} // namespace tmig::render
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "tmig/core/non_copyable.hpp"
+#include "tmig/render/texture2D.hpp"
+#include "tmig/render/framebuffer.hpp"
+
+namespace tmig::render {
+
+/// @brief Describes a pooled render target; targets are only shared between identical descriptions
+struct RenderTargetDesc {
+    uint32_t width = 0;
+    uint32_t height = 0;
+
+    /// @brief Format of the single color attachment
+    TextureFormat format = TextureFormat::RGBA8;
+
+    /// @brief Optional depth (or depth-stencil) attachment
+    std::optional<DepthAttachmentFormat> depthFormat = std::nullopt;
+
+    /// @brief Samples per pixel, see `FramebufferConfig::samples`
+    uint32_t samples = 1;
+
+    bool operator==(const RenderTargetDesc& other) const {
+        return width == other.width && height == other.height && format == other.format &&
+            depthFormat == other.depthFormat && samples == other.samples;
+    }
+};
+
+class RenderTargetPool;
+
+/// @brief A framebuffer with a color texture (and optionally a depth texture), owned by a `RenderTargetPool`
+struct RenderTarget {
+    RenderTargetDesc desc;
+    Texture2D texture;
+    Texture2D depthTexture;
+    Framebuffer framebuffer;
+
+    /// @brief Frame of the last `acquire`
+    uint64_t lastUsedFrame = 0;
+
+    /// @brief Whether a handle currently holds the target
+    bool inUse = false;
+};
+
+/// @brief Recycles temporary render targets between passes
+///
+/// Passes `acquire` a target for as long as they need it (usually one pass, or until their output has
+/// been consumed) and release it by dropping the handle; the next `acquire` with the same description
+/// gets the same target back. A chain of effects thus shares a handful of targets instead of each
+/// effect keeping its own full size textures.
+///
+/// Call `beginFrame` once per frame: targets left unused for `maxIdleFrames` frames are deleted, so
+/// targets of an old window size go away after a resize.
+/// @note - The content of an acquired target is undefined; clear it if the pass doesn't overwrite it all
+/// @note - The pool must outlive its handles
+/// @note - This is a non-copyable class, meaning you cannot create a copy of it
+class RenderTargetPool : protected core::NonCopyable {
+public:
+    /// @brief Releases its target back to the pool on destruction
+    /// @note - This is a non-copyable class, meaning you cannot create a copy of it
+    class Handle : protected core::NonCopyable {
+    public:
+        /// @brief Empty handle
+        Handle() = default;
+
+        /// @brief Destructor; releases the target
+        ~Handle() { release(); }
+
+        /// @brief Move constructor
+        Handle(Handle&& other) noexcept;
+
+        /// @brief Move assignment; releases the current target first
+        Handle& operator=(Handle&& other) noexcept;
+
+        /// @brief Give the target back to the pool early; the handle becomes empty
+        void release();
+
+        /// @brief Whether the handle holds a target
+        explicit operator bool() const { return _target != nullptr; }
+
+        /// @brief Color texture
+        Texture2D& texture() const { return _target->texture; }
+
+        /// @brief Depth texture; empty unless the description has a depth format
+        Texture2D& depthTexture() const { return _target->depthTexture; }
+
+        /// @brief Framebuffer rendering into `texture` (and `depthTexture`)
+        Framebuffer& framebuffer() const { return _target->framebuffer; }
+
+        /// @brief Description the target was acquired with
+        const RenderTargetDesc& desc() const { return _target->desc; }
+
+    private:
+        friend class RenderTargetPool;
+
+        explicit Handle(RenderTarget* target) : _target{target} {}
+
+        RenderTarget* _target = nullptr;
+    };
+
+    /// @brief Constructor
+    /// @param maxIdleFrames Frames a free target is kept before `beginFrame` deletes it
+    explicit RenderTargetPool(uint32_t maxIdleFrames = 2);
+
+    /// @brief Get a free target matching `desc`, creating one if there is none
+    /// @note Pooled textures are reset to clamped, linearly filtered sampling
+    Handle acquire(const RenderTargetDesc& desc);
+
+    /// @brief Advance the frame counter and delete targets idle for more than `maxIdleFrames` frames
+    void beginFrame();
+
+    /// @brief Delete every free target
+    void trim();
+
+    /// @brief Number of targets, free or in use
+    size_t targetCount() const { return _targets.size(); }
+
+    /// @brief Number of targets held by a handle
+    size_t inUseCount() const;
+
+    /// @brief Estimated GPU memory used by every target, in bytes
+    size_t memorySize() const;
+
+private:
+    /// @brief Owned targets; pointers stay stable as the vector grows
+    std::vector<std::unique_ptr<RenderTarget>> _targets;
+
+    /// @brief Frames a free target is kept
+    uint32_t _maxIdleFrames;
+
+    /// @brief Number of `beginFrame` calls
+    uint64_t _frame = 0;
+};
+
+/// @brief Pool shared by every engine effect; created on first use and deleted when no one holds it
+std::shared_ptr<RenderTargetPool> getSharedRenderTargetPool();
+
+} // namespace tmig::render
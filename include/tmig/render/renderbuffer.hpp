@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#include "tmig/core/non_copyable.hpp"
+#include "tmig/render/texture2D.hpp"
+
+namespace tmig::render {
+
+/// @brief OpenGL renderbuffer object: image storage that can only be rendered into, not sampled
+///
+/// Use it for framebuffer attachments nobody reads back, typically depth and stencil: the driver is free
+/// to pick a layout that is only good for rendering, and no texture or sampler state is attached to it.
+/// Copies out are still possible with `Framebuffer::resolveTo`.
+/// @note - This is a non-copyable class, meaning you cannot create a copy of it
+class Renderbuffer : protected core::NonCopyable {
+public:
+    /// @brief Constructor; the renderbuffer has no storage until `resize`
+    Renderbuffer();
+
+    /// @brief Destructor
+    ~Renderbuffer();
+
+    /// @brief Move constructor
+    Renderbuffer(Renderbuffer&& other) noexcept;
+
+    /// @brief Move assignment
+    Renderbuffer& operator=(Renderbuffer&& other) noexcept;
+
+    /// @brief (Re)allocate storage; previous content is lost
+    /// @param samples Samples per pixel; 1 for a single sample renderbuffer
+    /// @note Block compressed formats can't be rendered into
+    void resize(uint32_t width, uint32_t height, TextureFormat format, uint32_t samples = 1);
+
+    /// @brief Renderbuffer ID; used internally
+    uint32_t id() const { return _id; }
+
+    /// @brief Width in pixels
+    uint32_t width() const { return _width; }
+
+    /// @brief Height in pixels
+    uint32_t height() const { return _height; }
+
+    /// @brief Current internal format
+    TextureFormat format() const { return _format; }
+
+    /// @brief Samples per pixel
+    uint32_t samples() const { return _samples; }
+
+    /// @brief Estimated GPU memory used by the storage, in bytes
+    size_t memorySize() const;
+
+private:
+    /// @brief OpenGL identifier
+    uint32_t _id = 0;
+
+    /// @brief Width in pixels
+    uint32_t _width = 0;
+
+    /// @brief Height in pixels
+    uint32_t _height = 0;
+
+    /// @brief Samples per pixel
+    uint32_t _samples = 1;
+
+    /// @brief Current internal format
+    TextureFormat _format = TextureFormat::UNDEFINED;
+};
+
+} // namespace tmig::render
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include <glm/glm.hpp>
+
+#include "tmig/core/non_copyable.hpp"
+
+namespace tmig::render {
+
+/// @brief Represents the supported texture wrapping modes for textures when they are sampled outside
+/// their bounds.
+///
+/// Texture wrapping modes define how textures behave when texture coordinates are outside the range [0, 1].
+/// These modes determine how the texture is sampled at the edges and beyond.
+enum class TextureWrapMode {
+    /// @brief Repeat the texture infinitely in both directions
+    REPEAT,
+
+    /// @brief Mirror the texture on each repetition (odd repetitions are flipped)
+    MIRRORED_REPEAT,
+
+    /// @brief Clamp the texture coordinates to the edge of the texture
+    CLAMP_TO_EDGE,
+
+    /// @brief Clamp the texture coordinates to a specified border color
+    CLAMP_TO_BORDER,
+};
+
+/// @brief Represents the supported texture filtering modes for when the texture is minified.
+///
+/// Texture minification occurs when the texture is viewed at smaller sizes. The filter determines how
+/// the GPU samples the texture when its dimensions are reduced, such as when it is seen from a distance.
+enum class TextureMinFilter {
+    /// @brief Sample the nearest texel, no interpolation
+    NEAREST,
+
+    /// @brief Sample the texture with linear interpolation
+    LINEAR,
+
+    /// @brief Use the nearest mipmap level, and sample using the nearest texel
+    NEAREST_MIPMAP_NEAREST,
+
+    /// @brief Use the nearest mipmap level, and sample using linear interpolation
+    LINEAR_MIPMAP_NEAREST,
+
+    /// @brief Linearly interpolate between two mipmap levels, using the nearest texel
+    NEAREST_MIPMAP_LINEAR,
+
+    /// @brief Linearly interpolate between two mipmap levels, using linear interpolation for texels
+    LINEAR_MIPMAP_LINEAR,
+};
+
+/// @brief Represents the supported texture filtering modes for when the texture is magnified.
+///
+/// Texture magnification occurs when the texture is viewed at larger sizes. The filter determines how
+/// the GPU samples the texture when it needs to be upscaled.
+enum class TextureMagFilter {
+    /// @brief Sample the nearest texel, no interpolation
+    NEAREST,
+
+    /// @brief Sample the texture with linear interpolation
+    LINEAR,
+};
+
+/// @brief Complete state of a `Sampler`
+struct SamplerState {
+    TextureWrapMode wrapS = TextureWrapMode::REPEAT;
+    TextureWrapMode wrapT = TextureWrapMode::REPEAT;
+    TextureMinFilter minFilter = TextureMinFilter::LINEAR;
+    TextureMagFilter magFilter = TextureMagFilter::LINEAR;
+
+    /// @brief Border color for `CLAMP_TO_BORDER`
+    glm::vec4 borderColor{0.0f};
+
+    /// @brief Maximum anisotropy; values above 1 need `EXT_texture_filter_anisotropic`
+    float maxAnisotropy = 1.0f;
+
+    bool operator==(const SamplerState& other) const;
+
+    /// @brief Hash of every field, for deduplication
+    size_t hash() const;
+};
+
+/// @brief OpenGL sampler object: filtering and wrapping state, independent from any texture
+///
+/// A sampler bound to a texture unit overrides the sampling state of whatever texture is bound there,
+/// so one texture can be sampled several ways and many textures share one state object. Prefer
+/// `getSampler`, which shares samplers with identical state.
+/// @note - This is a non-copyable class, meaning you cannot create a copy of it
+class Sampler : protected core::NonCopyable {
+public:
+    /// @brief Constructor
+    explicit Sampler(const SamplerState& state = {});
+
+    /// @brief Destructor
+    ~Sampler();
+
+    /// @brief Move constructor
+    Sampler(Sampler&& other) noexcept;
+
+    /// @brief Move assignment
+    Sampler& operator=(Sampler&& other) noexcept;
+
+    /// @brief Bind to texture unit
+    void bind(uint32_t unit) const;
+
+    /// @brief Unbind from texture unit, so the texture's own state applies again
+    static void unbind(uint32_t unit);
+
+    /// @brief State of this sampler
+    const SamplerState& state() const { return _state; }
+
+    /// @brief Sampler ID; used internally
+    uint32_t id() const { return _id; }
+
+private:
+    /// @brief OpenGL identifier
+    uint32_t _id = 0;
+
+    /// @brief State the sampler was created with
+    SamplerState _state;
+};
+
+/// @brief Returns a sampler with the given state, shared with every other caller asking for the same state
+///
+/// Samplers are cached by state while at least one returned pointer is alive.
+std::shared_ptr<const Sampler> getSampler(const SamplerState& state);
+
+/// @brief Bind several samplers to consecutive texture units starting at `firstUnit` in one call
+/// @note `nullptr` entries unbind the sampler of their unit
+void bindSamplers(uint32_t firstUnit, const std::vector<const Sampler*>& samplers);
+
+} // namespace tmig::render
\ No newline at end of file
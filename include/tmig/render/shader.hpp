@@ -1,17 +1,55 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include <cstdint>
 #include <unordered_map>
 
 #include <glm/glm.hpp>
 
 #include "tmig/render/texture2D.hpp"
+#include "tmig/render/texture2D_array.hpp"
 #include "tmig/core/non_copyable.hpp"
 
 namespace tmig::render {
 
+/// @brief Programmable pipeline stages a separable shader program can be compiled for
+enum class ShaderStage {
+    /// @brief Vertex shader stage
+    VERTEX,
+
+    /// @brief Fragment shader stage
+    FRAGMENT,
+};
+
+/// @brief Value for a SPIR-V specialization constant, used by `ShaderProgram::compilePrecompiled`
+///
+/// On the GLSL fallback path the constant is passed as `#define TMIG_SPECIALIZATION_<id> <value>`, so a
+/// shader supporting both paths declares it as:
+///
+///     #ifdef GL_SPIRV
+///     layout(constant_id = 0) const int KERNEL_SIZE = 5;
+///     #elif defined(TMIG_SPECIALIZATION_0)
+///     const int KERNEL_SIZE = TMIG_SPECIALIZATION_0;
+///     #else
+///     const int KERNEL_SIZE = 5;
+///     #endif
+///
+/// @note Only `int` and `bool` constants are supported
+struct SpecializationConstant {
+    /// @brief `constant_id` of the constant in the shader
+    uint32_t id;
+
+    /// @brief Value to specialize the constant with
+    int32_t value;
+};
+
 /// @brief OpenGL shader program wrapper class
+///
+/// A program is either a regular one, with all stages linked together by `compileFromFiles`, or a
+/// separable single-stage program created by `compileStageFromFile`/`compileStageFromSource`. Stage
+/// programs are not used directly; they are combined at bind time through a `ProgramPipeline`, which
+/// lets the same stage (e.g. a screen quad vertex shader) be compiled once and shared by many pipelines
 /// @note - This is a non-copyable class, meaning you cannot create a copy of it.
 class ShaderProgram : protected core::NonCopyable {
 public:
@@ -32,10 +70,56 @@ public:
     /// @return Whether compilation and linking succeeded
     bool compileFromFiles(const std::string& vertexPath, const std::string& fragmentPath);
 
+    /// @brief Attempts to compile from the given vertex and fragment shader source code
+    /// @return Whether compilation and linking succeeded
+    bool compileFromSources(const std::string& vertexSource, const std::string& fragmentSource);
+
+    /// @brief Attempts to load the SPIR-V binaries precompiled at build time for the given vertex and
+    /// fragment shader resources, falling back to compiling their GLSL
+    ///
+    /// Binaries exist when the engine is built with `TMIG_COMPILE_SPIRV` (see `util::getSpirvPath`). The
+    /// GLSL is used instead when they don't, when the driver lacks `ARB_gl_spirv`, or when a uniform
+    /// outside of a block has neither an explicit `layout(location = N)` nor a `binding`: SPIR-V doesn't
+    /// keep uniform names, so the by-name setters resolve through the locations declared in the GLSL.
+    /// @param vertexPath, fragmentPath Paths relative to resources/, loaded through `util::readResource`
+    /// @param constants Specialization constants applied to both stages
+    /// @return Whether compilation and linking succeeded
+    /// @note Stage inputs and outputs must have explicit locations too, as SPIR-V matches them by location
+    bool compilePrecompiled(
+        const std::string& vertexPath,
+        const std::string& fragmentPath,
+        const std::vector<SpecializationConstant>& constants = {}
+    );
+
+    /// @brief Same as `compilePrecompiled`, for a separable program containing only `stage`
+    /// @param path Path relative to resources/, loaded through `util::readResource`
+    /// @note The result must be bound through a `ProgramPipeline` instead of `use`
+    bool compileStagePrecompiled(
+        ShaderStage stage,
+        const std::string& path,
+        const std::vector<SpecializationConstant>& constants = {}
+    );
+
+    /// @brief Attempts to compile a separable program containing only `stage` from the given file
+    /// @return Whether compilation and linking succeeded
+    /// @note The result must be bound through a `ProgramPipeline` instead of `use`
+    bool compileStageFromFile(ShaderStage stage, const std::string& path);
+
+    /// @brief Attempts to compile a separable program containing only `stage` from GLSL source code
+    /// @return Whether compilation and linking succeeded
+    /// @note The result must be bound through a `ProgramPipeline` instead of `use`
+    bool compileStageFromSource(ShaderStage stage, const std::string& source);
+
     /// @brief Use/activate shader
     /// @note Will throw an `std::runtime_error` if not valid. Check with `isValid()`
     void use() const;
 
+    /// @brief Whether this is a separable single-stage program
+    bool isSeparable() const { return _separable; }
+
+    /// @brief Stage compiled into this program; only meaningful if `isSeparable()`
+    ShaderStage stage() const { return _stage; }
+
     /// @brief Returns shader id
     uint32_t id() const { return _id; }
 
@@ -66,22 +150,76 @@ public:
     /// @brief Helper for setting a uniform texture in shader. Internally just calls `setInt` with `unit`
     void setTexture(const std::string& name, const Texture2D& texture, uint32_t unit);
 
-private:
+    /// @brief Helper for setting a uniform texture array (`sampler2DArray`) in shader
+    void setTexture(const std::string& name, const Texture2DArray& texture, uint32_t unit);
+
+protected:
     /// @brief OpenGL identifier
     uint32_t _id = 0;
 
     /// @brief Whether shader program is linked
     bool _linked = false;
 
-    /// @brief Uniform location cache
-    std::unordered_map<std::string, int> uniformLocationCache;
+    /// @brief Whether this program was linked as a separable single-stage program
+    bool _separable = false;
+
+    /// @brief Stage of a separable program
+    ShaderStage _stage = ShaderStage::VERTEX;
 
     /// @brief Get cached uniform location, or query and store if not cached yet
     int getUniformLocation(const std::string& name);
 
+    /// @brief Delete the current program object, if any, and reset its state
+    void release();
+
+    /// @brief Link compiled vertex and fragment shaders into a new program, deleting the shader objects
+    /// @return Whether linking succeeded; on failure the program is released
+    /// @note Expects any previous program to be released already
+    bool linkProgram(uint32_t vertexShader, uint32_t fragmentShader);
+
+    /// @brief Link a compiled shader into a new separable program for `stage`, deleting the shader object
+    /// @return Whether linking succeeded; on failure the program is released
+    /// @note Expects any previous program to be released already
+    bool linkStageProgram(ShaderStage stage, uint32_t shader);
+
     /// @brief Compile a specified shader stage
     /// @return Whether compilation succeeded
     bool compileShaderStage(uint32_t shader, const char* typeName);
+
+    /// @brief Create a shader of `type` from the SPIR-V binary precompiled for the resource `path`
+    /// @param source GLSL source of `path`, whose explicit uniform locations are added to `locations`
+    /// @return The specialized shader, or 0 if the GLSL source should be compiled instead
+    static uint32_t loadSpirvShader(
+        uint32_t type,
+        const std::string& path,
+        const std::string& source,
+        const std::vector<SpecializationConstant>& constants,
+        std::unordered_map<std::string, int>& locations,
+        const char* typeName
+    );
+
+    /// @brief Insert `#define TMIG_SPECIALIZATION_<id> <value>` lines right after the `#version` directive
+    static std::string injectSpecializationDefines(
+        const std::string& source,
+        const std::vector<SpecializationConstant>& constants
+    );
+
+    /// @brief Resolve uniform names through `locations` instead of querying them, for programs loaded
+    /// from SPIR-V
+    void setExplicitUniformLocations(std::unordered_map<std::string, int> locations);
+
+private:
+    /// @brief Location of `name` in `explicitUniformLocations`, or -1; array elements follow their array
+    int getExplicitUniformLocation(const std::string& name) const;
+
+    /// @brief Uniform location cache
+    std::unordered_map<std::string, int> uniformLocationCache;
+
+    /// @brief Whether uniform names resolve through `explicitUniformLocations`
+    bool _explicitLocations = false;
+
+    /// @brief Uniform locations declared in the GLSL of a program loaded from SPIR-V
+    std::unordered_map<std::string, int> explicitUniformLocations;
 };
 
 } // namespace tmig::render
\ No newline at end of file
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "tmig/core/non_copyable.hpp"
+
+namespace tmig::render {
+
+/// @brief Class representing a GPU shader storage buffer, holding a runtime-sized array of `T`
+/// @tparam T type of each array element
+///
+/// Unlike `UniformBuffer`, the element count is not fixed and is only limited by
+/// `GL_MAX_SHADER_STORAGE_BLOCK_SIZE`, so it fits large per-object or per-light datasets.
+/// In the shader, declare the block as an unsized array and read its size with `.length()`:
+///
+///     layout(std430, binding = 2) readonly buffer Lights { PointLight lights[]; };
+///
+/// @note - `.length()` is at least 1, even when `count` is 0 (see `bindTo`)
+/// @note - `T` must match the std430 layout of the array element in the shader. std430 does not round
+/// array strides up to 16 bytes like std140, but a `vec3` is still aligned to 16 bytes
+/// @note - Growing past the current capacity reallocates the buffer (keeping its content) and changes
+/// `id`; the binding point set with `bindTo` is kept
+/// @note - This is a non-copyable class, meaning you cannot create a copy of it
+template<typename T>
+class StorageBuffer : protected core::NonCopyable {
+public:
+    /// @brief Constructor
+    /// @param capacity Number of elements to allocate storage for up front
+    explicit StorageBuffer(size_t capacity = 1);
+
+    /// @brief Destructor
+    virtual ~StorageBuffer();
+
+    /// @brief Move constructor
+    StorageBuffer(StorageBuffer&& other) noexcept;
+
+    /// @brief Move assignment operator
+    StorageBuffer& operator=(StorageBuffer&& other) noexcept;
+
+    /// @brief Replace buffer content with `count` elements, growing the storage if needed
+    void setData(const T* data, size_t count);
+
+    /// @brief Replace buffer content with the vector elements, growing the storage if needed
+    void setData(const std::vector<T>& vector);
+
+    /// @brief Update a range of elements without touching the rest of the buffer
+    /// @param offset Index of the first element to update
+    /// @param count How many elements to update
+    /// @param data Pointer to start of data
+    /// @note Make sure that the `[offset, offset + count]` range is within bounds. Check with `count`
+    void setSubset(size_t offset, size_t count, const T* data);
+
+    /// @brief Change the element count. Existing elements are kept; new ones are left uninitialized
+    void resize(size_t count);
+
+    /// @brief Ensure storage for at least `capacity` elements, without changing `count`
+    void reserve(size_t capacity);
+
+    /// @brief Set buffer binding point on `GL_SHADER_STORAGE_BUFFER`
+    /// @note - Only the first `count` elements are bound; the range follows later `setData`/`resize` calls
+    /// @note - GL can't bind an empty range, so an empty buffer is bound with one element of unspecified
+    /// content and `.length()` returns 1; pass the count in a uniform if it may be 0
+    void bindTo(uint32_t binding);
+
+    /// @brief Current element count
+    size_t count() const { return _count; }
+
+    /// @brief Number of elements the current storage can hold
+    size_t capacity() const { return _capacity; }
+
+    /// @brief Get OpenGL identifier; used internally
+    uint32_t id() const { return _id; }
+
+private:
+    /// @brief OpenGL identifier
+    uint32_t _id = 0;
+
+    /// @brief Current element count
+    size_t _count = 0;
+
+    /// @brief Allocated element capacity
+    size_t _capacity = 0;
+
+    /// @brief Binding point set with `bindTo`, or -1 if never bound
+    int64_t _binding = -1;
+
+    /// @brief Reallocate storage for `capacity` elements, copying the first `_count` ones over
+    void reallocate(size_t capacity);
+
+    /// @brief Re-apply the binding set with `bindTo` to the current storage and element count
+    void rebind() const;
+};
+
+} // namespace tmig::render
+
+#include "tmig/render/storage_buffer.inl"
@@ -0,0 +1,150 @@
+#include <algorithm>
+
+#include "glad/glad.h"
+
+#include "tmig/util/log.hpp"
+#include "tmig/render/storage_buffer.hpp"
+
+namespace tmig::render {
+
+template<typename T>
+StorageBuffer<T>::StorageBuffer(size_t capacity) {
+    reallocate(std::max<size_t>(capacity, 1));
+}
+
+template<typename T>
+StorageBuffer<T>::~StorageBuffer() {
+    if (_id == 0) return;
+
+    util::logMessage(
+        util::LogCategory::ENGINE, util::LogSeverity::INFO,
+        "Deleting SSBO: %u\n", _id
+    );
+    glDeleteBuffers(1, &_id); glCheckError();
+}
+
+template<typename T>
+StorageBuffer<T>::StorageBuffer(StorageBuffer&& other) noexcept
+    : _id{other._id},
+      _count{other._count},
+      _capacity{other._capacity},
+      _binding{other._binding}
+{
+    other._id = 0;
+    other._count = 0;
+    other._capacity = 0;
+    other._binding = -1;
+}
+
+template<typename T>
+StorageBuffer<T>& StorageBuffer<T>::operator=(StorageBuffer&& other) noexcept {
+    if (this != &other) {
+        if (_id != 0) {
+            glDeleteBuffers(1, &_id); glCheckError();
+        }
+
+        _id = other._id;
+        _count = other._count;
+        _capacity = other._capacity;
+        _binding = other._binding;
+
+        other._id = 0;
+        other._count = 0;
+        other._capacity = 0;
+        other._binding = -1;
+    }
+    return *this;
+}
+
+template<typename T>
+void StorageBuffer<T>::setData(const T* data, size_t count) {
+    // Content is replaced entirely, so there is nothing to keep when growing
+    if (count > _capacity) {
+        _count = 0;
+        reallocate(std::max(count, _capacity * 2));
+    }
+
+    _count = count;
+    rebind();
+    if (count == 0) return;
+    glNamedBufferSubData(_id, 0, count * sizeof(T), data); glCheckError();
+}
+
+template<typename T>
+void StorageBuffer<T>::setData(const std::vector<T>& vector) {
+    setData(vector.data(), vector.size());
+}
+
+template<typename T>
+void StorageBuffer<T>::setSubset(size_t offset, size_t count, const T* data) {
+#ifdef DEBUG
+    if (offset >= _count || offset + count > _count) {
+        util::logMessage(
+            util::LogCategory::ENGINE, util::LogSeverity::WARNING,
+            "StorageBuffer::setSubset called with invalid bounds. Current count is %ld, got [offset=%ld, count=%ld]\n",
+            _count, offset, count
+        );
+        return;
+    }
+#endif
+
+    glNamedBufferSubData(_id, offset * sizeof(T), count * sizeof(T), data); glCheckError();
+}
+
+template<typename T>
+void StorageBuffer<T>::resize(size_t count) {
+    if (count > _capacity) {
+        reallocate(std::max(count, _capacity * 2));
+    }
+    _count = count;
+    rebind();
+}
+
+template<typename T>
+void StorageBuffer<T>::reserve(size_t capacity) {
+    if (capacity > _capacity) {
+        reallocate(capacity);
+    }
+}
+
+template<typename T>
+void StorageBuffer<T>::bindTo(uint32_t binding) {
+    _binding = binding;
+    rebind();
+}
+
+template<typename T>
+void StorageBuffer<T>::reallocate(size_t capacity) {
+    // Immutable storage cannot be resized; create a new buffer and copy the live elements over
+    uint32_t newId = 0;
+    glCreateBuffers(1, &newId); glCheckError();
+    glNamedBufferStorage(newId, capacity * sizeof(T), nullptr, GL_DYNAMIC_STORAGE_BIT); glCheckError();
+    util::logMessage(
+        util::LogCategory::ENGINE, util::LogSeverity::INFO,
+        "Created SSBO: %u (capacity %zu)\n", newId, capacity
+    );
+
+    if (_id != 0) {
+        const size_t keep = std::min(_count, capacity);
+        if (keep > 0) {
+            glCopyNamedBufferSubData(_id, newId, 0, 0, keep * sizeof(T)); glCheckError();
+        }
+        glDeleteBuffers(1, &_id); glCheckError();
+    }
+
+    _id = newId;
+    _capacity = capacity;
+    rebind();
+}
+
+template<typename T>
+void StorageBuffer<T>::rebind() const {
+    if (_binding < 0) return;
+
+    // Bind only the live elements so `.length()` in the shader matches `count`; empty ranges can't be
+    // bound, so an empty buffer exposes one element
+    const size_t size = std::max<size_t>(_count, 1) * sizeof(T);
+    glBindBufferRange(GL_SHADER_STORAGE_BUFFER, static_cast<uint32_t>(_binding), _id, 0, size); glCheckError();
+}
+
+} // namespace tmig::render
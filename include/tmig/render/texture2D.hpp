@@ -2,10 +2,12 @@
 
 #include <string>
 #include <cstdint>
+#include <cstddef>
 
 #include <glm/glm.hpp>
 
 #include "tmig/core/non_copyable.hpp"
+#include "tmig/render/sampler.hpp"
 
 namespace tmig::render {
 
@@ -56,6 +58,13 @@ enum class TextureFormat {
     /// @brief 32-bit float, four channels
     RGBA32F,
 
+    // ---------------- Packed Float Formats ----------------
+
+    /// @brief Unsigned 11-bit red and green, 10-bit blue floats in 32 bits; half the size of `RGBA16F`
+    /// for HDR colors that need no alpha or sign. Accepts `RGB16F`/`RGB32F` data, or packed texels
+    /// (see `util::packR11G11B10F`) given as `R11F_G11F_B10F`
+    R11F_G11F_B10F,
+
     // ---------------- sRGB Formats ----------------
 
     /// @brief 8-bit unsigned byte, RGB stored as sRGB
@@ -64,6 +73,32 @@ enum class TextureFormat {
     /// @brief 8-bit unsigned byte, RGBA stored as sRGB color + linear alpha
     SRGBA8,
 
+    // ---------------- Block Compressed Formats (4x4 texel blocks) ----------------
+
+    /// @brief BC1 (DXT1), RGB with 1-bit alpha, 8 bytes per block
+    BC1,
+
+    /// @brief BC1 (DXT1), sRGB color with 1-bit alpha, 8 bytes per block
+    BC1_SRGB,
+
+    /// @brief BC3 (DXT5), RGBA, 16 bytes per block
+    BC3,
+
+    /// @brief BC3 (DXT5), sRGB color + linear alpha, 16 bytes per block
+    BC3_SRGB,
+
+    /// @brief BC4 (RGTC1), single red channel, 8 bytes per block
+    BC4,
+
+    /// @brief BC5 (RGTC2), two channels (e.g. tangent-space normals), 16 bytes per block
+    BC5,
+
+    /// @brief BC7 (BPTC), high quality RGBA, 16 bytes per block
+    BC7,
+
+    /// @brief BC7 (BPTC), sRGB color + linear alpha, 16 bytes per block
+    BC7_SRGB,
+
     // ---------------- Depth Formats ----------------
 
     /// @brief 24-bit depth component
@@ -88,60 +123,59 @@ enum class TextureFormat {
     UNDEFINED,
 };
 
-/// @brief Represents the supported texture wrapping modes for textures when they are sampled outside
-/// their bounds.
-///
-/// Texture wrapping modes define how textures behave when texture coordinates are outside the range [0, 1].
-/// These modes determine how the texture is sampled at the edges and beyond.
-enum class TextureWrapMode {
-    /// @brief Repeat the texture infinitely in both directions
-    REPEAT,
+/// @brief Options for loading a texture from an image file
+struct TextureLoadOptions {
+    /// @brief Whether the image should be flipped vertically
+    bool flipY = true;
 
-    /// @brief Mirror the texture on each repetition (odd repetitions are flipped)
-    MIRRORED_REPEAT,
+    /// @brief Whether 3 and 4 channel images are stored as `SRGB8`/`SRGBA8` instead of `RGB8`/`RGBA8`
+    bool srgb = false;
 
-    /// @brief Clamp the texture coordinates to the edge of the texture
-    CLAMP_TO_EDGE,
+    /// @brief Whether a full mip chain is allocated and generated after loading
+    bool mipmaps = false;
 
-    /// @brief Clamp the texture coordinates to a specified border color
-    CLAMP_TO_BORDER,
+    /// @brief Whether HDR images (`.hdr`) keep full half precision in `RGB16F`/`RGBA16F` instead of
+    /// being packed into `R11F_G11F_B10F` when they have no alpha
+    bool hdrFullPrecision = false;
 };
 
-/// @brief Represents the supported texture filtering modes for when the texture is minified.
-///
-/// Texture minification occurs when the texture is viewed at smaller sizes. The filter determines how
-/// the GPU samples the texture when its dimensions are reduced, such as when it is seen from a distance.
-enum class TextureMinFilter {
-    /// @brief Sample the nearest texel, no interpolation
-    NEAREST,
+/// @brief Rectangle of a single mip level, used for partial texture updates
+struct TextureRegion {
+    /// @brief Left edge, in pixels of `level`
+    uint32_t x = 0;
 
-    /// @brief Sample the texture with linear interpolation
-    LINEAR,
+    /// @brief Bottom edge, in pixels of `level`
+    uint32_t y = 0;
 
-    /// @brief Use the nearest mipmap level, and sample using the nearest texel
-    NEAREST_MIPMAP_NEAREST,
+    /// @brief Region width; 0 extends it to the right edge of the level
+    uint32_t width = 0;
 
-    /// @brief Use the nearest mipmap level, and sample using linear interpolation
-    LINEAR_MIPMAP_NEAREST,
+    /// @brief Region height; 0 extends it to the top edge of the level
+    uint32_t height = 0;
 
-    /// @brief Linearly interpolate between two mipmap levels, using the nearest texel
-    NEAREST_MIPMAP_LINEAR,
+    /// @brief Distance in bytes between the starts of two consecutive source rows; 0 means tightly packed.
+    /// Lets a region be copied straight out of a larger image
+    size_t rowPitch = 0;
 
-    /// @brief Linearly interpolate between two mipmap levels, using linear interpolation for texels
-    LINEAR_MIPMAP_LINEAR,
+    /// @brief Mip level to update
+    uint32_t level = 0;
 };
 
-/// @brief Represents the supported texture filtering modes for when the texture is magnified.
-///
-/// Texture magnification occurs when the texture is viewed at larger sizes. The filter determines how
-/// the GPU samples the texture when it needs to be upscaled.
-enum class TextureMagFilter {
-    /// @brief Sample the nearest texel, no interpolation
-    NEAREST,
-
-    /// @brief Sample the texture with linear interpolation
-    LINEAR,
-};
+/// @brief Set the folder where `Texture2D::loadFromFile` bakes textures; empty disables baking
+/// @note Defaults to the `TMIG_TEXTURE_BAKE_FOLDER` environment variable, if set
+void setTextureBakeFolder(const std::string& folder);
+
+/// @brief Folder where textures are baked, empty if baking is disabled
+const std::string& getTextureBakeFolder();
+
+/// @brief Path of the baked texture for an image file and load options inside the bake folder
+/// @return The path, or an empty string if baking is disabled or the image file doesn't exist
+/// @note The name hashes the absolute path, size and modification time of the image, the load options
+/// and the baked format version, so editing the image or changing options bakes a new file
+std::string getBakedTexturePath(const std::string& path, const TextureLoadOptions& options);
+
+/// @brief Number of mip levels in a full chain for a `width` by `height` image, down to 1x1
+uint32_t mipLevelCount(uint32_t width, uint32_t height);
 
 /// @brief Class representing a 2D texture, used for texturing objects in rendering
 /// @note - This is a non-copyable class, meaning you cannot create a copy of it.
@@ -163,20 +197,81 @@ public:
     /// @param path Path to file
     /// @param flipY whether should flip image vertically
     /// @note - This loads the texture data and sets the internal format based on the file format
-    /// @note - Mipmap generation must be requested manually after loading the texture if desired.
-    /// This method does not automatically generate mipmaps
+    /// @note - Only the base level is allocated; for mipmaps, load with `TextureLoadOptions::mipmaps` instead
     bool loadFromFile(const std::string& path, bool flipY = true);
 
+    /// @brief Load from file
+    /// @param path Path to file
+    /// @param options Flip, sRGB and mipmap settings; `.ktx2` files ignore them and keep their own
+    /// @note - HDR images are loaded as floats and stored as half floats (see `loadFromHdr`)
+    /// @note - If a bake folder is set (see `setTextureBakeFolder`), the first load writes the result,
+    /// mip levels included, to a baked texture file, and later loads upload that file instead of
+    /// decoding the image again
+    bool loadFromFile(const std::string& path, const TextureLoadOptions& options);
+
+    /// @brief Load an HDR image (e.g. a Radiance `.hdr` environment map) as floats
+    /// @param path Path to file
+    /// @param options `sRGB` is ignored; HDR data is linear
+    /// @note - Stored as `R16F`/`RG16F`/`RGBA16F`, or `R11F_G11F_B10F` for RGB images unless
+    /// `hdrFullPrecision` is set. Floats are converted on the CPU (vectorized when available), so only
+    /// the compact data is uploaded
+    /// @note - `loadFromFile` forwards HDR files here
+    bool loadFromHdr(const std::string& path, const TextureLoadOptions& options = {});
+
+    /// @brief Load a KTX2 file, uploading its (possibly block compressed) mip chain as is
+    /// @param path Path to file
+    /// @note - Only non-supercompressed 2D textures are supported (no arrays, cubemaps or Basis Universal)
+    /// @note - KTX2 images are stored top row first and compressed blocks can't be flipped on load, so
+    /// sample them with a flipped V coordinate or author them bottom row first
+    /// @note - Files with a level count of 0 get a full mip chain generated from the base level, except for
+    /// block compressed formats, which keep the base level only
+    /// @note - The min filter is left unchanged; set a mipmap filter (e.g., `LINEAR_MIPMAP_LINEAR`) to use
+    /// the mip chain, as with `TextureLoadOptions::mipmaps`
+    /// @note - `loadFromFile` forwards `.ktx2` files here
+    bool loadFromKtx2(const std::string& path);
+
+    /// @brief Load a texture written by `saveBaked`, uploading every level straight from a memory mapping
+    /// of the file
+    /// @param path Path to file
+    bool loadFromBaked(const std::string& path);
+
+    /// @brief Write the texture, with every allocated level in its GPU format, to a baked texture file
+    /// @param path Path to file; written atomically, so a concurrent `loadFromBaked` never sees a partial file
+    /// @note Reads the texture back from the GPU, which stalls until it is ready
+    bool saveBaked(const std::string& path) const;
+
     /// @brief Set pixel data
     /// @param data Pointer to the texture data
     /// @param sourceFormat format of the incoming pixel data
-    void setData(const void *data, TextureFormat sourceFormat);
+    /// @param level Mip level to fill, sized `max(1, width >> level)` by `max(1, height >> level)`
+    /// @note For block compressed formats, `data` holds the level's blocks and `sourceFormat` must be
+    /// the internal format
+    void setData(const void *data, TextureFormat sourceFormat, uint32_t level = 0);
+
+    /// @brief Set pixel data of a rectangle of one mip level, leaving the rest untouched
+    /// @param data Pointer to the first pixel of the region, or a byte offset into the bound
+    /// `GL_PIXEL_UNPACK_BUFFER` (see `TextureStream`)
+    /// @param sourceFormat format of the incoming pixel data
+    /// @param region Rectangle, mip level and source row pitch; the default covers the whole base level
+    /// @note - Source rows don't need any alignment
+    /// @note - For block compressed formats, the region must be aligned to 4x4 blocks (or reach the level
+    /// edge) and `rowPitch` must be 0
+    void setSubData(const void* data, TextureFormat sourceFormat, const TextureRegion& region = {});
 
     /// @brief Resize texture
     /// @param internalFormat format for the internal storage of this texture
+    /// @param levels Number of mip levels to allocate; use `mipLevelCount` for a full chain
     /// @note - This will reallocate storage for the texture, including removing any existing mipmaps.
-    /// If mipmaps are desired, `generateMipmaps` must be called manually after resizing
-    void resize(uint32_t width, uint32_t height, TextureFormat internalFormat);
+    /// If mipmaps are desired, allocate them here and call `generateMipmaps` after uploading the base level
+    void resize(uint32_t width, uint32_t height, TextureFormat internalFormat, uint32_t levels = 1);
+
+    /// @brief Resize into a multisample texture (`GL_TEXTURE_2D_MULTISAMPLE`), for use as a framebuffer
+    /// attachment
+    /// @param samples Number of samples per texel; 1 is the same as `resize`
+    /// @note - Multisample textures have a single level and can't be uploaded to nor mipmapped; resolve them
+    /// with `Framebuffer::resolveTo`, or fetch individual samples with `texelFetch` on a `sampler2DMS`
+    /// @note - Sample locations are fixed, so attachments of a framebuffer always agree on them
+    void resizeMultisample(uint32_t width, uint32_t height, TextureFormat internalFormat, uint32_t samples);
 
     /// @brief Set texture wrap for the S axis (horizontal)
     void setWrapS(TextureWrapMode wrap);
@@ -197,14 +292,35 @@ public:
     /// @note This is only noticed if wrap mode in either axis is `CLAMP_TO_BORDER`
     void setBorderColor(const glm::vec4& color);
 
-    /// @brief Generate texture mipmap levels
-    /// @note This must be called manually to generate mipmaps. Mipmap generation is not automatic
+    /// @brief Replace the whole sampling state at once
+    void setSamplerState(const SamplerState& state);
+
+    /// @brief Current sampling state
+    const SamplerState& samplerState() const { return _samplerState; }
+
+    /// @brief Shared sampler matching `samplerState`, bound alongside the texture by `bind`
+    const Sampler& sampler() const;
+
+    /// @brief Generate texture mipmap levels from the base level
+    /// @note - This must be called manually to generate mipmaps. Mipmap generation is not automatic
+    /// @note - Only the levels allocated by `resize` (or `TextureLoadOptions::mipmaps`) are filled; storage is
+    /// never reallocated, so `id` stays valid. With a single level, this logs a warning and does nothing
+    /// @note - Mips are only regenerated after the base level changes through `setData`/`setSubData`
+    /// (including `TextureStream` uploads); other calls return early
     void generateMipmaps();
 
-    /// @brief Bind to texture unit
+    /// @brief Drop the `count` largest mip levels, halving the resolution each time to save memory
+    /// @note - The remaining levels are copied into new storage, changing `id`, `width` and `height`
+    /// @note - Does nothing if fewer than `count + 1` levels are allocated
+    void dropTopMipLevels(uint32_t count = 1);
+
+    /// @brief Bind to texture unit, together with the sampler matching `samplerState`
     void bind(uint32_t unit = 0) const;
 
-    /// @brief Unbind from texture unit
+    /// @brief Bind to texture unit with another sampler, e.g. to sample the same texture several ways
+    void bind(uint32_t unit, const Sampler& sampler) const;
+
+    /// @brief Unbind texture and sampler from texture unit
     static void unbind(uint32_t unit = 0);
 
     /// @brief Texture ID; used internally
@@ -219,15 +335,34 @@ public:
     /// @brief Current internal format
     TextureFormat format() const { return _internalFormat; }
 
+    /// @brief Number of allocated mip levels
+    uint32_t levelCount() const { return _levels; }
+
+    /// @brief Number of samples per texel; greater than 1 for multisample textures
+    uint32_t samples() const { return _samples; }
+
+    /// @brief Estimated GPU memory used by the allocated storage, in bytes
+    size_t memorySize() const;
+
     /// @brief Checks whether an internal and a source texture format are compatible
     static bool isFormatCompatible(TextureFormat internal, TextureFormat source);
 
+    /// @brief Size in bytes of a single pixel in an uncompressed `format`, 0 for block compressed formats
+    static size_t texelSize(TextureFormat format);
+
+    /// @brief Whether `format` is a block compressed format
+    static bool isCompressedFormat(TextureFormat format);
+
+    /// @brief Size in bytes of a `width` by `height` image in a block compressed `format`
+    static size_t compressedImageSize(TextureFormat format, uint32_t width, uint32_t height);
+
 private:
-    /// @brief Recreate the GL texture object. Needed because `glTextureStorage2D` is immutable
-    void recreateTextureObject();
+    /// @brief Decode an 8-bit image file with stb_image
+    bool loadFromImage(const std::string& path, const TextureLoadOptions& options);
 
-    /// @brief Re-apply cached sampler state after the texture object is recreated
-    void applySamplerState() const;
+    /// @brief Recreate the GL texture object. Needed because `glTextureStorage2D` is immutable.
+    /// The target follows `_samples`
+    void recreateTextureObject();
 
     /// @brief Texture OpenGL identifier
     uint32_t _id = 0;
@@ -238,17 +373,24 @@ private:
     /// @brief Texture height in pixels
     uint32_t _height = 0;
 
+    /// @brief Number of allocated mip levels
+    uint32_t _levels = 1;
+
+    /// @brief Number of samples per texel
+    uint32_t _samples = 1;
+
     /// @brief Whether texture has mipmaps generated
     bool _hasMipmaps = false;
 
     /// @brief Current internal format
     TextureFormat _internalFormat = TextureFormat::UNDEFINED;
 
-    TextureWrapMode _wrapS = TextureWrapMode::REPEAT;
-    TextureWrapMode _wrapT = TextureWrapMode::REPEAT;
-    TextureMinFilter _minFilter = TextureMinFilter::LINEAR;
-    TextureMagFilter _magFilter = TextureMagFilter::LINEAR;
-    glm::vec4 _borderColor{0.0f};
+    /// @brief Sampling state; lives in a shared `Sampler`, not in the texture object
+    SamplerState _samplerState;
+
+    /// @brief Sampler matching `_samplerState`, fetched lazily so consecutive setters don't create
+    /// intermediate samplers
+    mutable std::shared_ptr<const Sampler> _sampler;
 };
 
 } // namespace tmig::render
\ No newline at end of file
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <memory>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "tmig/core/non_copyable.hpp"
+#include "tmig/render/texture2D.hpp"
+
+namespace tmig::render {
+
+/// @brief Class representing an array of same-sized 2D textures, sampled as `sampler2DArray`
+///
+/// All layers share one texture object, so objects using different layers can be drawn without
+/// rebinding in between. Pass the layer per instance (e.g. a `FLOAT` instance attribute) and sample
+/// with `texture(textures, vec3(uv, layer))`.
+/// @note - This is a non-copyable class, meaning you cannot create a copy of it.
+class Texture2DArray : protected core::NonCopyable {
+public:
+    /// @brief Default constructor
+    Texture2DArray();
+
+    /// @brief Destructor
+    ~Texture2DArray();
+
+    /// @brief Move constructor
+    Texture2DArray(Texture2DArray&& other) noexcept;
+
+    /// @brief Move assignment
+    Texture2DArray& operator=(Texture2DArray&& other) noexcept;
+
+    /// @brief Resize texture array
+    /// @param layers Number of layers
+    /// @param internalFormat format for the internal storage of every layer
+    /// @param levels Number of mip levels to allocate; use `mipLevelCount` for a full chain
+    /// @note This will reallocate storage for the texture, dropping the content of every layer
+    void resize(uint32_t width, uint32_t height, uint32_t layers, TextureFormat internalFormat, uint32_t levels = 1);
+
+    /// @brief Set pixel data of a single layer
+    /// @param layer Layer to fill
+    /// @param data Pointer to the layer data
+    /// @param sourceFormat format of the incoming pixel data
+    /// @param level Mip level to fill, sized `max(1, width >> level)` by `max(1, height >> level)`
+    /// @note Source rows are tightly packed and don't need any alignment
+    void setLayerData(uint32_t layer, const void* data, TextureFormat sourceFormat, uint32_t level = 0);
+
+    /// @brief Set texture wrap for the S axis (horizontal)
+    void setWrapS(TextureWrapMode wrap);
+
+    /// @brief Set texture wrap for the T axis (vertical)
+    void setWrapT(TextureWrapMode wrap);
+
+    /// @brief Set minification filter (used when the texture is scaled down)
+    void setMinFilter(TextureMinFilter filter);
+
+    /// @brief Set magnification filter (used when the texture is scaled up)
+    void setMagFilter(TextureMagFilter filter);
+
+    /// @brief Replace the whole sampling state at once
+    void setSamplerState(const SamplerState& state);
+
+    /// @brief Current sampling state
+    const SamplerState& samplerState() const { return _samplerState; }
+
+    /// @brief Shared sampler matching `samplerState`, bound alongside the texture by `bind`
+    const Sampler& sampler() const;
+
+    /// @brief Generate mip levels of every layer from their base level
+    /// @note Only the levels allocated by `resize` are filled
+    void generateMipmaps();
+
+    /// @brief Bind to texture unit, together with the sampler matching `samplerState`
+    void bind(uint32_t unit = 0) const;
+
+    /// @brief Unbind texture and sampler from texture unit
+    static void unbind(uint32_t unit = 0);
+
+    /// @brief Texture ID; used internally
+    uint32_t id() const { return _id; }
+
+    /// @brief Width of each layer
+    uint32_t width() const { return _width; }
+
+    /// @brief Height of each layer
+    uint32_t height() const { return _height; }
+
+    /// @brief Number of layers
+    uint32_t layers() const { return _layers; }
+
+    /// @brief Number of allocated mip levels
+    uint32_t levelCount() const { return _levels; }
+
+    /// @brief Current internal format
+    TextureFormat format() const { return _internalFormat; }
+
+private:
+    /// @brief Texture OpenGL identifier
+    uint32_t _id = 0;
+
+    /// @brief Layer width in pixels
+    uint32_t _width = 0;
+
+    /// @brief Layer height in pixels
+    uint32_t _height = 0;
+
+    /// @brief Number of layers
+    uint32_t _layers = 0;
+
+    /// @brief Number of allocated mip levels
+    uint32_t _levels = 1;
+
+    /// @brief Current internal format
+    TextureFormat _internalFormat = TextureFormat::UNDEFINED;
+
+    /// @brief Sampling state; lives in a shared `Sampler`, not in the texture object
+    SamplerState _samplerState;
+
+    /// @brief Sampler matching `_samplerState`, fetched lazily
+    mutable std::shared_ptr<const Sampler> _sampler;
+};
+
+} // namespace tmig::render
\ No newline at end of file
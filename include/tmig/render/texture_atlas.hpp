@@ -0,0 +1,94 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <optional>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "tmig/core/non_copyable.hpp"
+#include "tmig/render/texture2D.hpp"
+
+namespace tmig::render {
+
+/// @brief Region of a `TextureAtlas` holding one packed image
+struct AtlasRegion {
+    /// @brief Offset of the image in the atlas, in pixels
+    glm::uvec2 offset{0};
+
+    /// @brief Size of the image, in pixels
+    glm::uvec2 size{0};
+
+    /// @brief UV rectangle of the image: `xy` is the minimum corner, `zw` the extent.
+    /// Remap mesh UVs with `rect.xy + uv * rect.zw`
+    glm::vec4 uvRect{0.0f};
+};
+
+/// @brief Packs many small images into a single `Texture2D`, so they can be drawn without rebinding
+///
+/// Images are placed with a shelf packer: rows of images sorted into the shortest shelf that fits,
+/// opening a new shelf when none does. Pass each object's `uvRect` per instance (e.g. a `FLOAT4`
+/// instance attribute) to draw differently-textured objects in one call.
+/// @note - Packing is online, so adding images from tallest to shortest packs best
+/// @note - Mipmaps bleed between neighbours; use a `padding` of at least `2^(levels - 1)` pixels if the
+/// atlas is mipmapped
+/// @note - This is a non-copyable class, meaning you cannot create a copy of it.
+class TextureAtlas : protected core::NonCopyable {
+public:
+    /// @brief Constructor
+    /// @param format Internal format of the atlas; every added image must be compatible with it
+    /// @param padding Pixels kept around each image to avoid filtering bleed, filled with copies of its edge texels
+    TextureAtlas(uint32_t width, uint32_t height, TextureFormat format, uint32_t padding = 1);
+
+    /// @brief Pack an image into the atlas and upload it
+    /// @param data Pointer to the image data, tightly packed
+    /// @param sourceFormat format of the incoming pixel data
+    /// @return The region of the image, or `std::nullopt` if the atlas is full
+    std::optional<AtlasRegion> add(uint32_t width, uint32_t height, const void* data, TextureFormat sourceFormat);
+
+    /// @brief Load an image file and pack it into the atlas
+    /// @param flipY whether should flip image vertically
+    /// @return The region of the image, or `std::nullopt` if loading failed or the atlas is full
+    std::optional<AtlasRegion> addFromFile(const std::string& path, bool flipY = true);
+
+    /// @brief Remove every image; the texture keeps its previous content until overwritten
+    void clear();
+
+    /// @brief Atlas texture, to bind with `ShaderProgram::setTexture`
+    const Texture2D& texture() const { return _texture; }
+
+    /// @brief Atlas texture, e.g. to change its sampler state or generate mipmaps
+    Texture2D& texture() { return _texture; }
+
+    /// @brief Fraction of the atlas area covered by packed images
+    float occupancy() const;
+
+private:
+    /// @brief A row of images
+    struct Shelf {
+        uint32_t y;
+        uint32_t height;
+        uint32_t usedWidth;
+    };
+
+    /// @brief Find space for a `width` by `height` block (padding included)
+    std::optional<glm::uvec2> allocate(uint32_t width, uint32_t height);
+
+    /// @brief Atlas texture
+    Texture2D _texture;
+
+    /// @brief Padding around each image, in pixels
+    uint32_t _padding;
+
+    /// @brief Shelves opened so far, from top to bottom
+    std::vector<Shelf> _shelves;
+
+    /// @brief Height used by the opened shelves
+    uint32_t _usedHeight = 0;
+
+    /// @brief Area covered by packed images, padding excluded
+    uint64_t _usedArea = 0;
+};
+
+} // namespace tmig::render
\ No newline at end of file
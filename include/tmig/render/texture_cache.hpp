@@ -0,0 +1,121 @@
+#pragma once
+
+#include <string>
+#include <memory>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+#include "tmig/core/non_copyable.hpp"
+#include "tmig/render/texture2D.hpp"
+
+namespace tmig::render {
+
+class TextureCache;
+
+/// @brief Shared reference to a texture owned by a `TextureCache`
+///
+/// Copies refer to the same texture. Accessing it through `texture` marks it as recently used and
+/// reloads it if the cache evicted it to stay within its budget.
+class TextureHandle {
+public:
+    /// @brief Empty handle
+    TextureHandle() = default;
+
+    /// @brief The texture, reloaded first if it was evicted or reduced
+    /// @note Don't keep the reference across frames; an eviction may reallocate the texture
+    const Texture2D& texture() const;
+
+    /// @brief Path the texture was loaded from
+    const std::string& path() const;
+
+    /// @brief Whether the handle refers to a texture
+    explicit operator bool() const { return _entry != nullptr; }
+
+private:
+    friend class TextureCache;
+
+    struct Entry;
+
+    explicit TextureHandle(std::shared_ptr<Entry> entry) : _entry{std::move(entry)} {}
+
+    /// @brief Cache entry, shared with the cache and every copy of this handle
+    std::shared_ptr<Entry> _entry;
+};
+
+/// @brief Configuration for `TextureCache`
+struct TextureCacheConfig {
+    /// @brief GPU memory budget for cached textures, in bytes
+    size_t budget = 512 * 1024 * 1024;
+
+    /// @brief Textures are not reduced below this size (in their largest dimension) by dropping mips
+    uint32_t minimumReducedSize = 64;
+};
+
+/// @brief Loads each image file once and shares it through `TextureHandle`s, keeping the total texture
+/// memory within a budget
+///
+/// When the budget is exceeded, least recently used textures are trimmed first: textures no handle
+/// refers to are released, mipmapped ones lose their largest levels, and the rest are unloaded to be
+/// reloaded on their next use. Textures used in the current frame (see `beginFrame`) are never trimmed.
+/// @note - Every method, including `TextureHandle::texture`, must be called from the GL thread
+/// @note - This is a non-copyable class, meaning you cannot create a copy of it
+class TextureCache : protected core::NonCopyable {
+public:
+    /// @brief Constructor
+    explicit TextureCache(const TextureCacheConfig& config = {});
+
+    /// @brief Destructor; textures stay alive while handles refer to them, but are no longer reloaded
+    ~TextureCache();
+
+    /// @brief Get the texture loaded from `path` with `options`, loading it if not cached yet
+    /// @return Handle to the texture, or an empty handle if loading failed
+    TextureHandle get(const std::string& path, const TextureLoadOptions& options = {});
+
+    /// @brief Start a new frame for least-recently-used tracking
+    void beginFrame();
+
+    /// @brief Change the memory budget, trimming right away if needed
+    void setBudget(size_t budget);
+
+    /// @brief Trim textures until the used memory fits the budget (or nothing else can be trimmed)
+    void trim();
+
+    /// @brief Release every texture no handle refers to
+    void releaseUnused();
+
+    /// @brief GPU memory used by cached textures, in bytes
+    size_t usedBytes() const { return _usedBytes; }
+
+    /// @brief Current memory budget, in bytes
+    size_t budget() const { return _config.budget; }
+
+    /// @brief Number of cached textures
+    size_t textureCount() const { return _entries.size(); }
+
+private:
+    friend class TextureHandle;
+
+    /// @brief Mark an entry as used, restoring it to full quality if evicted or reduced
+    void use(TextureHandle::Entry& entry);
+
+    /// @brief (Re)load an entry from its file, updating the used memory
+    bool load(TextureHandle::Entry& entry);
+
+    /// @brief Build the cache key of a path and its options
+    static std::string makeKey(const std::string& path, const TextureLoadOptions& options);
+
+    /// @brief Budget and reduction limits
+    TextureCacheConfig _config;
+
+    /// @brief Cached textures by key
+    std::unordered_map<std::string, std::shared_ptr<TextureHandle::Entry>> _entries;
+
+    /// @brief GPU memory used by cached textures, in bytes
+    size_t _usedBytes = 0;
+
+    /// @brief Current frame, for least-recently-used tracking
+    uint64_t _frame = 0;
+};
+
+} // namespace tmig::render
\ No newline at end of file
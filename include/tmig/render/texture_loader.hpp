@@ -0,0 +1,150 @@
+#pragma once
+
+#include <string>
+#include <memory>
+#include <future>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <deque>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "tmig/core/non_copyable.hpp"
+#include "tmig/render/texture2D.hpp"
+
+namespace tmig::render {
+
+/// @brief Configuration for `TextureLoader`
+struct TextureLoaderConfig {
+    /// @brief Number of decoding threads; 0 picks one less than the hardware concurrency
+    uint32_t workerCount = 0;
+
+    /// @brief Number of pixel unpack buffer slots uploads are staged through
+    uint32_t uploadSlotCount = 4;
+
+    /// @brief Size in bytes of each upload slot. Images larger than a slot are uploaded in row chunks
+    size_t uploadSlotSize = 8 * 1024 * 1024;
+};
+
+/// @brief Loads textures asynchronously, decoding images on worker threads and uploading them
+/// through a ring of persistently mapped pixel unpack buffers
+///
+/// `load` returns immediately; decoding runs in the background, while GL work only happens inside
+/// `update`, which must be called from the GL thread (typically once per frame). Each `update`
+/// copies at most `byteBudget` bytes into the upload ring, so streaming hundreds of textures is
+/// spread over several frames instead of blocking one.
+///
+/// @note - Results are delivered from `update`: the future becomes ready and the callback runs on the
+/// GL thread once the whole image has been uploaded. A failed load yields a `nullptr` texture
+/// @note - Waiting on a returned future from the GL thread without calling `update` deadlocks
+/// @note - Images are decoded to 8 bits per channel; load HDR images with `Texture2D::loadFromHdr`
+/// @note - This is a non-copyable class, meaning you cannot create a copy of it
+class TextureLoader : protected core::NonCopyable {
+public:
+    /// @brief Called on the GL thread when a texture is ready, with `nullptr` if loading failed
+    using Callback = std::function<void(std::shared_ptr<Texture2D>)>;
+
+    /// @brief Constructor; creates the upload ring and starts the worker threads
+    explicit TextureLoader(const TextureLoaderConfig& config = {});
+
+    /// @brief Destructor; stops the workers and fails every pending load
+    ~TextureLoader();
+
+    /// @brief Queue an image file for loading
+    /// @param path Path to file
+    /// @param onReady Optional callback, run from `update` once the texture is ready
+    /// @return Future holding the texture, ready once the upload completed
+    std::shared_future<std::shared_ptr<Texture2D>> load(
+        const std::string& path,
+        const TextureLoadOptions& options = {},
+        Callback onReady = {}
+    );
+
+    /// @brief Stage decoded images into the upload ring and finish completed uploads
+    /// @param byteBudget Maximum number of pixel bytes staged by this call
+    /// @note Must be called from the GL thread
+    void update(size_t byteBudget = 32 * 1024 * 1024);
+
+    /// @brief Block until every queued texture is loaded, calling `update` as needed
+    /// @note Must be called from the GL thread
+    void finish();
+
+    /// @brief Number of loads not yet delivered
+    size_t pendingCount() const;
+
+private:
+    /// @brief A single load request, moving from the workers to the GL thread
+    struct Job {
+        std::string path;
+        TextureLoadOptions options;
+        std::promise<std::shared_ptr<Texture2D>> promise;
+        Callback onReady;
+
+        /// @brief Decoded pixels, owned by the job and released with `stbi_image_free`
+        unsigned char* pixels = nullptr;
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+
+        /// @brief Destination texture, created on the GL thread when staging starts
+        std::shared_ptr<Texture2D> texture;
+
+        /// @brief Number of rows already staged for upload
+        uint32_t stagedRows = 0;
+    };
+
+    /// @brief Worker thread loop; decodes queued jobs
+    void workerLoop();
+
+    /// @brief Stage as many rows of `job` as `byteBudget` and the ring allow
+    /// @return Whether the job was fully staged
+    bool stageJob(Job& job, size_t& byteBudget);
+
+    /// @brief Fulfill the job's future and callback, then release its pixels
+    void deliver(Job& job, std::shared_ptr<Texture2D> texture, bool runCallback = true);
+
+    /// @brief Slot sizes and counts; fixed after construction
+    TextureLoaderConfig _config;
+
+    /// @brief Pixel unpack buffer holding every upload slot
+    uint32_t _uploadBuffer = 0;
+
+    /// @brief Persistent mapping of `_uploadBuffer`
+    unsigned char* _uploadMemory = nullptr;
+
+    /// @brief Fence guarding each slot until the GPU has consumed it (`GLsync`, stored opaquely)
+    std::vector<void*> _slotFences;
+
+    /// @brief Next slot of the ring to stage into
+    uint32_t _nextSlot = 0;
+
+    /// @brief Decoding threads
+    std::vector<std::thread> _workers;
+
+    /// @brief Guards `_queued`, `_decoded` and `_stopping`
+    std::mutex _mutex;
+
+    /// @brief Wakes workers when a job is queued or the loader stops
+    std::condition_variable _condition;
+
+    /// @brief Jobs waiting to be decoded
+    std::deque<std::unique_ptr<Job>> _queued;
+
+    /// @brief Jobs decoded (or failed), waiting for the GL thread
+    std::deque<std::unique_ptr<Job>> _decoded;
+
+    /// @brief Jobs being staged; only touched from the GL thread
+    std::deque<std::unique_ptr<Job>> _uploading;
+
+    /// @brief Whether workers should exit
+    bool _stopping = false;
+
+    /// @brief Loads requested but not yet delivered
+    std::atomic<size_t> _pending{0};
+};
+
+} // namespace tmig::render
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "tmig/core/non_copyable.hpp"
+#include "tmig/render/texture2D.hpp"
+
+namespace tmig::render {
+
+/// @brief Streams pixel data that changes every frame (video frames, dynamic heightmaps, CPU generated
+/// images) into textures without stalling the pipeline
+///
+/// Data is written into one of `bufferCount` slots of a persistently mapped pixel unpack buffer and
+/// copied into the texture by the GPU asynchronously. Each slot is guarded by a fence, so the CPU only
+/// waits if it laps the GPU, which with 2 (double buffering) or 3 (triple buffering) slots per updated
+/// texture and frame in flight should not happen.
+///
+/// Typical use, once per frame:
+/// @code
+/// void* pixels = stream.map();
+/// decodeFrameInto(pixels);
+/// stream.upload(texture, render::TextureFormat::RGBA8);
+/// @endcode
+/// @note - Every upload consumes a slot; updating several textures per frame needs proportionally more slots
+/// @note - This is a non-copyable class, meaning you cannot create a copy of it
+class TextureStream : protected core::NonCopyable {
+public:
+    /// @brief Constructor
+    /// @param frameSize Size in bytes of the largest single upload
+    /// @param bufferCount Number of slots; 3 allows the CPU to run two uploads ahead of the GPU
+    explicit TextureStream(size_t frameSize, uint32_t bufferCount = 3);
+
+    /// @brief Destructor; waits for the GPU to finish reading the slots
+    ~TextureStream();
+
+    /// @brief Move constructor
+    TextureStream(TextureStream&& other) noexcept;
+
+    /// @brief Move assignment
+    TextureStream& operator=(TextureStream&& other) noexcept;
+
+    /// @brief Get the memory of the next slot, `frameSize` bytes, to write the next upload into
+    /// @note Blocks only if the GPU still reads the slot; see `stallCount`
+    void* map();
+
+    /// @brief Copy the slot returned by `map` into a region of `texture`, then move on to the next slot
+    /// @param sourceFormat format of the pixel data in the slot
+    /// @param region Updated rectangle and mip level; the slot holds its pixels starting at offset 0
+    void upload(Texture2D& texture, TextureFormat sourceFormat, const TextureRegion& region = {});
+
+    /// @brief Copy `data` into the next slot and upload it; shorthand for `map`, `memcpy` and `upload`
+    void write(Texture2D& texture, const void* data, TextureFormat sourceFormat, const TextureRegion& region = {});
+
+    /// @brief Size in bytes of each slot
+    size_t frameSize() const { return _frameSize; }
+
+    /// @brief Number of slots
+    uint32_t bufferCount() const { return static_cast<uint32_t>(_fences.size()); }
+
+    /// @brief Number of times `map` had to wait for the GPU; if this grows, add slots
+    uint64_t stallCount() const { return _stallCount; }
+
+private:
+    /// @brief Size in bytes of the pixel data of `region` in `texture`
+    static size_t regionSize(const Texture2D& texture, TextureFormat sourceFormat, const TextureRegion& region);
+
+    /// @brief Pixel unpack buffer holding every slot
+    uint32_t _buffer = 0;
+
+    /// @brief Persistent mapping of `_buffer`
+    unsigned char* _memory = nullptr;
+
+    /// @brief Usable size of each slot
+    size_t _frameSize = 0;
+
+    /// @brief Distance between slots, `_frameSize` rounded up for alignment
+    size_t _slotStride = 0;
+
+    /// @brief Fence guarding each slot until the GPU has consumed it (`GLsync`, stored opaquely)
+    std::vector<void*> _fences;
+
+    /// @brief Slot returned by the next `map`
+    uint32_t _nextSlot = 0;
+
+    /// @brief Whether `map` was called and the slot is waiting for `upload`
+    bool _mapped = false;
+
+    /// @brief Number of times `map` had to wait for the GPU
+    uint64_t _stallCount = 0;
+};
+
+} // namespace tmig::render
@@ -0,0 +1,242 @@
+#pragma once
+
+#include <string>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+#include "tmig/core/non_copyable.hpp"
+#include "tmig/render/texture2D.hpp"
+#include "tmig/render/framebuffer.hpp"
+#include "tmig/render/shader.hpp"
+
+namespace tmig::render {
+
+/// @brief Configuration for `VirtualTexture`
+struct VirtualTextureConfig {
+    /// @brief Virtual width in texels; a power of two multiple of `pageSize`
+    uint32_t width = 0;
+
+    /// @brief Virtual height in texels; a power of two multiple of `pageSize`
+    uint32_t height = 0;
+
+    /// @brief Page width and height in texels, excluding the border
+    uint32_t pageSize = 128;
+
+    /// @brief Texels duplicated from neighbouring pages around each page, so bilinear filtering
+    /// doesn't bleed into unrelated cache pages
+    uint32_t pageBorder = 4;
+
+    /// @brief Physical cache width and height in pages, at most 256. The cache takes
+    /// `(cachePages * (pageSize + 2 * pageBorder))^2` texels whatever the virtual size
+    uint32_t cachePages = 16;
+
+    /// @brief Feedback pass resolution divider relative to the screen
+    uint32_t feedbackScale = 8;
+
+    /// @brief Number of page loading threads
+    uint32_t workerCount = 2;
+
+    /// @brief Maximum number of pages uploaded into the cache per `update`
+    uint32_t maxUploadsPerUpdate = 8;
+
+    /// @brief Whether pages are sRGB encoded
+    bool srgb = false;
+};
+
+/// @brief Software virtual texture: a texture far larger than what is kept in VRAM, split into pages
+/// streamed on demand into a fixed size physical cache
+///
+/// Shaders sample it through an indirection page table holding, for every page of every mip level, where
+/// it lives in the cache. Missing pages are redirected to their closest resident ancestor, so sampling
+/// always succeeds, only blurrier until the page arrives.
+///
+/// Pages are requested by a feedback pass: render the scene between `beginFeedback` and `endFeedback`
+/// with a fragment shader writing `vtFeedback(uv)`. The small feedback image is read back
+/// asynchronously; `update` then queues missing pages for the loader threads, uploads loaded pages
+/// (evicting the least recently used ones) and refreshes the page table.
+///
+/// The GLSL side is in `engine/shaders/virtual_texture.glsl` (see `util::readResource`); insert it after
+/// the `#version` line and call `setUniforms` on the shader.
+/// @note - The coarsest mip level is loaded during construction and never evicted
+/// @note - Every method must be called from the GL thread
+/// @note - This is a non-copyable class, meaning you cannot create a copy of it
+class VirtualTexture : protected core::NonCopyable {
+public:
+    /// @brief Fills `pixels` with page (`x`, `y`) of mip `level`: `size` by `size` RGBA8 texels, bottom row
+    /// first, with `size = pageSize + 2 * pageBorder` (border included). Called from the loader threads
+    /// @return Whether the page could be loaded; failed pages are logged once and never requested again
+    using PageLoader = std::function<bool(uint32_t level, uint32_t x, uint32_t y, uint32_t size, uint8_t* pixels)>;
+
+    /// @brief Constructor; creates the textures and starts the loader threads
+    VirtualTexture(const VirtualTextureConfig& config, PageLoader loader);
+
+    /// @brief Destructor; stops the loader threads
+    ~VirtualTexture();
+
+    /// @brief Page loader reading `<folder>/<level>/<x>_<y>.png` image files, each holding a padded page.
+    /// Files of the wrong size fail to load
+    static PageLoader folderLoader(const std::string& folder);
+
+    /// @brief Bind the feedback framebuffer, sized from the screen size and `feedbackScale`, and clear it
+    void beginFeedback(uint32_t screenWidth, uint32_t screenHeight);
+
+    /// @brief Start reading the feedback image back; the result is consumed by a later `update`
+    /// @note The feedback framebuffer stays bound
+    void endFeedback();
+
+    /// @brief Bind the page table and cache and set the uniforms of `virtual_texture.glsl`
+    void setUniforms(ShaderProgram& shader, uint32_t pageTableUnit = 0, uint32_t cacheUnit = 1) const;
+
+    /// @brief Process completed feedback readbacks, queue page loads, upload loaded pages and refresh
+    /// the page table. Call once per frame
+    void update();
+
+    /// @brief Number of mip levels of the virtual texture
+    uint32_t levelCount() const { return _pageTable.levelCount(); }
+
+    /// @brief Number of pages in the cache
+    size_t residentPageCount() const { return _resident.size(); }
+
+    /// @brief Number of pages requested but not uploaded yet
+    size_t pendingPageCount() const { return _pending.size(); }
+
+    /// @brief Physical page cache
+    const Texture2D& cacheTexture() const { return _cache; }
+
+    /// @brief Indirection page table; one mip level per virtual mip level, one texel per page
+    const Texture2D& pageTable() const { return _pageTable; }
+
+private:
+    /// @brief A cache page and the virtual page it holds
+    struct CacheSlot {
+        /// @brief Key of the held page, `INVALID_PAGE` if free
+        uint64_t page;
+
+        /// @brief Update of the last feedback referring to it
+        uint64_t lastUsed = 0;
+
+        /// @brief Whether the page can't be evicted
+        bool locked = false;
+    };
+
+    /// @brief A page loaded by a loader thread, waiting for upload
+    struct LoadedPage {
+        uint64_t page;
+        std::vector<uint8_t> pixels;
+        bool loaded;
+    };
+
+    /// @brief A feedback image being read back
+    struct Readback {
+        uint32_t buffer = 0;
+
+        /// @brief Fence signaled when the copy is done (`GLsync`, stored opaquely); `nullptr` if idle
+        void* fence = nullptr;
+
+        uint32_t width = 0;
+        uint32_t height = 0;
+    };
+
+    static constexpr uint64_t INVALID_PAGE = ~uint64_t{0};
+
+    /// @brief Pack a page address into a key
+    static uint64_t pageKey(uint32_t level, uint32_t x, uint32_t y) {
+        return (uint64_t{level} << 48) | (uint64_t{y} << 24) | x;
+    }
+
+    /// @brief Number of pages along x at `level`
+    uint32_t pagesX(uint32_t level) const { return std::max(_pageTable.width() >> level, 1u); }
+
+    /// @brief Number of pages along y at `level`
+    uint32_t pagesY(uint32_t level) const { return std::max(_pageTable.height() >> level, 1u); }
+
+    /// @brief Loader thread loop
+    void workerLoop();
+
+    /// @brief Collect the pages referenced by a feedback image, queueing missing ones
+    void processFeedback(const uint8_t* pixels, uint32_t width, uint32_t height);
+
+    /// @brief Mark a page and its ancestors as used, queueing the missing ones coarsest first
+    void request(uint32_t level, uint32_t x, uint32_t y);
+
+    /// @brief Copy a loaded page into a free or evicted cache slot
+    /// @return Whether a slot was available
+    bool upload(const LoadedPage& page, bool locked);
+
+    /// @brief Rebuild and upload the page table from the resident pages
+    void updatePageTable();
+
+    /// @brief Configuration; fixed after construction
+    VirtualTextureConfig _config;
+
+    /// @brief Page source, called from the loader threads
+    PageLoader _loader;
+
+    /// @brief Indirection texture: cache page x, y and the mapped level per virtual page
+    Texture2D _pageTable;
+
+    /// @brief Physical page cache
+    Texture2D _cache;
+
+    /// @brief Feedback pass color target
+    Texture2D _feedbackColor;
+
+    /// @brief Feedback pass depth target
+    Texture2D _feedbackDepth;
+
+    /// @brief Feedback pass framebuffer
+    Framebuffer _feedbackFramebuffer;
+
+    /// @brief Ring of readback buffers, so the CPU never waits for the GPU
+    std::vector<Readback> _readbacks;
+
+    /// @brief Readback used by the next `endFeedback`
+    uint32_t _nextReadback = 0;
+
+    /// @brief Cache slots, row by row
+    std::vector<CacheSlot> _slots;
+
+    /// @brief Resident pages and their slot index
+    std::unordered_map<uint64_t, uint32_t> _resident;
+
+    /// @brief Pages queued or being loaded; only touched from the GL thread
+    std::unordered_set<uint64_t> _pending;
+
+    /// @brief Pages the loader failed on, never requested again; only touched from the GL thread
+    std::unordered_set<uint64_t> _failed;
+
+    /// @brief Whether the page table is out of date
+    bool _pageTableDirty = true;
+
+    /// @brief Number of `update` calls, for least-recently-used tracking
+    uint64_t _frame = 1;
+
+    /// @brief Loader threads
+    std::vector<std::thread> _workers;
+
+    /// @brief Guards `_queued`, `_loaded` and `_stopping`
+    std::mutex _mutex;
+
+    /// @brief Wakes loader threads when a page is queued or the texture is destroyed
+    std::condition_variable _condition;
+
+    /// @brief Pages waiting for a loader thread
+    std::deque<uint64_t> _queued;
+
+    /// @brief Pages loaded, waiting for upload
+    std::deque<LoadedPage> _loaded;
+
+    /// @brief Whether loader threads should exit
+    bool _stopping = false;
+};
+
+} // namespace tmig::render
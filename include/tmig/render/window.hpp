@@ -7,10 +7,14 @@
 namespace tmig::render::window {
 
 /// @brief Initializes the window used by the engine
+/// @param samples MSAA samples of the window surface; 0 disables it. Apps rendering the scene into
+/// multisampled framebuffers (see `FramebufferConfig::samples`) only need a single sample window
+/// @note Called by `render::init()` with the defaults; call it first to pick other values
 void init(
     int width = 600,
     int height = 600,
-    const std::string& title = "tmig"
+    const std::string& title = "tmig",
+    int samples = 4
 );
 
 /// @brief Gets the current time since the render module was initialized
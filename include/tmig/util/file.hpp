@@ -1,6 +1,9 @@
 #pragma once
 
 #include <string>
+#include <cstddef>
+
+#include "tmig/core/non_copyable.hpp"
 
 namespace tmig::util {
 
@@ -8,4 +11,46 @@ namespace tmig::util {
 /// @note Throws an `std::runtime_error` if reading fails
 std::string readFileContent(const std::string& filePath);
 
+/// @brief Read-only memory mapping of a whole file
+///
+/// The OS pages the content in on access, so the data can be handed straight to an upload without
+/// first being copied into a buffer.
+/// @note - This is a non-copyable class, meaning you cannot create a copy of it
+class MappedFile : protected core::NonCopyable {
+public:
+    /// @brief Empty mapping
+    MappedFile() = default;
+
+    /// @brief Map `filePath`; check `isOpen` for success
+    explicit MappedFile(const std::string& filePath);
+
+    /// @brief Destructor; unmaps the file
+    ~MappedFile();
+
+    /// @brief Move constructor
+    MappedFile(MappedFile&& other) noexcept;
+
+    /// @brief Move assignment
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /// @brief Whether a file is mapped
+    bool isOpen() const { return _data != nullptr; }
+
+    /// @brief Start of the mapped content
+    const unsigned char* data() const { return _data; }
+
+    /// @brief Size of the mapped content in bytes
+    size_t size() const { return _size; }
+
+private:
+    /// @brief Unmap the file, if any
+    void close();
+
+    /// @brief Start of the mapped content
+    const unsigned char* _data = nullptr;
+
+    /// @brief Size of the mapped content in bytes
+    size_t _size = 0;
+};
+
 } // namespace tmig::util
\ No newline at end of file
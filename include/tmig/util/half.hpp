@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace tmig::util {
+
+/// @brief Convert a float to a 16-bit half float, rounding to nearest even
+/// @note Values too large for a half become infinity; NaNs stay NaN
+uint16_t floatToHalf(float value);
+
+/// @brief Convert a 16-bit half float to a float
+float halfToFloat(uint16_t value);
+
+/// @brief Convert `count` floats to half floats
+/// @note Uses F16C instructions 8 values at a time when the CPU supports them, the scalar conversion
+/// otherwise; both round to nearest even
+void floatToHalf(const float* source, uint16_t* destination, size_t count);
+
+/// @brief Pack `count` RGB float triplets into `R11F_G11F_B10F` texels (red in the low bits)
+/// @note Negative values and NaNs become 0, since the format has no sign bit
+void packR11G11B10F(const float* rgb, uint32_t* destination, size_t count);
+
+/// @brief Whether `floatToHalf` runs on F16C instructions on this CPU
+bool hasHardwareHalfConversion();
+
+} // namespace tmig::util
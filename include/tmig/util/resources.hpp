@@ -1,6 +1,8 @@
 #pragma once
 
 #include <string>
+#include <string_view>
+#include <optional>
 
 namespace tmig::util {
 
@@ -9,4 +11,31 @@ namespace tmig::util {
 /// @note Resources should always be placed under resources/
 std::string getResourcePath(const std::string& path);
 
+/// @brief Returns a resource embedded into the library at build time
+///
+/// Everything under resources/engine/ is embedded, so engine shaders load without touching the
+/// filesystem and deployed binaries don't depend on the source tree.
+/// @param path Path relative to resources/, e.g. "engine/shaders/blur.frag"
+/// @return The embedded bytes, or `std::nullopt` if no resource was embedded under `path`
+std::optional<std::string_view> getEmbeddedResource(std::string_view path);
+
+/// @brief Sets a folder whose files take precedence over embedded resources in `readResource`
+///
+/// Meant for development, e.g. pointing at the source resources/ folder to iterate on engine shaders
+/// without rebuilding. Initialized from the `TMIG_RESOURCE_OVERRIDE` environment variable; pass an
+/// empty string to disable.
+void setResourceOverrideFolder(const std::string& folder);
+
+/// @brief Reads a resource, trying the override folder, then embedded resources, then `getResourcePath`
+/// @param path Path relative to resources/, e.g. "engine/shaders/blur.frag"
+/// @note Throws an `std::runtime_error` if the resource is not found anywhere
+std::string readResource(const std::string& path);
+
+/// @brief Returns the path of the SPIR-V binary precompiled at build time for a shader resource
+/// @param path Path relative to resources/, e.g. "engine/shaders/blur.frag"
+/// @return Path to the binary, or an empty string if the engine was built without `TMIG_COMPILE_SPIRV`,
+/// no binary exists for `path` or the override folder holds a newer copy of it
+/// @note Binaries are read from the build folder; they are not embedded like the GLSL sources
+std::string getSpirvPath(const std::string& path);
+
 } // namespace tmig::util
\ No newline at end of file
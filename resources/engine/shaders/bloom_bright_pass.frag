@@ -1,10 +1,10 @@
 #version 440 core
 out vec4 FragColor;
 
-in vec2 uv;
+layout(location = 1) in vec2 uv;
 
-uniform sampler2D scene;
-uniform float threshold = 1.0f;
+layout(location = 0) uniform sampler2D scene;
+layout(location = 1) uniform float threshold = 1.0f;
 
 void main() {
     vec4 color = texture(scene, uv);
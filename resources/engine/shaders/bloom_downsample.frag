@@ -0,0 +1,75 @@
+#version 440 core
+out vec4 FragColor;
+
+layout(location = 1) in vec2 uv;
+
+// Previous (twice as large) level, or the scene for the first downsample
+layout(location = 0) uniform sampler2D image;
+
+// First downsample: keep only the excess light, and weight samples by their brightness
+layout(location = 1) uniform bool prefilter = false;
+layout(location = 2) uniform float threshold = 1.0f;
+
+float luminance(vec3 color) {
+    return dot(color, vec3(0.2126, 0.7152, 0.0722));
+}
+
+// Karis average weight: single very bright texels would otherwise flicker as they move
+float karisWeight(vec3 color) {
+    return 1.0 / (1.0 + luminance(color));
+}
+
+void main() {
+    vec2 texel = 1.0 / vec2(textureSize(image, 0));
+
+    // 13 bilinear taps covering a 6x6 texel area (Call of Duty: Advanced Warfare):
+    // a - b - c
+    // - j - k -
+    // d - e - f
+    // - l - m -
+    // g - h - i
+    vec3 a = texture(image, uv + texel * vec2(-2.0,  2.0)).rgb;
+    vec3 b = texture(image, uv + texel * vec2( 0.0,  2.0)).rgb;
+    vec3 c = texture(image, uv + texel * vec2( 2.0,  2.0)).rgb;
+    vec3 d = texture(image, uv + texel * vec2(-2.0,  0.0)).rgb;
+    vec3 e = texture(image, uv).rgb;
+    vec3 f = texture(image, uv + texel * vec2( 2.0,  0.0)).rgb;
+    vec3 g = texture(image, uv + texel * vec2(-2.0, -2.0)).rgb;
+    vec3 h = texture(image, uv + texel * vec2( 0.0, -2.0)).rgb;
+    vec3 i = texture(image, uv + texel * vec2( 2.0, -2.0)).rgb;
+    vec3 j = texture(image, uv + texel * vec2(-1.0,  1.0)).rgb;
+    vec3 k = texture(image, uv + texel * vec2( 1.0,  1.0)).rgb;
+    vec3 l = texture(image, uv + texel * vec2(-1.0, -1.0)).rgb;
+    vec3 m = texture(image, uv + texel * vec2( 1.0, -1.0)).rgb;
+
+    // Five overlapping 2x2 boxes: the center one weighs 0.5, the corner ones 0.125 each
+    vec3 boxes[5] = vec3[](
+        (j + k + l + m) * 0.25,
+        (a + b + d + e) * 0.25,
+        (b + c + e + f) * 0.25,
+        (d + e + g + h) * 0.25,
+        (e + f + h + i) * 0.25
+    );
+    float weights[5] = float[](0.5, 0.125, 0.125, 0.125, 0.125);
+
+    vec3 color = vec3(0.0);
+    if (prefilter) {
+        float totalWeight = 0.0;
+        for (int box = 0; box < 5; box++) {
+            float weight = weights[box] * karisWeight(boxes[box]);
+            color += boxes[box] * weight;
+            totalWeight += weight;
+        }
+        color /= totalWeight;
+
+        // Excess light above the threshold, keeping the hue
+        float brightness = luminance(color);
+        color *= max(brightness - threshold, 0.0) / max(brightness, 1e-4);
+    } else {
+        for (int box = 0; box < 5; box++) {
+            color += boxes[box] * weights[box];
+        }
+    }
+
+    FragColor = vec4(color, 1.0);
+}
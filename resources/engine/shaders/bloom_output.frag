@@ -1,16 +1,16 @@
 #version 440 core
 out vec4 FragColor;
 
-in vec2 uv;
+layout(location = 1) in vec2 uv;
 
 // Original scene
-uniform sampler2D scene;
+layout(location = 0) uniform sampler2D scene;
 
 // Blurred excess (bloom)
-uniform sampler2D bloomBlur;
+layout(location = 1) uniform sampler2D bloomBlur;
 
 // Bloom strength
-uniform float strength = 1.0f;
+layout(location = 2) uniform float strength = 1.0f;
 
 void main() {
     vec4 sceneColor = texture(scene, uv);
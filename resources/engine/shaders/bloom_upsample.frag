@@ -0,0 +1,30 @@
+#version 440 core
+out vec4 FragColor;
+
+layout(location = 1) in vec2 uv;
+
+// Smaller level, blurred up and added (blending) onto the larger one being rendered
+layout(location = 0) uniform sampler2D image;
+
+// Tent radius, in texels of `image`
+layout(location = 1) uniform float radius = 1.0f;
+
+void main() {
+    vec2 offset = radius / vec2(textureSize(image, 0));
+
+    // 3x3 tent filter:
+    // 1 2 1
+    // 2 4 2 / 16
+    // 1 2 1
+    vec3 color = texture(image, uv).rgb * 4.0;
+    color += texture(image, uv + vec2(-offset.x, 0.0)).rgb * 2.0;
+    color += texture(image, uv + vec2( offset.x, 0.0)).rgb * 2.0;
+    color += texture(image, uv + vec2(0.0, -offset.y)).rgb * 2.0;
+    color += texture(image, uv + vec2(0.0,  offset.y)).rgb * 2.0;
+    color += texture(image, uv + vec2(-offset.x, -offset.y)).rgb;
+    color += texture(image, uv + vec2( offset.x, -offset.y)).rgb;
+    color += texture(image, uv + vec2(-offset.x,  offset.y)).rgb;
+    color += texture(image, uv + vec2( offset.x,  offset.y)).rgb;
+
+    FragColor = vec4(color / 16.0, 1.0);
+}
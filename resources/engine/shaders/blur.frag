@@ -1,29 +1,27 @@
 #version 440 core
 out vec4 FragColor;
 
-in vec2 uv;
+layout(location = 1) in vec2 uv;
 
-uniform sampler2D image;
-uniform bool horizontal;
-uniform float offsetScale = 1.0f;
+layout(location = 0) uniform sampler2D image;
+layout(location = 1) uniform bool horizontal;
 
-uniform float weight[5] = float[] (0.227027, 0.1945946, 0.1216216, 0.054054, 0.016216);
+// Linear-sampled kernel, set by BlurEffect (offset scale included): tap 0 is the center texel, every
+// other tap lands between two texels so that bilinear filtering weighs both of them in a single fetch
+#define MAX_TAPS 33
+layout(location = 3) uniform int tapCount = 1;
+layout(location = 4) uniform float weights[MAX_TAPS];
+layout(location = 37) uniform float offsets[MAX_TAPS];
 
-void main() {             
-    vec2 texOffset = offsetScale / textureSize(image, 0);
-    vec3 result = texture(image, uv).rgb * weight[0];
-    if (horizontal) {
-        for (int i = 1; i < 5; ++i) {
-            result += texture(image, uv + vec2(texOffset.x * i, 0.0)).rgb * weight[i];
-            result += texture(image, uv - vec2(texOffset.x * i, 0.0)).rgb * weight[i];
-        }
-    }
-    else {
-        for (int i = 1; i < 5; ++i) {
-            result += texture(image, uv + vec2(0.0, texOffset.y * i)).rgb * weight[i];
-            result += texture(image, uv - vec2(0.0, texOffset.y * i)).rgb * weight[i];
-        }
+void main() {
+    vec2 texOffset = 1.0 / vec2(textureSize(image, 0));
+    vec2 direction = horizontal ? vec2(texOffset.x, 0.0) : vec2(0.0, texOffset.y);
+
+    vec3 result = texture(image, uv).rgb * weights[0];
+    for (int i = 1; i < tapCount; ++i) {
+        result += texture(image, uv + direction * offsets[i]).rgb * weights[i];
+        result += texture(image, uv - direction * offsets[i]).rgb * weights[i];
     }
 
     FragColor = vec4(result, 1.0);
-}
\ No newline at end of file
+}
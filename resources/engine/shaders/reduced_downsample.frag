@@ -0,0 +1,45 @@
+#version 440 core
+out vec4 FragColor;
+
+layout(location = 1) in vec2 uv;
+
+// Full resolution image, reduced by `divisor` in each direction
+layout(location = 0) uniform sampler2D image;
+layout(location = 1) uniform int divisor = 2;
+
+// G-buffer images keep, in each block, the texel whose `guide` position is closest to `eye`, so depth and
+// normal stay consistent with each other and edges are not averaged into surfaces that don't exist
+layout(location = 2) uniform bool nearest = false;
+layout(location = 3) uniform sampler2D guide;
+layout(location = 4) uniform vec3 eye = vec3(0.0);
+
+void main() {
+    ivec2 size = textureSize(image, 0);
+    ivec2 first = ivec2(gl_FragCoord.xy) * divisor;
+
+    if (nearest) {
+        ivec2 best = clamp(first, ivec2(0), size - 1);
+        float bestDepth = 1e30;
+        for (int y = 0; y < divisor; y++) {
+            for (int x = 0; x < divisor; x++) {
+                ivec2 texel = clamp(first + ivec2(x, y), ivec2(0), size - 1);
+                float depth = distance(texelFetch(guide, texel, 0).xyz, eye);
+                if (depth < bestDepth) {
+                    bestDepth = depth;
+                    best = texel;
+                }
+            }
+        }
+        FragColor = texelFetch(image, best, 0);
+        return;
+    }
+
+    // Box filter
+    vec4 sum = vec4(0.0);
+    for (int y = 0; y < divisor; y++) {
+        for (int x = 0; x < divisor; x++) {
+            sum += texelFetch(image, clamp(first + ivec2(x, y), ivec2(0), size - 1), 0);
+        }
+    }
+    FragColor = sum / float(divisor * divisor);
+}
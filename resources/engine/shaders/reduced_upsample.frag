@@ -0,0 +1,82 @@
+#version 440 core
+out vec4 FragColor;
+
+layout(location = 1) in vec2 uv;
+
+// Result of the effect run at reduced resolution
+layout(location = 0) uniform sampler2D image;
+
+// Without guidance, plain bilinear filtering
+layout(location = 1) uniform bool guided = false;
+
+// Pick the closest sample in depth instead of blending
+layout(location = 2) uniform bool nearestDepth = false;
+
+// Full resolution G-buffer, and its reduced copy the effect ran with
+layout(location = 3) uniform sampler2D positions;
+layout(location = 4) uniform sampler2D lowPositions;
+layout(location = 5) uniform bool hasNormals = false;
+layout(location = 6) uniform sampler2D normals;
+layout(location = 7) uniform sampler2D lowNormals;
+layout(location = 8) uniform vec3 eye = vec3(0.0);
+
+// Bilateral weights: relative depth difference at which the weight falls to 1/e, and normal exponent
+layout(location = 9) uniform float depthSigma = 0.05;
+layout(location = 10) uniform float normalPower = 8.0;
+
+float normalWeight(vec3 n, vec3 lowN) {
+    if (dot(n, n) < 1e-8 || dot(lowN, lowN) < 1e-8) {
+        return 1.0;
+    }
+    return pow(max(dot(normalize(n), normalize(lowN)), 0.0), normalPower);
+}
+
+void main() {
+    if (!guided) {
+        FragColor = texture(image, uv);
+        return;
+    }
+
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    float depth = distance(texelFetch(positions, pixel, 0).xyz, eye);
+    vec3 normal = hasNormals ? texelFetch(normals, pixel, 0).xyz : vec3(0.0);
+
+    // The 4 reduced texels around this pixel, as bilinear filtering would pick them
+    ivec2 lowSize = textureSize(lowPositions, 0);
+    vec2 lowCoord = uv * vec2(lowSize) - 0.5;
+    ivec2 base = ivec2(floor(lowCoord));
+    vec2 f = lowCoord - vec2(base);
+
+    vec4 sum = vec4(0.0);
+    float totalWeight = 0.0;
+    vec2 nearestUv = uv;
+    float nearestDiff = 1e30;
+    for (int y = 0; y < 2; y++) {
+        for (int x = 0; x < 2; x++) {
+            ivec2 texel = clamp(base + ivec2(x, y), ivec2(0), lowSize - 1);
+            vec2 texelUv = (vec2(texel) + 0.5) / vec2(lowSize);
+            float diff = abs(distance(texelFetch(lowPositions, texel, 0).xyz, eye) - depth);
+
+            if (diff < nearestDiff) {
+                nearestDiff = diff;
+                nearestUv = texelUv;
+            }
+
+            float weight = (x == 1 ? f.x : 1.0 - f.x) * (y == 1 ? f.y : 1.0 - f.y);
+            weight *= exp(-diff / (depthSigma * max(depth, 1e-4)));
+            if (hasNormals) {
+                weight *= normalWeight(normal, texelFetch(lowNormals, texel, 0).xyz);
+            }
+
+            sum += textureLod(image, texelUv, 0.0) * weight;
+            totalWeight += weight;
+        }
+    }
+
+    // Every sample lies across an edge: fall back to the closest one in depth
+    if (nearestDepth || totalWeight < 1e-4) {
+        FragColor = textureLod(image, nearestUv, 0.0);
+        return;
+    }
+    FragColor = sum / totalWeight;
+}
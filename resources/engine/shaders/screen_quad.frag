@@ -1,9 +1,9 @@
 #version 440 core
 out vec4 FragColor;
 
-in vec2 uv;
+layout(location = 1) in vec2 uv;
 
-uniform sampler2D scene;
+layout(location = 0) uniform sampler2D scene;
 
 void main() {
     FragColor = texture(scene, uv);
@@ -2,8 +2,13 @@
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec2 aTex;
 
-out vec3 pos;
-out vec2 uv;
+// Redeclared so this stage can be linked as a separable program
+out gl_PerVertex {
+    vec4 gl_Position;
+};
+
+layout (location = 0) out vec3 pos;
+layout (location = 1) out vec2 uv;
 
 void main() {
     pos = aPos;
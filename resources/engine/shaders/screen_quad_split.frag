@@ -1,10 +1,10 @@
 #version 440 core
 out vec4 FragColor;
 
-in vec2 uv;
+layout(location = 1) in vec2 uv;
 
-uniform sampler2D scene;
-uniform sampler2D processed;
+layout(location = 0) uniform sampler2D scene;
+layout(location = 1) uniform sampler2D processed;
 
 void main() {
     if (uv.x < 0.5) {
@@ -0,0 +1,45 @@
+#version 440 core
+out vec4 FragColor;
+
+layout(location = 1) in vec2 uv;
+
+// HDR scene
+layout(location = 0) uniform sampler2D image;
+
+// 0 is Reinhard, 1 is ACES; matches ToneMapOperator
+layout(location = 1) uniform int tonemapOperator = 1;
+
+// Expose the adapted luminance to middle gray, or use a fixed exposure of 1
+layout(location = 2) uniform bool autoExposure = true;
+
+// Stops added on top of the exposure
+layout(location = 3) uniform float exposureCompensation = 0.0;
+
+// Written by luminance_average.comp, never read back by the CPU
+layout(std430, binding = 1) readonly buffer Luminance {
+    float adaptedLuminance;
+};
+
+vec3 reinhard(vec3 color) {
+    return color / (1.0 + color);
+}
+
+// Krzysztof Narkowicz, "ACES Filmic Tone Mapping Curve"
+vec3 aces(vec3 color) {
+    const float a = 2.51;
+    const float b = 0.03;
+    const float c = 2.43;
+    const float d = 0.59;
+    const float e = 0.14;
+    return clamp((color * (a * color + b)) / (color * (c * color + d) + e), 0.0, 1.0);
+}
+
+void main() {
+    vec4 color = texture(image, uv);
+
+    float exposure = autoExposure ? 0.18 / max(adaptedLuminance, 1e-4) : 1.0;
+    vec3 exposed = color.rgb * exposure * exp2(exposureCompensation);
+
+    vec3 mapped = tonemapOperator == 0 ? reinhard(exposed) : aces(exposed);
+    FragColor = vec4(mapped, color.a);
+}
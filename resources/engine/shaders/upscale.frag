@@ -0,0 +1,45 @@
+#version 440 core
+out vec4 FragColor;
+
+layout(location = 1) in vec2 uv;
+
+layout(location = 0) uniform sampler2D image;
+
+// Part of `image` holding the picture, from the bottom-left corner
+layout(location = 1) uniform vec2 region = vec2(1.0);
+
+// 0 is a plain bilinear upscale, 1 the strongest sharpening
+layout(location = 2) uniform float sharpness = 0.5;
+
+// Clamp the result to [0, 1] for normalized outputs; float outputs are only kept non-negative
+layout(location = 3) uniform bool clampToUnit = true;
+
+// Bilinear sample that never blends in texels outside the region
+vec3 fetch(vec2 p, vec2 texel) {
+    return texture(image, clamp(p, 0.5 * texel, region - 0.5 * texel)).rgb;
+}
+
+void main() {
+    vec2 texel = 1.0 / vec2(textureSize(image, 0));
+    vec2 p = uv * region;
+
+    // Center and its 4 neighbors, one source texel away
+    vec3 c = fetch(p, texel);
+    vec3 n = fetch(p + vec2(0.0, texel.y), texel);
+    vec3 s = fetch(p - vec2(0.0, texel.y), texel);
+    vec3 e = fetch(p + vec2(texel.x, 0.0), texel);
+    vec3 w = fetch(p - vec2(texel.x, 0.0), texel);
+
+    // Contrast adaptive sharpening: sharpen less where the neighborhood is already close to 0 or 1,
+    // so high contrast edges don't overshoot
+    vec3 minColor = min(c, min(min(n, s), min(e, w)));
+    vec3 maxColor = max(c, max(max(n, s), max(e, w)));
+    vec3 amount = sqrt(clamp(min(minColor, 1.0 - maxColor) / max(maxColor, vec3(1e-5)), 0.0, 1.0));
+
+    // Negative lobe weight, from 0 (no sharpening) to -1/5
+    vec3 lobe = -amount * 0.2 * sharpness;
+
+    vec3 result = (c + lobe * (n + s + e + w)) / (1.0 + 4.0 * lobe);
+    result = max(result, 0.0);
+    FragColor = vec4(clampToUnit ? min(result, 1.0) : result, 1.0);
+}
@@ -0,0 +1,51 @@
+// Virtual texture sampling functions. Not a complete shader: insert it after the #version line of
+// shaders sampling a VirtualTexture, whose setUniforms fills the uniforms below.
+
+uniform sampler2D vtPageTable;
+uniform sampler2D vtCache;
+
+// Page size and border, in texels
+uniform vec2 vtPage;
+
+// Physical cache size, in texels
+uniform vec2 vtCacheSize;
+
+// Mip bias of the feedback pass, -log2 of its downscale factor
+uniform float vtFeedbackBias;
+
+// Mip level of the virtual texture wanted at uv, from screen space derivatives
+float vtMipLevel(vec2 uv, float bias) {
+    vec2 texels = uv * vec2(textureSize(vtPageTable, 0)) * vtPage.x;
+    vec2 dx = dFdx(texels);
+    vec2 dy = dFdy(texels);
+    float level = 0.5 * log2(max(dot(dx, dx), dot(dy, dy))) + bias;
+    return clamp(level, 0.0, float(textureQueryLevels(vtPageTable) - 1));
+}
+
+// Page of the virtual texture covering uv at level
+ivec2 vtPageAt(vec2 uv, int level) {
+    ivec2 pages = textureSize(vtPageTable, level);
+    return clamp(ivec2(uv * vec2(pages)), ivec2(0), pages - 1);
+}
+
+// Sample the virtual texture; missing pages fall back to the closest resident coarser level
+vec4 vtSample(vec2 uv) {
+    int level = int(vtMipLevel(uv, 0.0));
+    vec4 entry = texelFetch(vtPageTable, vtPageAt(uv, level), level);
+
+    // Entry: cache page coordinates and the level of the page actually mapped there
+    vec2 cachePage = floor(entry.xy * 255.0 + 0.5);
+    int mappedLevel = int(entry.z * 255.0 + 0.5);
+
+    vec2 inPage = fract(uv * vec2(textureSize(vtPageTable, mappedLevel)));
+    vec2 texel = cachePage * (vtPage.x + 2.0 * vtPage.y) + vtPage.y + inPage * vtPage.x;
+    return textureLod(vtCache, texel / vtCacheSize, 0.0);
+}
+
+// Feedback pass output: the page needed at uv, encoded for VirtualTexture::endFeedback
+vec4 vtFeedback(vec2 uv) {
+    int level = int(vtMipLevel(uv, vtFeedbackBias));
+    ivec2 page = vtPageAt(uv, level);
+    int high = (page.x >> 8) | ((page.y >> 8) << 4);
+    return vec4(page.x & 255, page.y & 255, high, level) / 255.0;
+}
@@ -1,7 +1,7 @@
 #version 440
 out vec4 FragColor;
 
-in vec2 uv;
+layout(location = 1) in vec2 uv;
 
 uniform sampler2D scene;
 uniform int effect;
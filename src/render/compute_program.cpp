@@ -0,0 +1,213 @@
+#include <stdexcept>
+
+#include "glad/glad.h"
+
+#include "tmig/render/compute_program.hpp"
+#include "tmig/render/internal.hpp"
+#include "tmig/util/log.hpp"
+#include "tmig/util/file.hpp"
+#include "tmig/util/resources.hpp"
+
+namespace tmig::render {
+
+/// @brief Convert `MemoryBarrierBit`s into OpenGL barrier bits
+static GLbitfield toGL(MemoryBarrierBit barriers) {
+    const auto bits = static_cast<uint32_t>(barriers);
+    if (barriers == MemoryBarrierBit::ALL) return GL_ALL_BARRIER_BITS;
+
+    GLbitfield result = 0;
+    if (bits & static_cast<uint32_t>(MemoryBarrierBit::VERTEX_ATTRIB_ARRAY)) result |= GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT;
+    if (bits & static_cast<uint32_t>(MemoryBarrierBit::ELEMENT_ARRAY))       result |= GL_ELEMENT_ARRAY_BARRIER_BIT;
+    if (bits & static_cast<uint32_t>(MemoryBarrierBit::UNIFORM))             result |= GL_UNIFORM_BARRIER_BIT;
+    if (bits & static_cast<uint32_t>(MemoryBarrierBit::TEXTURE_FETCH))       result |= GL_TEXTURE_FETCH_BARRIER_BIT;
+    if (bits & static_cast<uint32_t>(MemoryBarrierBit::SHADER_IMAGE_ACCESS)) result |= GL_SHADER_IMAGE_ACCESS_BARRIER_BIT;
+    if (bits & static_cast<uint32_t>(MemoryBarrierBit::COMMAND))             result |= GL_COMMAND_BARRIER_BIT;
+    if (bits & static_cast<uint32_t>(MemoryBarrierBit::PIXEL_BUFFER))        result |= GL_PIXEL_BUFFER_BARRIER_BIT;
+    if (bits & static_cast<uint32_t>(MemoryBarrierBit::TEXTURE_UPDATE))      result |= GL_TEXTURE_UPDATE_BARRIER_BIT;
+    if (bits & static_cast<uint32_t>(MemoryBarrierBit::BUFFER_UPDATE))       result |= GL_BUFFER_UPDATE_BARRIER_BIT;
+    if (bits & static_cast<uint32_t>(MemoryBarrierBit::FRAMEBUFFER))         result |= GL_FRAMEBUFFER_BARRIER_BIT;
+    if (bits & static_cast<uint32_t>(MemoryBarrierBit::SHADER_STORAGE))      result |= GL_SHADER_STORAGE_BARRIER_BIT;
+    return result;
+}
+
+static GLenum toGL(ImageAccess access) {
+    switch (access) {
+    case ImageAccess::READ_ONLY:  return GL_READ_ONLY;
+    case ImageAccess::WRITE_ONLY: return GL_WRITE_ONLY;
+    case ImageAccess::READ_WRITE: return GL_READ_WRITE;
+    }
+    return GL_READ_WRITE;
+}
+
+#ifdef DEBUG
+/// @brief Whether a texture format can be bound with `glBindImageTexture`
+static bool isImageFormat(TextureFormat format) {
+    switch (format) {
+    case TextureFormat::R8:
+    case TextureFormat::RG8:
+    case TextureFormat::RGBA8:
+    case TextureFormat::R16F:
+    case TextureFormat::RG16F:
+    case TextureFormat::RGBA16F:
+    case TextureFormat::R32F:
+    case TextureFormat::RG32F:
+    case TextureFormat::RGBA32F:
+    case TextureFormat::R11F_G11F_B10F:
+        return true;
+
+    default:
+        return false;
+    }
+}
+#endif
+
+void memoryBarrier(MemoryBarrierBit barriers) {
+    glMemoryBarrier(toGL(barriers)); glCheckError();
+}
+
+bool ComputeProgram::compileFromFile(const std::string& path) {
+    std::string code;
+    try {
+        code = util::readFileContent(path);
+    } catch (const std::exception& e) {
+        util::logMessage(util::LogCategory::ENGINE, util::LogSeverity::ERROR, "%s\n", e.what());
+        return false;
+    }
+
+    return compileFromSource(code);
+}
+
+bool ComputeProgram::compileFromSource(const std::string& source) {
+    // Delete old program if any
+    release();
+
+    uint32_t shader = glCreateShader(GL_COMPUTE_SHADER);
+    const char* code = source.c_str();
+    glShaderSource(shader, 1, &code, nullptr);
+    if (!compileShaderStage(shader, "Compute Shader")) {
+        glDeleteShader(shader);
+        return false;
+    }
+
+    return linkComputeProgram(shader);
+}
+
+bool ComputeProgram::compilePrecompiled(const std::string& path, const std::vector<SpecializationConstant>& constants) {
+    // Delete old program if any
+    release();
+
+    std::string code;
+    try {
+        code = util::readResource(path);
+    } catch (const std::exception& e) {
+        util::logMessage(util::LogCategory::ENGINE, util::LogSeverity::ERROR, "%s\n", e.what());
+        return false;
+    }
+
+    std::unordered_map<std::string, int> locations;
+    uint32_t shader = loadSpirvShader(GL_COMPUTE_SHADER, path, code, constants, locations, "Compute Shader");
+    if (shader != 0) {
+        if (!linkComputeProgram(shader)) return false;
+
+        setExplicitUniformLocations(std::move(locations));
+        return true;
+    }
+
+    // Fallback: compile the GLSL source, passing specialization constants as defines
+    return compileFromSource(injectSpecializationDefines(code, constants));
+}
+
+bool ComputeProgram::linkComputeProgram(uint32_t shader) {
+    _id = glCreateProgram();
+    if (_id == 0) {
+        util::logMessage(
+            util::LogCategory::OPENGL, util::LogSeverity::ERROR,
+            "Failed to create compute program\n"
+        );
+        glDeleteShader(shader);
+        return false;
+    }
+
+    glAttachShader(_id, shader);
+    glLinkProgram(_id);
+    glDetachShader(_id, shader);
+    glDeleteShader(shader);
+
+    // Check link status
+    int linkStatus;
+    glGetProgramiv(_id, GL_LINK_STATUS, &linkStatus);
+    if (!linkStatus) {
+        char infoLog[1024];
+        glGetProgramInfoLog(_id, sizeof(infoLog), nullptr, infoLog);
+        util::logMessage(
+            util::LogCategory::SHADER, util::LogSeverity::ERROR,
+            "Compute program linking failed:\n%s\n", infoLog
+        );
+        release();
+        return false;
+    }
+
+    GLint size[3];
+    glGetProgramiv(_id, GL_COMPUTE_WORK_GROUP_SIZE, size); glCheckError();
+    _workGroupSize = glm::uvec3{
+        static_cast<uint32_t>(size[0]),
+        static_cast<uint32_t>(size[1]),
+        static_cast<uint32_t>(size[2])
+    };
+
+    _linked = true;
+    util::logMessage(
+        util::LogCategory::ENGINE, util::LogSeverity::INFO,
+        "Compute program %u linked (local size %ux%ux%u)\n",
+        _id, _workGroupSize.x, _workGroupSize.y, _workGroupSize.z
+    );
+    return true;
+}
+
+void ComputeProgram::dispatch(uint32_t x, uint32_t y, uint32_t z) const {
+    use();
+    glDispatchCompute(x, y, z); glCheckError();
+}
+
+void ComputeProgram::dispatchInvocations(uint32_t x, uint32_t y, uint32_t z) const {
+    dispatch(
+        (x + _workGroupSize.x - 1) / _workGroupSize.x,
+        (y + _workGroupSize.y - 1) / _workGroupSize.y,
+        (z + _workGroupSize.z - 1) / _workGroupSize.z
+    );
+}
+
+void ComputeProgram::dispatchIndirect(const DataBuffer<DispatchIndirectCommand>& buffer, size_t index) const {
+#ifdef DEBUG
+    if (index >= buffer.count()) {
+        throw std::runtime_error{"[ComputeProgram::dispatchIndirect] Command index out of bounds"};
+    }
+#endif
+
+    use();
+    glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, buffer.id()); glCheckError();
+    glDispatchComputeIndirect(static_cast<GLintptr>(index * sizeof(DispatchIndirectCommand))); glCheckError();
+    glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, 0); glCheckError();
+}
+
+void ComputeProgram::bindImage(uint32_t unit, const Texture2D& texture, ImageAccess access, uint32_t level) const {
+#ifdef DEBUG
+    if (!isImageFormat(texture.format())) {
+        throw std::runtime_error{"[ComputeProgram::bindImage] Texture format cannot be bound as an image"};
+    }
+#endif
+
+    glBindImageTexture(
+        unit, texture.id(), level, GL_FALSE, 0,
+        toGL(access), toInternalFormat(texture.format())
+    ); glCheckError();
+}
+
+void ComputeProgram::bindStorageRange(uint32_t binding, uint32_t buffer, size_t offset, size_t size) const {
+    glBindBufferRange(
+        GL_SHADER_STORAGE_BUFFER, binding, buffer,
+        static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size)
+    ); glCheckError();
+}
+
+} // namespace tmig::render
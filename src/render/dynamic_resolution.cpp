@@ -0,0 +1,144 @@
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+#include "glad/glad.h"
+
+#include "tmig/render/dynamic_resolution.hpp"
+#include "tmig/util/log.hpp"
+
+namespace tmig::render {
+
+/// @brief Weight of a new measurement in the smoothed frame time
+static constexpr float FRAME_TIME_SMOOTHING = 0.25f;
+
+/// @brief Fraction of the target frame time aimed for, so noise doesn't push frames over the target
+static constexpr float FRAME_TIME_HEADROOM = 0.9f;
+
+/// @brief Relative difference from the aimed frame time below which the scale is left alone
+static constexpr float FRAME_TIME_TOLERANCE = 0.05f;
+
+/// @brief Largest scale change per measurement
+static constexpr float MAX_SCALE_STEP = 0.05f;
+
+DynamicResolution::DynamicResolution(const DynamicResolutionConfig& config)
+    : _config{config},
+      _scale{config.maxScale}
+{
+#ifdef DEBUG
+    if (config.minScale <= 0.0f || config.minScale > config.maxScale) {
+        throw std::runtime_error{"[render::DynamicResolution] Invalid scale range"};
+    }
+#endif
+
+    FramebufferConfig framebufferConfig{
+        .width = config.maxWidth,
+        .height = config.maxHeight,
+        .colorAttachments = {
+            {0, FramebufferAttachment{.texture = &_texture, .format = config.format}},
+        },
+    };
+    if (config.depthFormat.has_value()) {
+        // Depth is only needed while drawing the scene
+        framebufferConfig.depthAttachment = FramebufferDepthAttachment{
+            .format = config.depthFormat.value(),
+            .renderbuffer = &_depthBuffer,
+            .transient = true,
+        };
+    }
+
+    auto status = _framebuffer.setup(framebufferConfig);
+    if (status != Framebuffer::Status::COMPLETE) {
+        std::stringstream ss;
+        ss << "[render::DynamicResolution] Failed setting up scene framebuffer: " << status;
+        throw std::runtime_error{ss.str()};
+    }
+
+    _texture.setWrapS(TextureWrapMode::CLAMP_TO_EDGE);
+    _texture.setWrapT(TextureWrapMode::CLAMP_TO_EDGE);
+
+    _renderWidth = config.maxWidth;
+    _renderHeight = config.maxHeight;
+}
+
+void DynamicResolution::beginFrame(uint32_t outputWidth, uint32_t outputHeight) {
+    if (_timer.poll()) {
+        const auto measured = static_cast<float>(_timer.milliseconds());
+        _gpuFrameTime = _gpuFrameTime == 0.0f
+            ? measured
+            : _gpuFrameTime + (measured - _gpuFrameTime) * FRAME_TIME_SMOOTHING;
+
+        if (_automatic) {
+            updateScale();
+        }
+    }
+
+    auto scaled = [this](uint32_t size, uint32_t maxSize) {
+        const auto rendered = static_cast<uint32_t>(std::lround(static_cast<float>(size) * _scale));
+        return std::clamp(rendered, 1U, maxSize);
+    };
+    _renderWidth = scaled(outputWidth, _config.maxWidth);
+    _renderHeight = scaled(outputHeight, _config.maxHeight);
+
+    _timer.begin();
+}
+
+void DynamicResolution::endFrame() {
+    _timer.end();
+}
+
+void DynamicResolution::bind(const FramebufferBindOptions& options) const {
+    _framebuffer.bind({.setViewport = false, .clearColor = false, .clearStencil = false, .clearDepth = false});
+    glViewport(0, 0, _renderWidth, _renderHeight); glCheckError();
+
+    GLbitfield clearMask = 0;
+    if (options.clearColor)   clearMask |= GL_COLOR_BUFFER_BIT;
+    if (options.clearDepth)   clearMask |= GL_DEPTH_BUFFER_BIT;
+    if (options.clearStencil) clearMask |= GL_STENCIL_BUFFER_BIT;
+
+    // Clearing the whole target would cost as much as rendering at full resolution
+    if (clearMask != 0) {
+        glEnable(GL_SCISSOR_TEST);
+        glScissor(0, 0, _renderWidth, _renderHeight);
+        glClear(clearMask);
+        glDisable(GL_SCISSOR_TEST);
+        glCheckError();
+    }
+}
+
+glm::vec2 DynamicResolution::uvScale() const {
+    return {
+        static_cast<float>(_renderWidth) / static_cast<float>(_config.maxWidth),
+        static_cast<float>(_renderHeight) / static_cast<float>(_config.maxHeight),
+    };
+}
+
+void DynamicResolution::setScale(float scale) {
+    _scale = std::clamp(scale, _config.minScale, _config.maxScale);
+}
+
+void DynamicResolution::setScaleRange(float minScale, float maxScale) {
+#ifdef DEBUG
+    if (minScale <= 0.0f || minScale > maxScale) {
+        throw std::runtime_error{"[render::DynamicResolution::setScaleRange] Invalid scale range"};
+    }
+#endif
+
+    _config.minScale = minScale;
+    _config.maxScale = maxScale;
+    setScale(_scale);
+}
+
+void DynamicResolution::updateScale() {
+    if (_gpuFrameTime <= 0.0f) return;
+
+    const float ratio = _config.targetFrameTime * FRAME_TIME_HEADROOM / _gpuFrameTime;
+    if (std::abs(ratio - 1.0f) < FRAME_TIME_TOLERANCE) return;
+
+    // Cost scales with pixel count, i.e. with the square of the scale
+    const float desired = _scale * std::sqrt(ratio);
+    setScale(std::clamp(desired, _scale - MAX_SCALE_STEP, _scale + MAX_SCALE_STEP));
+}
+
+} // namespace tmig::render
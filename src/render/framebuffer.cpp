@@ -1,4 +1,5 @@
 #include <vector>
+#include <algorithm>
 #include <unordered_set>
 #include <stdexcept>
 
@@ -49,6 +50,22 @@ static Framebuffer::Status enumToStatus(GLenum e) {
     return Framebuffer::Status::UNKNOWN;
 }
 
+/// @brief Framebuffer bound by the last `bind`, `nullptr` for the default one; used to invalidate transient
+/// attachments once another framebuffer gets bound
+static const Framebuffer* boundFramebuffer = nullptr;
+
+/// @brief The texture or renderbuffer of an attachment, `nullptr` if it has neither
+template <typename Attachment>
+static const void* storageOf(const Attachment& attachment) {
+#ifdef DEBUG
+    if (attachment.texture && attachment.renderbuffer) {
+        throw std::runtime_error{"[render::Framebuffer::setup] An attachment can't have both a texture and a renderbuffer"};
+    }
+#endif
+    if (attachment.texture) return attachment.texture;
+    return attachment.renderbuffer;
+}
+
 Framebuffer::Framebuffer() {
     glCreateFramebuffers(1, &_id);
     util::logMessage(
@@ -58,6 +75,7 @@ Framebuffer::Framebuffer() {
 }
 
 Framebuffer::~Framebuffer() {
+    if (boundFramebuffer == this) boundFramebuffer = nullptr;
     if (_id == 0) return;
 
     util::logMessage(
@@ -71,13 +89,17 @@ Framebuffer::Framebuffer(Framebuffer&& other) noexcept
     : _id{other._id},
       _width{other._width},
       _height{other._height},
+      _samples{other._samples},
       setupCalled{other.setupCalled},
       _colorAttachments{std::move(other._colorAttachments)},
       _depthAttachment{std::move(other._depthAttachment)}
 {
+    if (boundFramebuffer == &other) boundFramebuffer = this;
+
     other._id = 0;
     other._width = 0;
     other._height = 0;
+    other._samples = 1;
     other.setupCalled = false;
 }
 
@@ -87,9 +109,13 @@ Framebuffer& Framebuffer::operator=(Framebuffer&& other) noexcept {
             glDeleteFramebuffers(1, &_id);
         }
 
+        if (boundFramebuffer == this) boundFramebuffer = nullptr;
+        if (boundFramebuffer == &other) boundFramebuffer = this;
+
         _id = other._id;
         _width = other._width;
         _height = other._height;
+        _samples = other._samples;
         setupCalled = other.setupCalled;
         _colorAttachments = std::move(other._colorAttachments);
         _depthAttachment = std::move(other._depthAttachment);
@@ -97,61 +123,130 @@ Framebuffer& Framebuffer::operator=(Framebuffer&& other) noexcept {
         other._id = 0;
         other._width = 0;
         other._height = 0;
+        other._samples = 1;
         other.setupCalled = false;
     }
     return *this;
 }
 
 Framebuffer::Status Framebuffer::setup(const FramebufferConfig& config) {
-    if (config.colorAttachments.empty()) {
+    // Depth-only framebuffers (e.g. shadow maps) draw into no color buffer
+    if (config.colorAttachments.empty() && !config.depthAttachment.has_value()) {
         return Status::MISSING_ATTACHMENT;
     }
 
     // Reset state
     _width = config.width;
     _height = config.height;
+    _samples = std::max(config.samples, 1u);
     _colorAttachments.clear();
     _depthAttachment = std::nullopt;
 
-    // Keep track of used textures to avoid duplicates
-    std::unordered_set<Texture2D*> usedTextures;
-
-    // Find the highest attachment index to determine the size of draw buffers array
-    uint32_t maxIndex = 0;
-    for (auto const& [index, _] : config.colorAttachments) {
-        if (index > maxIndex) {
-            maxIndex = index;
-        }
-    }
-    std::vector<GLenum> drawBuffers(maxIndex + 1, GL_NONE);
+    // Keep track of used textures and renderbuffers to avoid duplicates
+    std::unordered_set<const void*> usedTextures;
 
     GLint maxColorAttachments = 8;
     glGetIntegerv(GL_MAX_COLOR_ATTACHMENTS, &maxColorAttachments);
 
-    // Attach draw buffers
     for (auto& [index, attachment] : config.colorAttachments) {
         // Ensure valid texture and not duplicate
-        if (!attachment.texture) return Status::NULL_ATTACHMENT;
-        if (usedTextures.count(attachment.texture)) return Status::DUPLICATE_ATTACHMENT;
+        const void* image = storageOf(attachment);
+        if (!image) return Status::NULL_ATTACHMENT;
+        if (usedTextures.count(image)) return Status::DUPLICATE_ATTACHMENT;
         if (index >= static_cast<uint32_t>(maxColorAttachments)) return Status::INVALID_COLOR_INDEX;
-        usedTextures.insert(attachment.texture);
+        usedTextures.insert(image);
+        _colorAttachments[index] = attachment;
+    }
+
+    if (config.depthAttachment.has_value()) {
+        auto& attachment = config.depthAttachment.value();
+
+        // Ensure valid texture and not duplicate
+        const void* image = storageOf(attachment);
+        if (!image) return Status::NULL_ATTACHMENT;
+        if (usedTextures.count(image)) return Status::DUPLICATE_ATTACHMENT;
+        usedTextures.insert(image);
+        _depthAttachment = attachment;
+    }
+
+    // Resize, apply formats and attach
+    allocateAttachments();
+
+    // Tell which draw buffers we will be using on this framebuffer
+    applyDrawBuffers();
+
+    // Check status
+    GLenum statusGL = glCheckNamedFramebufferStatus(_id, GL_FRAMEBUFFER);
+    auto status = enumToStatus(statusGL);
+    if (status == Status::COMPLETE) {
+        setupCalled = true;
+    }
+
+    return status;
+}
 
-        // Resize and apply format
-        attachment.texture->resize(_width, _height, attachment.format);
+/// @brief Whether `image` (a texture or a renderbuffer) already has the storage a framebuffer would allocate
+template <typename Image>
+static bool hasStorage(const Image& image, uint32_t width, uint32_t height, TextureFormat format, uint32_t samples) {
+    return image.width() == width && image.height() == height && image.format() == format && image.samples() == samples;
+}
+
+/// @brief Allocate storage for an attachment if needed and attach it at `attachPoint`
+template <typename Attachment>
+static void attach(uint32_t framebuffer, GLenum attachPoint, const Attachment& attachment, TextureFormat format,
+                   uint32_t width, uint32_t height, uint32_t samples) {
+    // Matching storage is kept, so a texture attached to several framebuffers stays valid in all of them
+    if (attachment.renderbuffer) {
+        if (!hasStorage(*attachment.renderbuffer, width, height, format, samples)) {
+            attachment.renderbuffer->resize(width, height, format, samples);
+        }
+        glNamedFramebufferRenderbuffer(framebuffer, attachPoint, GL_RENDERBUFFER, attachment.renderbuffer->id());
+        return;
+    }
+
+    if (!hasStorage(*attachment.texture, width, height, format, samples) || attachment.texture->levelCount() != 1) {
+        attachment.texture->resizeMultisample(width, height, format, samples);
+    }
+    glNamedFramebufferTexture(framebuffer, attachPoint, attachment.texture->id(), 0);
+}
 
-        // Attach to framebuffer
-        GLenum attachPoint = GL_COLOR_ATTACHMENT0 + index;
+void Framebuffer::allocateAttachments() {
+    for (auto& [index, attachment] : _colorAttachments) {
         util::logMessage(
             util::LogCategory::ENGINE, util::LogSeverity::INFO,
-            "glNamedFramebufferTexture(%u, GL_COLOR_ATTACHMENT%u, %u, 0)\n", _id, index, attachment.texture->id()
+            "%s(%u, GL_COLOR_ATTACHMENT%u, %u)\n",
+            attachment.renderbuffer ? "glNamedFramebufferRenderbuffer" : "glNamedFramebufferTexture", _id, index,
+            attachment.renderbuffer ? attachment.renderbuffer->id() : attachment.texture->id()
         );
-        glNamedFramebufferTexture(_id, attachPoint, attachment.texture->id(), 0);
-        drawBuffers[index] = attachPoint;
-        _colorAttachments[index] = attachment;
+        attach(_id, GL_COLOR_ATTACHMENT0 + index, attachment, attachment.format, _width, _height, _samples);
     }
 
-    // Tell which draw buffers we will be using on this framebuffer
-    if (!drawBuffers.empty()) {
+    if (_depthAttachment.has_value()) {
+        auto& attachment = _depthAttachment.value();
+        attach(
+            _id,
+            depthFormatToAttachmentPoint(attachment.format),
+            attachment,
+            depthFormatToTextureFormat(attachment.format),
+            _width, _height, _samples
+        );
+    }
+}
+
+void Framebuffer::applyDrawBuffers() const {
+    // Find the highest attachment index to determine the size of draw buffers array
+    uint32_t maxIndex = 0;
+    for (auto const& [index, _] : _colorAttachments) {
+        if (index > maxIndex) {
+            maxIndex = index;
+        }
+    }
+    std::vector<GLenum> drawBuffers(maxIndex + 1, GL_NONE);
+    for (auto const& [index, _] : _colorAttachments) {
+        drawBuffers[index] = GL_COLOR_ATTACHMENT0 + index;
+    }
+
+    if (!_colorAttachments.empty()) {
         util::logMessage(
             util::LogCategory::ENGINE, util::LogSeverity::INFO,
             "glNamedFramebufferDrawBuffers(%u, %zu, %p)\n", _id, drawBuffers.size(), drawBuffers.data()
@@ -164,33 +259,6 @@ Framebuffer::Status Framebuffer::setup(const FramebufferConfig& config) {
         );
         glNamedFramebufferDrawBuffer(_id, GL_NONE);
     }
-
-    // Attach depth buffer if given
-    if (config.depthAttachment.has_value()) {
-        auto& attachment = config.depthAttachment.value();
-
-        // Ensure valid texture and not duplicate
-        if (!attachment.texture) return Status::NULL_ATTACHMENT;
-        if (usedTextures.count(attachment.texture)) return Status::DUPLICATE_ATTACHMENT;
-        usedTextures.insert(attachment.texture);
-
-        // Resize and apply format
-        attachment.texture->resize(_width, _height, depthFormatToTextureFormat(attachment.format));
-
-        // Attach to framebuffer
-        GLenum attachPoint = depthFormatToAttachmentPoint(attachment.format);
-        glNamedFramebufferTexture(_id, attachPoint, attachment.texture->id(), 0);
-        _depthAttachment = attachment;
-    }
-
-    // Check status
-    GLenum statusGL = glCheckNamedFramebufferStatus(_id, GL_FRAMEBUFFER);
-    auto status = enumToStatus(statusGL);
-    if (status == Status::COMPLETE) {
-        setupCalled = true;
-    }
-
-    return status;
 }
 
 void Framebuffer::bind(const FramebufferBindOptions& options) const {
@@ -200,6 +268,11 @@ void Framebuffer::bind(const FramebufferBindOptions& options) const {
     }
 #endif
 
+    if (boundFramebuffer && boundFramebuffer != this) {
+        boundFramebuffer->invalidateTransient();
+    }
+    boundFramebuffer = this;
+
     glBindFramebuffer(GL_FRAMEBUFFER, _id);
 
     if (options.setViewport) {
@@ -217,6 +290,11 @@ void Framebuffer::bind(const FramebufferBindOptions& options) const {
 }
 
 void Framebuffer::bindDefault(uint32_t width, uint32_t height, const FramebufferBindOptions& options) {
+    if (boundFramebuffer) {
+        boundFramebuffer->invalidateTransient();
+        boundFramebuffer = nullptr;
+    }
+
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
     if (options.setViewport) {
@@ -241,21 +319,94 @@ void Framebuffer::resize(uint32_t width, uint32_t height) {
     _width = width;
     _height = height;
 
-    for (auto& [index, attachment] : _colorAttachments) {
-        attachment.texture->resize(width, height, attachment.format);
-        glNamedFramebufferTexture(_id, GL_COLOR_ATTACHMENT0 + index, attachment.texture->id(), 0);
+    allocateAttachments();
+}
+
+void Framebuffer::resolveTo(Framebuffer& target, bool includeDepth) const {
+    const bool multisampled = _samples > 1 || target._samples > 1;
+
+#ifdef DEBUG
+    if (!setupCalled || !target.setupCalled) {
+        throw std::runtime_error{"[render::Framebuffer::resolveTo] Tried to resolve framebuffer not set up"};
     }
 
-    if (_depthAttachment.has_value()) {
-        auto& attachment = _depthAttachment.value();
-        attachment.texture->resize(width, height, depthFormatToTextureFormat(attachment.format));
-        glNamedFramebufferTexture(
-            _id,
-            depthFormatToAttachmentPoint(attachment.format),
-            attachment.texture->id(),
-            0
-        );
+    if (multisampled && (_width != target._width || _height != target._height)) {
+        throw std::runtime_error{"[render::Framebuffer::resolveTo] Multisampled framebuffers must resolve to the same size"};
+    }
+
+    if (_samples > 1 && target._samples > 1 && _samples != target._samples) {
+        throw std::runtime_error{"[render::Framebuffer::resolveTo] Sample counts differ"};
+    }
+
+    if (includeDepth && (!_depthAttachment || !target._depthAttachment ||
+        _depthAttachment->format != target._depthAttachment->format)) {
+        throw std::runtime_error{"[render::Framebuffer::resolveTo] Depth attachments are missing or differ in format"};
+    }
+#endif
+
+    // Multisample resolves need equal sizes and nearest filtering; plain copies may scale
+    const GLenum filter = multisampled || (_width == target._width && _height == target._height)
+        ? GL_NEAREST : GL_LINEAR;
+
+    // A blit writes every draw buffer of the target from the single read buffer, so go one index at a time
+    bool changedDrawBuffers = false;
+    for (auto const& [index, _] : _colorAttachments) {
+        if (!target._colorAttachments.count(index)) continue;
+
+        glNamedFramebufferReadBuffer(_id, GL_COLOR_ATTACHMENT0 + index); glCheckError();
+        glNamedFramebufferDrawBuffer(target._id, GL_COLOR_ATTACHMENT0 + index); glCheckError();
+        changedDrawBuffers = true;
+
+        glBlitNamedFramebuffer(
+            _id, target._id,
+            0, 0, _width, _height,
+            0, 0, target._width, target._height,
+            GL_COLOR_BUFFER_BIT, filter
+        ); glCheckError();
+    }
+
+    if (changedDrawBuffers) {
+        target.applyDrawBuffers();
+    }
+
+    if (includeDepth && _depthAttachment && target._depthAttachment) {
+        GLbitfield mask = GL_DEPTH_BUFFER_BIT;
+        if (depthFormatToAttachmentPoint(_depthAttachment->format) == GL_DEPTH_STENCIL_ATTACHMENT) {
+            mask |= GL_STENCIL_BUFFER_BIT;
+        }
+
+        glBlitNamedFramebuffer(
+            _id, target._id,
+            0, 0, _width, _height,
+            0, 0, target._width, target._height,
+            mask, GL_NEAREST
+        ); glCheckError();
+    }
+
+    // Multisampled content usually only exists to be resolved
+    invalidateTransient();
+}
+
+void Framebuffer::invalidate(const std::vector<uint32_t>& colorIndices, bool depth) const {
+    std::vector<GLenum> attachments;
+    attachments.reserve(colorIndices.size() + 1);
+    for (uint32_t index : colorIndices) {
+        attachments.push_back(GL_COLOR_ATTACHMENT0 + index);
+    }
+    if (depth && _depthAttachment.has_value()) {
+        attachments.push_back(depthFormatToAttachmentPoint(_depthAttachment->format));
+    }
+
+    if (attachments.empty()) return;
+    glInvalidateNamedFramebufferData(_id, static_cast<GLsizei>(attachments.size()), attachments.data()); glCheckError();
+}
+
+void Framebuffer::invalidateTransient() const {
+    std::vector<uint32_t> colorIndices;
+    for (auto const& [index, attachment] : _colorAttachments) {
+        if (attachment.transient) colorIndices.push_back(index);
     }
+    invalidate(colorIndices, _depthAttachment.has_value() && _depthAttachment->transient);
 }
 
-} // namespace tmig::render
\ No newline at end of file
+} // namespace tmig::render
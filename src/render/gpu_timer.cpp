@@ -0,0 +1,111 @@
+#include <stdexcept>
+
+#include "glad/glad.h"
+
+#include "tmig/render/gpu_timer.hpp"
+#include "tmig/util/log.hpp"
+
+namespace tmig::render {
+
+GpuTimer::GpuTimer() {
+    glCreateQueries(GL_TIME_ELAPSED, QUERY_COUNT, _queries.data()); glCheckError();
+    util::logMessage(
+        util::LogCategory::ENGINE, util::LogSeverity::INFO,
+        "Created GpuTimer: %u queries from %u\n", QUERY_COUNT, _queries[0]
+    );
+}
+
+GpuTimer::~GpuTimer() {
+    if (_queries[0] == 0) return;
+
+    util::logMessage(
+        util::LogCategory::ENGINE, util::LogSeverity::INFO,
+        "Deleting GpuTimer: %u queries from %u\n", QUERY_COUNT, _queries[0]
+    );
+    glDeleteQueries(QUERY_COUNT, _queries.data()); glCheckError();
+}
+
+GpuTimer::GpuTimer(GpuTimer&& other) noexcept
+    : _queries{other._queries},
+      _oldest{other._oldest},
+      _pending{other._pending},
+      _running{other._running},
+      _hasResult{other._hasResult},
+      _lastNanoseconds{other._lastNanoseconds}
+{
+    other._queries.fill(0);
+    other._pending = 0;
+    other._running = false;
+    other._hasResult = false;
+}
+
+GpuTimer& GpuTimer::operator=(GpuTimer&& other) noexcept {
+    if (this != &other) {
+        if (_queries[0] != 0) {
+            glDeleteQueries(QUERY_COUNT, _queries.data());
+        }
+
+        _queries = other._queries;
+        _oldest = other._oldest;
+        _pending = other._pending;
+        _running = other._running;
+        _hasResult = other._hasResult;
+        _lastNanoseconds = other._lastNanoseconds;
+
+        other._queries.fill(0);
+        other._pending = 0;
+        other._running = false;
+        other._hasResult = false;
+    }
+    return *this;
+}
+
+void GpuTimer::begin() {
+#ifdef DEBUG
+    if (_running) {
+        throw std::runtime_error{"[render::GpuTimer::begin] Timer is already running"};
+    }
+#endif
+
+    poll();
+
+    // The GPU is more than QUERY_COUNT measurements behind; skip this one rather than wait
+    if (_pending == QUERY_COUNT) return;
+
+    glBeginQuery(GL_TIME_ELAPSED, _queries[(_oldest + _pending) % QUERY_COUNT]); glCheckError();
+    _running = true;
+}
+
+void GpuTimer::end() {
+    if (!_running) return;
+
+    glEndQuery(GL_TIME_ELAPSED); glCheckError();
+    _pending++;
+    _running = false;
+}
+
+bool GpuTimer::poll() {
+    bool updated = false;
+
+    // Queries finish in order, so stop at the first one still in flight
+    while (_pending > 0) {
+        const uint32_t query = _queries[_oldest];
+
+        GLint available = GL_FALSE;
+        glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available); glCheckError();
+        if (!available) break;
+
+        GLuint64 nanoseconds = 0;
+        glGetQueryObjectui64v(query, GL_QUERY_RESULT, &nanoseconds); glCheckError();
+        _lastNanoseconds = nanoseconds;
+        _hasResult = true;
+        updated = true;
+
+        _oldest = (_oldest + 1) % QUERY_COUNT;
+        _pending--;
+    }
+
+    return updated;
+}
+
+} // namespace tmig::render
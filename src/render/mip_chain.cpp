@@ -0,0 +1,278 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+
+#include "glad/glad.h"
+
+#include "tmig/render/mip_chain.hpp"
+#include "tmig/util/log.hpp"
+
+namespace tmig::render {
+
+namespace {
+
+/// @brief Resolution of the linear to sRGB lookup table
+constexpr uint32_t LINEAR_TO_SRGB_STEPS = 4096;
+
+const std::array<float, 256>& srgbToLinearTable() {
+    static const auto table = [] {
+        std::array<float, 256> t;
+        for (uint32_t i = 0; i < 256; i++) {
+            const float c = static_cast<float>(i) / 255.0f;
+            t[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+        }
+        return t;
+    }();
+    return table;
+}
+
+const std::array<uint8_t, LINEAR_TO_SRGB_STEPS>& linearToSrgbTable() {
+    static const auto table = [] {
+        std::array<uint8_t, LINEAR_TO_SRGB_STEPS> t;
+        for (uint32_t i = 0; i < LINEAR_TO_SRGB_STEPS; i++) {
+            const float l = static_cast<float>(i) / (LINEAR_TO_SRGB_STEPS - 1);
+            const float c = l <= 0.0031308f ? l * 12.92f : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+            t[i] = static_cast<uint8_t>(std::clamp(c, 0.0f, 1.0f) * 255.0f + 0.5f);
+        }
+        return t;
+    }();
+    return table;
+}
+
+/// @brief Zeroth order modified Bessel function of the first kind, for the Kaiser window
+float besselI0(float x) {
+    float sum = 1.0f;
+    float term = 1.0f;
+    for (int k = 1; k < 16; k++) {
+        term *= (x / (2.0f * k)) * (x / (2.0f * k));
+        sum += term;
+    }
+    return sum;
+}
+
+/// @brief Kaiser-windowed sinc weights for source taps 0.5 and 1.5 pixels away from a destination
+/// texel center, normalized so the four taps sum to 1
+std::array<float, 2> kaiserWeights() {
+    constexpr float PI = 3.14159265358979f;
+    constexpr float RADIUS = 2.0f; // in source pixels
+    constexpr float BETA = 4.0f;
+
+    std::array<float, 2> weights;
+    for (int i = 0; i < 2; i++) {
+        const float d = 0.5f + i;
+        const float t = d * 0.5f; // distance in destination pixels
+        const float sinc = std::sin(PI * t) / (PI * t);
+        const float r = d / RADIUS;
+        const float window = besselI0(BETA * std::sqrt(1.0f - r * r)) / besselI0(BETA);
+        weights[i] = sinc * window;
+    }
+
+    const float sum = 2.0f * (weights[0] + weights[1]);
+    weights[0] /= sum;
+    weights[1] /= sum;
+    return weights;
+}
+
+/// @brief Run `fn(begin, end)` over `[0, rows)` split across threads
+template<typename F>
+void parallelRows(uint32_t rows, uint32_t threadCount, F&& fn) {
+    // Small levels aren't worth a thread spawn
+    const uint32_t threads = std::min(threadCount, std::max(rows / 32, 1u));
+    if (threads <= 1) {
+        fn(0u, rows);
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    const uint32_t chunk = (rows + threads - 1) / threads;
+    for (uint32_t begin = 0; begin < rows; begin += chunk) {
+        workers.emplace_back(fn, begin, std::min(begin + chunk, rows));
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+/// @brief 2x2 box downsample of a linear float image. Odd edges reuse their last row/column
+void downsampleBox(
+    const std::vector<float>& src, uint32_t srcW, uint32_t srcH,
+    std::vector<float>& dst, uint32_t dstW, uint32_t dstH,
+    uint32_t channels, uint32_t threadCount
+) {
+    parallelRows(dstH, threadCount, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t y = begin; y < end; y++) {
+            const float* row0 = &src[static_cast<size_t>(std::min(2 * y, srcH - 1)) * srcW * channels];
+            const float* row1 = &src[static_cast<size_t>(std::min(2 * y + 1, srcH - 1)) * srcW * channels];
+            float* out = &dst[static_cast<size_t>(y) * dstW * channels];
+
+            for (uint32_t x = 0; x < dstW; x++) {
+                const size_t x0 = static_cast<size_t>(std::min(2 * x, srcW - 1)) * channels;
+                const size_t x1 = static_cast<size_t>(std::min(2 * x + 1, srcW - 1)) * channels;
+                for (uint32_t c = 0; c < channels; c++) {
+                    out[x * channels + c] = 0.25f * (row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c]);
+                }
+            }
+        }
+    });
+}
+
+/// @brief Separable 4x4 Kaiser downsample of a linear float image
+void downsampleKaiser(
+    const std::vector<float>& src, uint32_t srcW, uint32_t srcH,
+    std::vector<float>& dst, uint32_t dstW, uint32_t dstH,
+    uint32_t channels, uint32_t threadCount
+) {
+    static const auto weights = kaiserWeights();
+    const float taps[4] = {weights[1], weights[0], weights[0], weights[1]};
+
+    // Horizontal pass into a dstW x srcH buffer
+    std::vector<float> horizontal(static_cast<size_t>(dstW) * srcH * channels);
+    parallelRows(srcH, threadCount, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t y = begin; y < end; y++) {
+            const float* in = &src[static_cast<size_t>(y) * srcW * channels];
+            float* out = &horizontal[static_cast<size_t>(y) * dstW * channels];
+
+            for (uint32_t x = 0; x < dstW; x++) {
+                for (uint32_t c = 0; c < channels; c++) {
+                    float sum = 0.0f;
+                    for (int t = 0; t < 4; t++) {
+                        const int sx = std::clamp(static_cast<int>(2 * x) - 1 + t, 0, static_cast<int>(srcW) - 1);
+                        sum += taps[t] * in[sx * channels + c];
+                    }
+                    out[x * channels + c] = sum;
+                }
+            }
+        }
+    });
+
+    // Vertical pass; whole rows are weighted at once so the inner loop vectorizes
+    const size_t rowSize = static_cast<size_t>(dstW) * channels;
+    parallelRows(dstH, threadCount, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t y = begin; y < end; y++) {
+            float* out = &dst[y * rowSize];
+            std::fill(out, out + rowSize, 0.0f);
+
+            for (int t = 0; t < 4; t++) {
+                const int sy = std::clamp(static_cast<int>(2 * y) - 1 + t, 0, static_cast<int>(srcH) - 1);
+                const float* in = &horizontal[sy * rowSize];
+                for (size_t i = 0; i < rowSize; i++) {
+                    out[i] += taps[t] * in[i];
+                }
+            }
+
+            // Negative lobes can ring past the valid range
+            for (size_t i = 0; i < rowSize; i++) {
+                out[i] = std::clamp(out[i], 0.0f, 1.0f);
+            }
+        }
+    });
+}
+
+TextureFormat sourceFormatFor(uint32_t channels) {
+    switch (channels) {
+        case 1:  return TextureFormat::R8;
+        case 2:  return TextureFormat::RG8;
+        case 3:  return TextureFormat::RGB8;
+        default: return TextureFormat::RGBA8;
+    }
+}
+
+} // namespace
+
+MipChain MipChain::build(
+    const uint8_t* pixels,
+    uint32_t width,
+    uint32_t height,
+    uint32_t channels,
+    const MipChainOptions& options
+) {
+    if (channels < 1 || channels > 4 || width == 0 || height == 0) {
+        throw std::runtime_error{"[MipChain::build] Invalid image dimensions or channel count"};
+    }
+
+    const uint32_t threadCount = options.threadCount != 0
+        ? options.threadCount
+        : std::max(std::thread::hardware_concurrency(), 1u);
+    const auto& toLinear = srgbToLinearTable();
+    const auto& toSrgb = linearToSrgbTable();
+    // Only RGB(A) images are stored as sRGB (see `allocate`); gray and gray-alpha channels stay linear
+    auto isSrgbChannel = [&](uint32_t c) { return options.srgb && channels >= 3 && c < 3; };
+
+    MipChain chain;
+    chain._channels = channels;
+    chain._levels.reserve(mipLevelCount(width, height));
+
+    MipLevel base;
+    base.width = width;
+    base.height = height;
+    base.pixels.assign(pixels, pixels + static_cast<size_t>(width) * height * channels);
+    chain._levels.push_back(std::move(base));
+
+    // Linear float copy of the base level
+    std::vector<float> current(static_cast<size_t>(width) * height * channels);
+    for (size_t i = 0; i < current.size(); i++) {
+        const uint32_t c = static_cast<uint32_t>(i % channels);
+        current[i] = isSrgbChannel(c) ? toLinear[pixels[i]] : pixels[i] / 255.0f;
+    }
+
+    std::vector<float> next;
+    uint32_t w = width;
+    uint32_t h = height;
+    while (w > 1 || h > 1) {
+        const uint32_t nw = std::max(w / 2, 1u);
+        const uint32_t nh = std::max(h / 2, 1u);
+        next.resize(static_cast<size_t>(nw) * nh * channels);
+
+        if (options.filter == MipFilter::KAISER) {
+            downsampleKaiser(current, w, h, next, nw, nh, channels, threadCount);
+        } else {
+            downsampleBox(current, w, h, next, nw, nh, channels, threadCount);
+        }
+
+        MipLevel level;
+        level.width = nw;
+        level.height = nh;
+        level.pixels.resize(next.size());
+        for (size_t i = 0; i < next.size(); i++) {
+            const uint32_t c = static_cast<uint32_t>(i % channels);
+            level.pixels[i] = isSrgbChannel(c)
+                ? toSrgb[static_cast<size_t>(next[i] * (LINEAR_TO_SRGB_STEPS - 1) + 0.5f)]
+                : static_cast<uint8_t>(next[i] * 255.0f + 0.5f);
+        }
+        chain._levels.push_back(std::move(level));
+
+        std::swap(current, next);
+        w = nw;
+        h = nh;
+    }
+
+    return chain;
+}
+
+void MipChain::allocate(Texture2D& texture, bool srgb) const {
+    TextureFormat format = sourceFormatFor(_channels);
+    if (srgb && format == TextureFormat::RGB8) format = TextureFormat::SRGB8;
+    if (srgb && format == TextureFormat::RGBA8) format = TextureFormat::SRGBA8;
+
+    texture.resize(_levels[0].width, _levels[0].height, format, static_cast<uint32_t>(_levels.size()));
+}
+
+void MipChain::uploadLevel(Texture2D& texture, uint32_t level) const {
+    // Levels are tightly packed, which breaks the default 4-byte row alignment
+    GLint previousAlignment = 4;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &previousAlignment);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    texture.setData(_levels[level].pixels.data(), sourceFormatFor(_channels), level);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, previousAlignment);
+}
+
+void MipChain::upload(Texture2D& texture, bool srgb) const {
+    allocate(texture, srgb);
+    for (uint32_t level = 0; level < _levels.size(); level++) {
+        uploadLevel(texture, level);
+    }
+}
+
+} // namespace tmig::render
\ No newline at end of file
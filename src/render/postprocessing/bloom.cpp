@@ -1,16 +1,20 @@
 #include <iostream>
-#include <sstream>
+#include <algorithm>
 #include <stdexcept>
 
 #include "glad/glad.h"
 
 #include "tmig/render/postprocessing/bloom.hpp"
 #include "tmig/util/shapes.hpp"
-#include "tmig/util/resources.hpp"
+#include "tmig/util/log.hpp"
 
 namespace tmig::render::postprocessing {
 
-BloomEffect::BloomEffect(const BloomConfig& config) : blurEffect{{.width = config.blurWidth, .height = config.blurHeight}} {
+BloomEffect::BloomEffect(const BloomConfig& _config)
+    : config{_config},
+      pool{_config.pool ? _config.pool : getSharedRenderTargetPool()},
+      blurEffect{{.width = _config.blurWidth, .height = _config.blurHeight, .pool = pool}}
+{
     // Setup screen quad
     {
         std::vector<quadVert> vertices;
@@ -36,67 +40,65 @@ BloomEffect::BloomEffect(const BloomConfig& config) : blurEffect{{.width = confi
 
     // Setup shaders
     {
-        if (!brightPassShader.compileFromFiles(
-            util::getResourcePath("engine/shaders/screen_quad.vert"),
-            util::getResourcePath("engine/shaders/bloom_bright_pass.frag")
+        screenQuadStage = getSharedStage(
+            ShaderStage::VERTEX,
+            "engine/shaders/screen_quad.vert"
+        );
+        if (!screenQuadStage) {
+            throw std::runtime_error{
+                "[render::postprocessing::BloomEffect] Failed loading screen_quad shader"
+            };
+        }
+
+        if (!brightPassShader.compileStagePrecompiled(
+            ShaderStage::FRAGMENT,
+            "engine/shaders/bloom_bright_pass.frag"
         )) {
             throw std::runtime_error{
                 "[render::postprocessing::BloomEffect] Failed loading bright_pass shader"
             };
         }
 
-        if (!outputShader.compileFromFiles(
-            util::getResourcePath("engine/shaders/screen_quad.vert"),
-            util::getResourcePath("engine/shaders/bloom_output.frag")
+        if (!outputShader.compileStagePrecompiled(
+            ShaderStage::FRAGMENT,
+            "engine/shaders/bloom_output.frag"
         )) {
             throw std::runtime_error{
                 "[render::postprocessing::BloomEffect] Failed loading bloom_output shader"
             };
         }
-    }
 
-    // Setup bright-pass part
-    {
-        brightPassTexture.setWrapS(render::TextureWrapMode::CLAMP_TO_EDGE);
-        brightPassTexture.setWrapT(render::TextureWrapMode::CLAMP_TO_EDGE);
-        auto status = brightPassFramebuffer.setup({
-            .width = config.brightPassWidth,
-            .height = config.brightPassHeight,
-            .colorAttachments = {
-                {0, render::FramebufferAttachment{
-                    .texture = &brightPassTexture,
-                    .format = render::TextureFormat::RGBA32F,
-                }},
-            },
-        });
-        if (status != render::Framebuffer::Status::COMPLETE) {
-            std::stringstream ss;
-            ss << "[render::postprocessing::BloomEffect] Failed setting up bright_pass framebuffer: " << status;
-            throw std::runtime_error{ss.str()};
+        if (!downsampleShader.compileStagePrecompiled(
+            ShaderStage::FRAGMENT,
+            "engine/shaders/bloom_downsample.frag"
+        )) {
+            throw std::runtime_error{
+                "[render::postprocessing::BloomEffect] Failed loading bloom_downsample shader"
+            };
         }
-    }
 
-    // Setup output framebuffer
-    {
-        auto status = outputFramebuffer.setup({
-            .width = config.outputWidth,
-            .height = config.outputHeight,
-            .colorAttachments = {
-                {0, render::FramebufferAttachment{
-                    .texture = &outputTexture,
-                    .format = render::TextureFormat::RGBA8,
-                }},
-            },
-        });
-        if (status != render::Framebuffer::Status::COMPLETE) {
-            std::stringstream ss;
-            ss << "[render::postprocessing::BloomEffect] Failed setting up output framebuffer: " << status;
-            throw std::runtime_error{ss.str()};
+        if (!upsampleShader.compileStagePrecompiled(
+            ShaderStage::FRAGMENT,
+            "engine/shaders/bloom_upsample.frag"
+        )) {
+            throw std::runtime_error{
+                "[render::postprocessing::BloomEffect] Failed loading bloom_upsample shader"
+            };
         }
+
+        brightPassPipeline.setStage(*screenQuadStage);
+        brightPassPipeline.setStage(brightPassShader);
+        outputPipeline.setStage(*screenQuadStage);
+        outputPipeline.setStage(outputShader);
+        downsamplePipeline.setStage(*screenQuadStage);
+        downsamplePipeline.setStage(downsampleShader);
+        upsamplePipeline.setStage(*screenQuadStage);
+        upsamplePipeline.setStage(upsampleShader);
     }
 
     setThreshold(threshold);
     setStrength(strength);
+    setOffsetScale(getOffsetScale());
 }
 
 BloomEffect::~BloomEffect() {
@@ -107,10 +109,12 @@ BloomEffect::~BloomEffect() {
 void BloomEffect::setThreshold(float _threshold) {
     threshold = _threshold;
     brightPassShader.setFloat("threshold", threshold);
+    downsampleShader.setFloat("threshold", threshold);
 }
 
 void BloomEffect::setOffsetScale(float _offsetScale) {
     blurEffect.setOffsetScale(_offsetScale);
+    upsampleShader.setFloat("radius", _offsetScale);
 }
 
 void BloomEffect::setStrength(float _strength) {
@@ -121,28 +125,107 @@ void BloomEffect::setStrength(float _strength) {
 const Texture2D& BloomEffect::apply(const Texture2D& input, const PostProcessContext& ctx) {
     (void)ctx;
 
+    output.release();
+
+    // Levels of the progressive chain, held until composited
+    std::vector<RenderTargetPool::Handle> levels;
+    const Texture2D* bloomTexture = nullptr;
+    float bloomStrength = strength;
+    if (config.mode == BloomMode::PROGRESSIVE) {
+        progressiveBloom(input, levels);
+        bloomTexture = &levels[0].texture();
+
+        // Every level was added up into the first one
+        bloomStrength /= static_cast<float>(levels.size());
+    } else {
+        bloomTexture = &gaussianBloom(input);
+    }
+
+    // Final output
+    output = pool->acquire({
+        .width = config.outputWidth,
+        .height = config.outputHeight,
+        .format = config.outputFormat,
+    });
+    output.framebuffer().bind();
+    outputPipeline.use();
+    outputShader.setFloat("strength", bloomStrength);
+    outputShader.setTexture("scene", input, 0);
+    outputShader.setTexture("bloomBlur", *bloomTexture, 1);
+
+    glDisable(GL_DEPTH_TEST);
+    screenQuad.render();
+    glEnable(GL_DEPTH_TEST);
+
+    blurEffect.releaseOutput();
+    return output.texture();
+}
+
+const Texture2D& BloomEffect::gaussianBloom(const Texture2D& input) {
     // Bright pass (get excess light in a separate texture)
-    brightPassFramebuffer.bind();
-    brightPassShader.use();
+    auto brightPass = pool->acquire({
+        .width = config.brightPassWidth,
+        .height = config.brightPassHeight,
+        .format = TextureFormat::RGBA32F,
+    });
+    brightPass.framebuffer().bind();
+    brightPassPipeline.use();
     brightPassShader.setTexture("scene", input, 0);
     glDisable(GL_DEPTH_TEST);
     screenQuad.render();
     glEnable(GL_DEPTH_TEST);
 
     // Blur bright areas
-    const auto& blurTexture = blurEffect.apply(brightPassTexture);
-
-    // Final output
-    outputFramebuffer.bind();
-    outputShader.use();
-    outputShader.setTexture("scene", input, 0);
-    outputShader.setTexture("bloomBlur", blurTexture, 1);
+    return blurEffect.apply(brightPass.texture());
+}
 
+void BloomEffect::progressiveBloom(const Texture2D& input, std::vector<RenderTargetPool::Handle>& levels) {
     glDisable(GL_DEPTH_TEST);
-    screenQuad.render();
-    glEnable(GL_DEPTH_TEST);
 
-    return outputTexture;
+    // Downsample chain; the first pass also extracts the excess light
+    downsamplePipeline.use();
+    uint32_t width = input.width();
+    uint32_t height = input.height();
+    const Texture2D* source = &input;
+    for (uint32_t level = 0; level < std::max(config.mipCount, 1U); level++) {
+        width = std::max(width / 2, 1U);
+        height = std::max(height / 2, 1U);
+        if (level > 0 && (width < 2 || height < 2)) break;
+
+        levels.push_back(pool->acquire({
+            .width = width,
+            .height = height,
+            .format = TextureFormat::R11F_G11F_B10F,
+        }));
+        levels.back().framebuffer().bind({ .clearColor = false, .clearStencil = false, .clearDepth = false });
+        downsampleShader.setBool("prefilter", level == 0);
+        downsampleShader.setTexture("image", *source, 0);
+        screenQuad.render();
+
+        source = &levels.back().texture();
+    }
+
+    // Upsample chain: each level is blurred up and added onto the next larger one
+    GLint blendSource = GL_ONE;
+    GLint blendDestination = GL_ZERO;
+    const GLboolean blendEnabled = glIsEnabled(GL_BLEND);
+    glGetIntegerv(GL_BLEND_SRC_RGB, &blendSource);
+    glGetIntegerv(GL_BLEND_DST_RGB, &blendDestination);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE);
+
+    upsamplePipeline.use();
+    for (size_t level = levels.size() - 1; level > 0; level--) {
+        levels[level - 1].framebuffer().bind({ .clearColor = false, .clearStencil = false, .clearDepth = false });
+        upsampleShader.setTexture("image", levels[level].texture(), 0);
+        screenQuad.render();
+        levels[level].release();
+    }
+
+    glBlendFunc(blendSource, blendDestination);
+    if (!blendEnabled) glDisable(GL_BLEND);
+    glEnable(GL_DEPTH_TEST);
+    glCheckError();
 }
 
 } // namespace tmig::render::postprocessing
@@ -1,15 +1,24 @@
+#include <cmath>
+#include <algorithm>
 #include <stdexcept>
-#include <sstream>
+#include <vector>
 
 #include "glad/glad.h"
 
 #include "tmig/render/postprocessing/blur.hpp"
-#include "tmig/util/resources.hpp"
 #include "tmig/util/shapes.hpp"
 
 namespace tmig::render::postprocessing {
 
-BlurEffect::BlurEffect(const BlurConfig& config) {
+/// @brief Compute passes handle a row (or column) segment this long per work group; matches `blur.comp`
+static constexpr uint32_t COMPUTE_TILE_SIZE = 128;
+
+BlurEffect::BlurEffect(const BlurConfig& config)
+    : width{config.width},
+      height{config.height},
+      method{config.method},
+      pool{config.pool ? config.pool : getSharedRenderTargetPool()}
+{
     // Setup screen quad
     {
         std::vector<quadVert> vertices;
@@ -35,38 +44,30 @@ BlurEffect::BlurEffect(const BlurConfig& config) {
 
     // Setup shaders
     {
-        if (!blurShader.compileFromFiles(
-            util::getResourcePath("engine/shaders/screen_quad.vert"),
-            util::getResourcePath("engine/shaders/blur.frag")
+        screenQuadStage = getSharedStage(
+            ShaderStage::VERTEX,
+            "engine/shaders/screen_quad.vert"
+        );
+        if (!screenQuadStage) {
+            throw std::runtime_error{"[render::postprocessing::BlurEffect] Failed loading screen_quad shader"};
+        }
+
+        if (!blurShader.compileStagePrecompiled(
+            ShaderStage::FRAGMENT,
+            "engine/shaders/blur.frag"
         )) {
             throw std::runtime_error{"[render::postprocessing::BlurEffect] Failed loading blur shader"};
         }
-    }
 
-    // Setup ping-pong blur framebuffers
-    {
-        for (int i = 0; i < 2; ++i) {
-            blurTextures[i].setWrapS(render::TextureWrapMode::CLAMP_TO_EDGE);
-            blurTextures[i].setWrapT(render::TextureWrapMode::CLAMP_TO_EDGE);
-            auto status = blurFramebuffers[i].setup({
-                .width = config.width,
-                .height = config.height,
-                .colorAttachments = {
-                    {0, render::FramebufferAttachment{
-                        .texture = &blurTextures[i],
-                        .format = render::TextureFormat::RGBA16F,
-                    }},
-                },
-            });
-            if (status != render::Framebuffer::Status::COMPLETE) {
-                std::stringstream ss;
-                ss << "[render::postprocessing::BlurEffect] Failed setting up blur framebuffer: " << status;
-                throw std::runtime_error{ss.str()};
-            }
+        blurPipeline.setStage(*screenQuadStage);
+        blurPipeline.setStage(blurShader);
+
+        if (!blurCompute.compilePrecompiled("engine/shaders/blur.comp")) {
+            throw std::runtime_error{"[render::postprocessing::BlurEffect] Failed loading blur compute shader"};
         }
     }
 
-    setOffsetScale(offsetScale);
+    setRadius(config.radius);
 }
 
 BlurEffect::~BlurEffect() {
@@ -75,38 +76,115 @@ BlurEffect::~BlurEffect() {
 }
 
 void BlurEffect::setOffsetScale(float _offsetScale) {
-    offsetScale = _offsetScale;
-    blurShader.setFloat("offsetScale", offsetScale);
+    offsetScale = std::max(_offsetScale, 0.0f);
+    updateKernel();
+}
+
+void BlurEffect::setRadius(uint32_t _radius, float _sigma) {
+    radius = std::min(_radius, MAX_RADIUS);
+    sigma = _sigma;
+    updateKernel();
+}
+
+void BlurEffect::updateKernel() {
+    // Scale the kernel in texel space first; folding below needs taps one texel apart
+    const uint32_t scaledRadius = std::min(static_cast<uint32_t>(std::lround(radius * offsetScale)), MAX_RADIUS);
+    const float scaledSigma = std::max((sigma > 0.0f ? sigma : std::max(radius * 0.5f, 0.5f)) * offsetScale, 0.01f);
+
+    // Normalized one-sided Gaussian kernel; weights[0] is the center
+    std::vector<float> weights(scaledRadius + 1);
+    float sum = 0.0f;
+    for (uint32_t i = 0; i <= scaledRadius; i++) {
+        weights[i] = std::exp(-0.5f * (i * i) / (scaledSigma * scaledSigma));
+        sum += (i == 0) ? weights[i] : 2.0f * weights[i];
+    }
+    for (float& weight : weights) weight /= sum;
+
+    // Compute passes read every texel of the tile
+    blurCompute.setInt("radius", static_cast<int>(scaledRadius));
+    for (uint32_t i = 0; i <= scaledRadius; i++) {
+        blurCompute.setFloat("weights[" + std::to_string(i) + "]", weights[i]);
+    }
+
+    // Fragment passes fold texels `i` and `i + 1` into one bilinear fetch between them, weighted by
+    // their sum; the center texel stays a tap of its own
+    int taps = 1;
+    blurShader.setFloat("weights[0]", weights[0]);
+    blurShader.setFloat("offsets[0]", 0.0f);
+    for (uint32_t i = 1; i <= scaledRadius; i += 2, taps++) {
+        const float first = weights[i];
+        const float second = (i + 1 <= scaledRadius) ? weights[i + 1] : 0.0f;
+        const float weight = first + second;
+
+        blurShader.setFloat("weights[" + std::to_string(taps) + "]", weight);
+        blurShader.setFloat("offsets[" + std::to_string(taps) + "]", (i * first + (i + 1) * second) / weight);
+    }
+    blurShader.setInt("tapCount", taps);
 }
 
 const Texture2D& BlurEffect::apply(const Texture2D& input, const PostProcessContext& ctx) {
     (void)ctx;
 
+    // The previous output is overwritten anyway; let it be one of the ping-pong targets
+    output.release();
+
+    const RenderTargetDesc desc{.width = width, .height = height, .format = TextureFormat::RGBA16F};
+    RenderTargetPool::Handle targets[2] = {pool->acquire(desc), pool->acquire(desc)};
+
+    if (method == BlurMethod::COMPUTE) {
+        applyCompute(input, targets);
+    } else {
+        applyFragment(input, targets);
+    }
+
+    // The last pass is always a vertical one, into targets[0]; the other one goes back to the pool
+    output = std::move(targets[0]);
+    return output.texture();
+}
+
+void BlurEffect::applyFragment(const Texture2D& input, RenderTargetPool::Handle (&targets)[2]) {
     bool horizontal = true;
-    blurShader.use();
+    blurPipeline.use();
 
     // The first pass blurs the original input texture
-    blurFramebuffers[horizontal].bind({ .clearColor = false, .clearStencil = false, .clearDepth = false });
+    targets[horizontal].framebuffer().bind({ .clearColor = false, .clearStencil = false, .clearDepth = false });
     blurShader.setInt("horizontal", horizontal);
     blurShader.setTexture("image", input, 0);
     glDisable(GL_DEPTH_TEST);
     _screenQuad.render();
     horizontal = !horizontal;
 
-    // Subsequent passes ping-pong between the internal blur textures
-    for (uint32_t i = 1; i < blurIterations * 2U; i++) {
-        blurFramebuffers[horizontal].bind({ .clearColor = false, .clearStencil = false, .clearDepth = false });
+    // Subsequent passes ping-pong between the two targets
+    for (uint32_t i = 1; i < passCount(); i++) {
+        targets[horizontal].framebuffer().bind({ .clearColor = false, .clearStencil = false, .clearDepth = false });
         blurShader.setInt("horizontal", horizontal);
-        blurShader.setTexture("image", blurTextures[!horizontal], 0);
+        blurShader.setTexture("image", targets[!horizontal].texture(), 0);
         _screenQuad.render();
         horizontal = !horizontal;
     }
 
     glEnable(GL_DEPTH_TEST);
+}
+
+void BlurEffect::applyCompute(const Texture2D& input, RenderTargetPool::Handle (&targets)[2]) {
+    const Texture2D* source = &input;
+    for (uint32_t i = 0; i < passCount(); i++) {
+        const bool horizontal = (i % 2) == 0;
+        const Texture2D& target = targets[horizontal].texture();
 
-    // The final result is in the last texture that was rendered to.
-    // Since `horizontal` is flipped at the end of the loop, the result is in `blurTextures[!horizontal]`.
-    return blurTextures[!horizontal];
+        // One work group per tile of a row (or column)
+        const uint32_t along = horizontal ? width : height;
+        const uint32_t across = horizontal ? height : width;
+
+        blurCompute.setInt("horizontal", horizontal);
+        blurCompute.setTexture("image", *source, 0);
+        blurCompute.bindImage(0, target, ImageAccess::WRITE_ONLY);
+        blurCompute.dispatch((along + COMPUTE_TILE_SIZE - 1) / COMPUTE_TILE_SIZE, across);
+
+        // The next pass samples what this one wrote, and so may whoever consumes the output
+        memoryBarrier(MemoryBarrierBit::TEXTURE_FETCH | MemoryBarrierBit::SHADER_IMAGE_ACCESS);
+        source = &target;
+    }
 }
 
-} // namespace tmig::render::postprocessing
\ No newline at end of file
+} // namespace tmig::render::postprocessing
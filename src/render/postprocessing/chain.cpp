@@ -0,0 +1,187 @@
+#include <sstream>
+#include <stdexcept>
+
+#include "glad/glad.h"
+
+#include "tmig/render/postprocessing/chain.hpp"
+#include "tmig/util/log.hpp"
+#include "tmig/util/shapes.hpp"
+
+namespace tmig::render::postprocessing {
+
+/// @brief Name `EFFECT` is renamed to for the effect at `index` of a fused run
+static std::string fusedPrefix(size_t index) {
+    return "effect" + std::to_string(index);
+}
+
+/// @brief Replace every `EFFECT` token of `source` with `prefix`
+static std::string renameEffect(const std::string& source, const std::string& prefix) {
+    static const std::string token = "EFFECT";
+
+    std::string renamed;
+    size_t start = 0;
+    for (size_t found = source.find(token); found != std::string::npos; found = source.find(token, start)) {
+        renamed.append(source, start, found - start);
+        renamed += prefix;
+        start = found + token.size();
+    }
+    renamed.append(source, start, std::string::npos);
+    return renamed;
+}
+
+PostProcessChain::PostProcessChain(const PostProcessChainConfig& config)
+    : pool{config.pool ? config.pool : getSharedRenderTargetPool()}
+{
+    // Setup screen quad
+    {
+        std::vector<quadVert> vertices;
+        std::vector<uint32_t> indices;
+        util::generateScreenQuadMesh([&vertices](auto v) { vertices.push_back({
+            .pos = v.position,
+            .uv = v.uv
+        }); }, indices);
+
+        _vertBuffer = new DataBuffer<quadVert>;
+        _vertBuffer->setData(vertices);
+
+        _indexBuffer = new DataBuffer<uint32_t>;
+        _indexBuffer->setData(indices);
+
+        _screenQuad.setAttributes({
+            render::VertexAttributeType::FLOAT3,
+            render::VertexAttributeType::FLOAT2,
+        });
+        _screenQuad.setIndexBuffer(_indexBuffer);
+        _screenQuad.setVertexBuffer(_vertBuffer);
+    }
+
+    screenQuadStage = getSharedStage(
+        ShaderStage::VERTEX,
+        "engine/shaders/screen_quad.vert"
+    );
+    if (!screenQuadStage) {
+        throw std::runtime_error{"[render::postprocessing::PostProcessChain] Failed loading screen_quad shader"};
+    }
+}
+
+PostProcessChain::~PostProcessChain() {
+    delete _vertBuffer;
+    delete _indexBuffer;
+}
+
+void PostProcessChain::add(Effect& effect) {
+#ifdef DEBUG
+    if (&effect == this) {
+        throw std::runtime_error{"[render::postprocessing::PostProcessChain::add] A chain can't contain itself"};
+    }
+#endif
+
+    effects.push_back(&effect);
+}
+
+void PostProcessChain::clear() {
+    effects.clear();
+}
+
+size_t PostProcessChain::passCount() const {
+    size_t passes = 0;
+    bool previousPointwise = false;
+    for (const Effect* effect : effects) {
+        const bool pointwise = dynamic_cast<const PointwiseEffect*>(effect) != nullptr;
+        if (!pointwise || !previousPointwise) passes++;
+        previousPointwise = pointwise;
+    }
+    return passes;
+}
+
+PostProcessChain::FusedPass& PostProcessChain::fusedPass(const std::vector<PointwiseEffect*>& run) {
+    std::stringstream source;
+    source << "#version 440 core\n"
+           << "out vec4 FragColor;\n"
+           << "layout(location = 1) in vec2 uv;\n"
+           << "uniform sampler2D image;\n\n";
+    for (size_t i = 0; i < run.size(); i++) {
+        source << renameEffect(run[i]->source(), fusedPrefix(i)) << "\n";
+    }
+    source << "void main() {\n"
+           << "    vec4 color = texture(image, uv);\n";
+    for (size_t i = 0; i < run.size(); i++) {
+        source << "    color = " << fusedPrefix(i) << "(color, uv);\n";
+    }
+    source << "    FragColor = color;\n"
+           << "}\n";
+
+    auto& pass = fusedPasses[source.str()];
+    if (!pass) {
+        auto created = std::make_unique<FusedPass>();
+        if (!created->shader.compileStageFromSource(ShaderStage::FRAGMENT, source.str())) {
+            fusedPasses.erase(source.str());
+            throw std::runtime_error{"[render::postprocessing::PostProcessChain] Failed compiling fused shader"};
+        }
+        created->pipeline.setStage(*screenQuadStage);
+        created->pipeline.setStage(created->shader);
+
+        util::logMessage(
+            util::LogCategory::ENGINE, util::LogSeverity::INFO,
+            "Compiled fused post-processing pass of %zu effects\n", run.size()
+        );
+        pass = std::move(created);
+    }
+    return *pass;
+}
+
+const Texture2D& PostProcessChain::apply(const Texture2D& input, const PostProcessContext& ctx) {
+    // Target holding `current`, when it is the result of a fused pass
+    RenderTargetPool::Handle held;
+    output.release();
+
+    const Texture2D* current = &input;
+    for (size_t i = 0; i < effects.size();) {
+        PointwiseEffect* pointwise = dynamic_cast<PointwiseEffect*>(effects[i]);
+        if (!pointwise) {
+            const Texture2D* result = &effects[i]->apply(*current, ctx);
+            // Effects may hand their input back (an empty nested chain does), so keep it alive then
+            if (!held || result != &held.texture()) {
+                held.release();
+            }
+            current = result;
+            i++;
+            continue;
+        }
+
+        // Longest run of point-wise effects from here, rendered in one pass
+        std::vector<PointwiseEffect*> run;
+        for (; i < effects.size() && (pointwise = dynamic_cast<PointwiseEffect*>(effects[i])); i++) {
+            run.push_back(pointwise);
+        }
+
+        FusedPass& pass = fusedPass(run);
+        for (size_t effect = 0; effect < run.size(); effect++) {
+            run[effect]->setUniforms(pass.shader, fusedPrefix(effect));
+        }
+
+        auto target = pool->acquire({
+            .width = current->width(),
+            .height = current->height(),
+            .format = current->format(),
+        });
+
+        // Every pixel is overwritten
+        target.framebuffer().bind({ .clearColor = false, .clearStencil = false, .clearDepth = false });
+        pass.pipeline.use();
+        pass.shader.setTexture("image", *current, 0);
+
+        glDisable(GL_DEPTH_TEST);
+        _screenQuad.render();
+        glEnable(GL_DEPTH_TEST);
+
+        // The previous fused result has been consumed
+        held = std::move(target);
+        current = &held.texture();
+    }
+
+    output = std::move(held);
+    return *current;
+}
+
+} // namespace tmig::render::postprocessing
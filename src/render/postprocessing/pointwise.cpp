@@ -0,0 +1,64 @@
+#include "tmig/render/postprocessing/pointwise.hpp"
+#include "tmig/render/postprocessing/chain.hpp"
+
+namespace tmig::render::postprocessing {
+
+PointwiseEffect::PointwiseEffect() = default;
+
+PointwiseEffect::~PointwiseEffect() = default;
+
+const Texture2D& PointwiseEffect::apply(const Texture2D& input, const PostProcessContext& ctx) {
+    if (!_standalone) {
+        _standalone = std::make_unique<PostProcessChain>();
+        _standalone->add(*this);
+    }
+    return _standalone->apply(input, ctx);
+}
+
+std::string InvertEffect::source() const {
+    return R"(
+uniform float EFFECT_strength = 1.0;
+
+vec4 EFFECT(vec4 color, vec2 uv) {
+    return vec4(mix(color.rgb, 1.0 - color.rgb, EFFECT_strength), color.a);
+}
+)";
+}
+
+void InvertEffect::setUniforms(ShaderProgram& program, const std::string& prefix) const {
+    program.setFloat(prefix + "_strength", strength);
+}
+
+std::string GrayscaleEffect::source() const {
+    return R"(
+uniform float EFFECT_strength = 1.0;
+
+vec4 EFFECT(vec4 color, vec2 uv) {
+    float gray = dot(color.rgb, vec3(0.2126, 0.7152, 0.0722));
+    return vec4(mix(color.rgb, vec3(gray), EFFECT_strength), color.a);
+}
+)";
+}
+
+void GrayscaleEffect::setUniforms(ShaderProgram& program, const std::string& prefix) const {
+    program.setFloat(prefix + "_strength", strength);
+}
+
+std::string VignetteEffect::source() const {
+    return R"(
+uniform float EFFECT_strength = 1.0;
+uniform vec2 EFFECT_radius = vec2(0.25, 0.85);
+
+vec4 EFFECT(vec4 color, vec2 uv) {
+    float vignette = smoothstep(EFFECT_radius.y, EFFECT_radius.x, distance(uv, vec2(0.5)));
+    return vec4(color.rgb * mix(1.0, vignette, EFFECT_strength), color.a);
+}
+)";
+}
+
+void VignetteEffect::setUniforms(ShaderProgram& program, const std::string& prefix) const {
+    program.setFloat(prefix + "_strength", strength);
+    program.setVec2(prefix + "_radius", {innerRadius, outerRadius});
+}
+
+} // namespace tmig::render::postprocessing
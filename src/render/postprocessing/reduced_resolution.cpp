@@ -0,0 +1,187 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include "glad/glad.h"
+
+#include "tmig/render/postprocessing/reduced_resolution.hpp"
+#include "tmig/util/shapes.hpp"
+
+namespace tmig::render::postprocessing {
+
+ReducedResolutionEffect::ReducedResolutionEffect(Effect& effect, const ReducedResolutionConfig& config)
+    : effect{&effect},
+      config{config},
+      pool{config.pool ? config.pool : getSharedRenderTargetPool()}
+{
+#ifdef DEBUG
+    if (&effect == this) {
+        throw std::runtime_error{"[render::postprocessing::ReducedResolutionEffect] An effect can't wrap itself"};
+    }
+#endif
+
+    // Setup screen quad
+    {
+        std::vector<quadVert> vertices;
+        std::vector<uint32_t> indices;
+        util::generateScreenQuadMesh([&vertices](auto v) { vertices.push_back({
+            .pos = v.position,
+            .uv = v.uv
+        }); }, indices);
+
+        _vertBuffer = new DataBuffer<quadVert>;
+        _vertBuffer->setData(vertices);
+
+        _indexBuffer = new DataBuffer<uint32_t>;
+        _indexBuffer->setData(indices);
+
+        _screenQuad.setAttributes({
+            render::VertexAttributeType::FLOAT3,
+            render::VertexAttributeType::FLOAT2,
+        });
+        _screenQuad.setIndexBuffer(_indexBuffer);
+        _screenQuad.setVertexBuffer(_vertBuffer);
+    }
+
+    // Setup shaders
+    {
+        screenQuadStage = getSharedStage(
+            ShaderStage::VERTEX,
+            "engine/shaders/screen_quad.vert"
+        );
+        if (!screenQuadStage) {
+            throw std::runtime_error{"[render::postprocessing::ReducedResolutionEffect] Failed loading screen_quad shader"};
+        }
+
+        if (!downsampleShader.compileStagePrecompiled(
+            ShaderStage::FRAGMENT,
+            "engine/shaders/reduced_downsample.frag"
+        )) {
+            throw std::runtime_error{"[render::postprocessing::ReducedResolutionEffect] Failed loading downsample shader"};
+        }
+
+        if (!upsampleShader.compileStagePrecompiled(
+            ShaderStage::FRAGMENT,
+            "engine/shaders/reduced_upsample.frag"
+        )) {
+            throw std::runtime_error{"[render::postprocessing::ReducedResolutionEffect] Failed loading upsample shader"};
+        }
+
+        downsamplePipeline.setStage(*screenQuadStage);
+        downsamplePipeline.setStage(downsampleShader);
+
+        upsamplePipeline.setStage(*screenQuadStage);
+        upsamplePipeline.setStage(upsampleShader);
+    }
+
+    setDivisor(config.divisor);
+    setDepthSigma(depthSigma);
+    setNormalPower(normalPower);
+}
+
+ReducedResolutionEffect::~ReducedResolutionEffect() {
+    delete _vertBuffer;
+    delete _indexBuffer;
+}
+
+void ReducedResolutionEffect::setDivisor(uint32_t divisor) {
+    config.divisor = std::max(divisor, 1U);
+    downsampleShader.setInt("divisor", static_cast<int>(config.divisor));
+}
+
+void ReducedResolutionEffect::setDepthSigma(float sigma) {
+    depthSigma = std::max(sigma, 1e-4f);
+    upsampleShader.setFloat("depthSigma", depthSigma);
+}
+
+void ReducedResolutionEffect::setNormalPower(float power) {
+    normalPower = std::max(power, 0.0f);
+    upsampleShader.setFloat("normalPower", normalPower);
+}
+
+RenderTargetPool::Handle ReducedResolutionEffect::downsample(
+    const Texture2D& image,
+    const Texture2D* guide,
+    uint32_t width, uint32_t height,
+    const glm::vec3& eye
+) {
+    auto target = pool->acquire({
+        .width = width,
+        .height = height,
+        .format = image.format(),
+    });
+
+    // Every pixel is overwritten
+    target.framebuffer().bind({ .clearColor = false, .clearStencil = false, .clearDepth = false });
+    downsamplePipeline.use();
+    downsampleShader.setTexture("image", image, 0);
+    downsampleShader.setBool("nearest", guide != nullptr);
+    if (guide) {
+        downsampleShader.setTexture("guide", *guide, 1);
+        downsampleShader.setVec3("eye", eye);
+    }
+    _screenQuad.render();
+
+    return target;
+}
+
+const Texture2D& ReducedResolutionEffect::apply(const Texture2D& input, const PostProcessContext& ctx) {
+    output.release();
+
+    const uint32_t width = std::max((input.width() + config.divisor - 1) / config.divisor, 1U);
+    const uint32_t height = std::max((input.height() + config.divisor - 1) / config.divisor, 1U);
+    const glm::vec3 eye = ctx.camera ? ctx.camera->getPosition() : glm::vec3{0.0f};
+
+    glDisable(GL_DEPTH_TEST);
+
+    // Reduced copies of the input and of the G-buffer, alive until the upsample
+    RenderTargetPool::Handle color = downsample(input, nullptr, width, height, eye);
+    RenderTargetPool::Handle positions, normals;
+
+    PostProcessContext reduced = ctx;
+    if (ctx.gPosition) {
+        positions = downsample(*ctx.gPosition, ctx.gPosition, width, height, eye);
+        reduced.gPosition = &positions.texture();
+
+        if (ctx.gNormal) {
+            normals = downsample(*ctx.gNormal, ctx.gPosition, width, height, eye);
+            reduced.gNormal = &normals.texture();
+        }
+    }
+
+    glEnable(GL_DEPTH_TEST);
+    const Texture2D& result = effect->apply(color.texture(), reduced);
+    glDisable(GL_DEPTH_TEST);
+
+    output = pool->acquire({
+        .width = input.width(),
+        .height = input.height(),
+        .format = result.format(),
+    });
+
+    // Every pixel is overwritten
+    output.framebuffer().bind({ .clearColor = false, .clearStencil = false, .clearDepth = false });
+    upsamplePipeline.use();
+    upsampleShader.setTexture("image", result, 0);
+
+    const bool guided = ctx.gPosition && config.upsample != UpsampleFilter::BILINEAR;
+    upsampleShader.setBool("guided", guided);
+    if (guided) {
+        upsampleShader.setBool("nearestDepth", config.upsample == UpsampleFilter::NEAREST_DEPTH);
+        upsampleShader.setVec3("eye", eye);
+        upsampleShader.setTexture("positions", *ctx.gPosition, 1);
+        upsampleShader.setTexture("lowPositions", positions.texture(), 2);
+
+        upsampleShader.setBool("hasNormals", ctx.gNormal != nullptr);
+        if (ctx.gNormal) {
+            upsampleShader.setTexture("normals", *ctx.gNormal, 3);
+            upsampleShader.setTexture("lowNormals", normals.texture(), 4);
+        }
+    }
+    _screenQuad.render();
+
+    glEnable(GL_DEPTH_TEST);
+
+    return output.texture();
+}
+
+} // namespace tmig::render::postprocessing
@@ -0,0 +1,174 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "glad/glad.h"
+
+#include "tmig/render/postprocessing/tone_mapping.hpp"
+#include "tmig/util/shapes.hpp"
+
+namespace tmig::render::postprocessing {
+
+/// @brief Binding points of the storage buffers; match `luminance_*.comp` and `tone_mapping.frag`
+static constexpr uint32_t HISTOGRAM_BINDING = 0;
+static constexpr uint32_t LUMINANCE_BINDING = 1;
+
+/// @brief The histogram pass reads tiles of this many pixels per side; matches `luminance_histogram.comp`
+static constexpr uint32_t HISTOGRAM_TILE_SIZE = 16;
+
+ToneMappingEffect::ToneMappingEffect(const ToneMappingConfig& config)
+    : config{config},
+      histogram{HISTOGRAM_BINS},
+      adaptedLuminance{1},
+      pool{config.pool ? config.pool : getSharedRenderTargetPool()}
+{
+    // Setup screen quad
+    {
+        std::vector<quadVert> vertices;
+        std::vector<uint32_t> indices;
+        util::generateScreenQuadMesh([&vertices](auto v) { vertices.push_back({
+            .pos = v.position,
+            .uv = v.uv
+        }); }, indices);
+
+        _vertBuffer = new DataBuffer<quadVert>;
+        _vertBuffer->setData(vertices);
+
+        _indexBuffer = new DataBuffer<uint32_t>;
+        _indexBuffer->setData(indices);
+
+        _screenQuad.setAttributes({
+            render::VertexAttributeType::FLOAT3,
+            render::VertexAttributeType::FLOAT2,
+        });
+        _screenQuad.setIndexBuffer(_indexBuffer);
+        _screenQuad.setVertexBuffer(_vertBuffer);
+    }
+
+    // Setup shaders
+    {
+        if (!histogramProgram.compilePrecompiled("engine/shaders/luminance_histogram.comp")) {
+            throw std::runtime_error{"[render::postprocessing::ToneMappingEffect] Failed loading luminance_histogram shader"};
+        }
+
+        if (!averageProgram.compilePrecompiled("engine/shaders/luminance_average.comp")) {
+            throw std::runtime_error{"[render::postprocessing::ToneMappingEffect] Failed loading luminance_average shader"};
+        }
+
+        screenQuadStage = getSharedStage(
+            ShaderStage::VERTEX,
+            "engine/shaders/screen_quad.vert"
+        );
+        if (!screenQuadStage) {
+            throw std::runtime_error{"[render::postprocessing::ToneMappingEffect] Failed loading screen_quad shader"};
+        }
+
+        if (!toneMapShader.compileStagePrecompiled(
+            ShaderStage::FRAGMENT,
+            "engine/shaders/tone_mapping.frag"
+        )) {
+            throw std::runtime_error{"[render::postprocessing::ToneMappingEffect] Failed loading tone_mapping shader"};
+        }
+
+        toneMapPipeline.setStage(*screenQuadStage);
+        toneMapPipeline.setStage(toneMapShader);
+    }
+
+    // Both buffers start zeroed; the first average skips adaptation anyway
+    histogram.setData(std::vector<uint32_t>(HISTOGRAM_BINS, 0));
+    adaptedLuminance.setData(std::vector<float>{0.0f});
+
+    setOperator(config.tonemapOperator);
+    setAutoExposure(autoExposure);
+    setExposureCompensation(exposureCompensation);
+    setLuminanceRange(minLogLuminance, maxLogLuminance);
+}
+
+ToneMappingEffect::~ToneMappingEffect() {
+    delete _vertBuffer;
+    delete _indexBuffer;
+}
+
+void ToneMappingEffect::setOperator(ToneMapOperator tonemapOperator) {
+    config.tonemapOperator = tonemapOperator;
+    toneMapShader.setInt("tonemapOperator", static_cast<int>(tonemapOperator));
+}
+
+void ToneMappingEffect::setAutoExposure(bool enabled) {
+    // Luminance measured before a pause would be stale
+    if (enabled && !autoExposure) resetPending = true;
+
+    autoExposure = enabled;
+    toneMapShader.setBool("autoExposure", autoExposure);
+}
+
+void ToneMappingEffect::setExposureCompensation(float ev) {
+    exposureCompensation = ev;
+    toneMapShader.setFloat("exposureCompensation", exposureCompensation);
+}
+
+void ToneMappingEffect::setLuminanceRange(float minLog2, float maxLog2) {
+    minLogLuminance = minLog2;
+    maxLogLuminance = std::max(maxLog2, minLog2 + 1e-3f);
+
+    const float range = maxLogLuminance - minLogLuminance;
+    histogramProgram.setFloat("minLogLuminance", minLogLuminance);
+    histogramProgram.setFloat("inverseLogLuminanceRange", 1.0f / range);
+    averageProgram.setFloat("minLogLuminance", minLogLuminance);
+    averageProgram.setFloat("logLuminanceRange", range);
+}
+
+void ToneMappingEffect::setAdaptationRate(float rate) {
+    adaptationRate = std::max(rate, 0.0f);
+}
+
+void ToneMappingEffect::measureLuminance(const Texture2D& input) {
+    histogramProgram.setTexture("image", input, 0);
+    histogramProgram.bindStorageBuffer(HISTOGRAM_BINDING, histogram);
+    histogramProgram.dispatch(
+        (input.width() + HISTOGRAM_TILE_SIZE - 1) / HISTOGRAM_TILE_SIZE,
+        (input.height() + HISTOGRAM_TILE_SIZE - 1) / HISTOGRAM_TILE_SIZE
+    );
+    memoryBarrier(MemoryBarrierBit::SHADER_STORAGE);
+
+    // Exponential moving average in luminance; a frame rate independent fraction of the gap is closed
+    const float blend = resetPending ? 1.0f : 1.0f - std::exp(-std::max(deltaTime, 0.0f) * adaptationRate);
+    resetPending = false;
+
+    averageProgram.setFloat("pixelCount", static_cast<float>(input.width()) * static_cast<float>(input.height()));
+    averageProgram.setFloat("blend", blend);
+    averageProgram.bindStorageBuffer(HISTOGRAM_BINDING, histogram);
+    averageProgram.bindStorageBuffer(LUMINANCE_BINDING, adaptedLuminance);
+    averageProgram.dispatch(1);
+    memoryBarrier(MemoryBarrierBit::SHADER_STORAGE);
+}
+
+const Texture2D& ToneMappingEffect::apply(const Texture2D& input, const PostProcessContext& ctx) {
+    (void)ctx;
+
+    if (autoExposure) {
+        measureLuminance(input);
+    }
+
+    output.release();
+    output = pool->acquire({
+        .width = input.width(),
+        .height = input.height(),
+        .format = config.format,
+    });
+
+    // Every pixel is overwritten
+    output.framebuffer().bind({ .clearColor = false, .clearStencil = false, .clearDepth = false });
+    toneMapPipeline.use();
+    toneMapShader.setTexture("image", input, 0);
+    adaptedLuminance.bindTo(LUMINANCE_BINDING);
+
+    glDisable(GL_DEPTH_TEST);
+    _screenQuad.render();
+    glEnable(GL_DEPTH_TEST);
+
+    return output.texture();
+}
+
+} // namespace tmig::render::postprocessing
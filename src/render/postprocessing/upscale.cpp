@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include "glad/glad.h"
+
+#include "tmig/render/postprocessing/upscale.hpp"
+#include "tmig/util/shapes.hpp"
+
+namespace tmig::render::postprocessing {
+
+/// @brief Whether `format` stores colors as normalized integers, i.e. can only hold [0, 1]
+static bool isNormalizedFormat(TextureFormat format) {
+    switch (format) {
+        case TextureFormat::R8:
+        case TextureFormat::RG8:
+        case TextureFormat::RGB8:
+        case TextureFormat::RGBA8:
+        case TextureFormat::SRGB8:
+        case TextureFormat::SRGBA8:
+            return true;
+        default:
+            return false;
+    }
+}
+
+UpscaleEffect::UpscaleEffect(const UpscaleConfig& config)
+    : config{config},
+      pool{config.pool ? config.pool : getSharedRenderTargetPool()}
+{
+    // Setup screen quad
+    {
+        std::vector<quadVert> vertices;
+        std::vector<uint32_t> indices;
+        util::generateScreenQuadMesh([&vertices](auto v) { vertices.push_back({
+            .pos = v.position,
+            .uv = v.uv
+        }); }, indices);
+
+        _vertBuffer = new DataBuffer<quadVert>;
+        _vertBuffer->setData(vertices);
+
+        _indexBuffer = new DataBuffer<uint32_t>;
+        _indexBuffer->setData(indices);
+
+        _screenQuad.setAttributes({
+            render::VertexAttributeType::FLOAT3,
+            render::VertexAttributeType::FLOAT2,
+        });
+        _screenQuad.setIndexBuffer(_indexBuffer);
+        _screenQuad.setVertexBuffer(_vertBuffer);
+    }
+
+    // Setup shaders
+    {
+        screenQuadStage = getSharedStage(
+            ShaderStage::VERTEX,
+            "engine/shaders/screen_quad.vert"
+        );
+        if (!screenQuadStage) {
+            throw std::runtime_error{"[render::postprocessing::UpscaleEffect] Failed loading screen_quad shader"};
+        }
+
+        if (!upscaleShader.compileStagePrecompiled(
+            ShaderStage::FRAGMENT,
+            "engine/shaders/upscale.frag"
+        )) {
+            throw std::runtime_error{"[render::postprocessing::UpscaleEffect] Failed loading upscale shader"};
+        }
+
+        upscalePipeline.setStage(*screenQuadStage);
+        upscalePipeline.setStage(upscaleShader);
+    }
+
+    setSourceRegion(sourceRegion);
+    setSharpness(sharpness);
+
+    // Float outputs keep values above 1, so HDR survives until tone mapping
+    upscaleShader.setBool("clampToUnit", isNormalizedFormat(config.format));
+}
+
+UpscaleEffect::~UpscaleEffect() {
+    delete _vertBuffer;
+    delete _indexBuffer;
+}
+
+void UpscaleEffect::setOutputSize(uint32_t width, uint32_t height) {
+    config.width = width;
+    config.height = height;
+}
+
+void UpscaleEffect::setSourceRegion(const glm::vec2& region) {
+    sourceRegion = region;
+    upscaleShader.setVec2("region", sourceRegion);
+}
+
+void UpscaleEffect::setSharpness(float _sharpness) {
+    sharpness = std::clamp(_sharpness, 0.0f, 1.0f);
+    upscaleShader.setFloat("sharpness", sharpness);
+}
+
+const Texture2D& UpscaleEffect::apply(const Texture2D& input, const PostProcessContext& ctx) {
+    (void)ctx;
+
+    output.release();
+    output = pool->acquire({
+        .width = config.width,
+        .height = config.height,
+        .format = config.format,
+    });
+
+    // Every pixel is overwritten
+    output.framebuffer().bind({ .clearColor = false, .clearStencil = false, .clearDepth = false });
+    upscalePipeline.use();
+    upscaleShader.setTexture("image", input, 0);
+
+    glDisable(GL_DEPTH_TEST);
+    _screenQuad.render();
+    glEnable(GL_DEPTH_TEST);
+
+    return output.texture();
+}
+
+} // namespace tmig::render::postprocessing
@@ -0,0 +1,86 @@
+#include <stdexcept>
+#include <unordered_map>
+
+#include "glad/glad.h"
+
+#include "tmig/render/program_pipeline.hpp"
+#include "tmig/util/log.hpp"
+
+namespace tmig::render {
+
+/// @brief Convert a `ShaderStage` into an OpenGL pipeline stage bit
+static GLbitfield toStageBit(ShaderStage stage) {
+    switch (stage) {
+    case ShaderStage::VERTEX:   return GL_VERTEX_SHADER_BIT;
+    case ShaderStage::FRAGMENT: return GL_FRAGMENT_SHADER_BIT;
+    }
+    return 0;
+}
+
+ProgramPipeline::ProgramPipeline() {
+    glCreateProgramPipelines(1, &_id); glCheckError();
+    util::logMessage(
+        util::LogCategory::ENGINE, util::LogSeverity::INFO,
+        "Created program pipeline: %u\n", _id
+    );
+}
+
+ProgramPipeline::~ProgramPipeline() {
+    if (_id == 0) return;
+
+    util::logMessage(
+        util::LogCategory::ENGINE, util::LogSeverity::INFO,
+        "Deleting program pipeline: %u\n", _id
+    );
+    glDeleteProgramPipelines(1, &_id); glCheckError();
+}
+
+ProgramPipeline::ProgramPipeline(ProgramPipeline&& other) noexcept
+    : _id{other._id}
+{
+    other._id = 0;
+}
+
+ProgramPipeline& ProgramPipeline::operator=(ProgramPipeline&& other) noexcept {
+    if (this != &other) {
+        if (_id != 0) {
+            glDeleteProgramPipelines(1, &_id);
+        }
+
+        _id = other._id;
+        other._id = 0;
+    }
+    return *this;
+}
+
+void ProgramPipeline::setStage(const ShaderProgram& program) {
+    if (!program.isValid() || !program.isSeparable()) {
+        throw std::runtime_error{"[ProgramPipeline::setStage] Program is not a linked separable program"};
+    }
+
+    glUseProgramStages(_id, toStageBit(program.stage()), program.id()); glCheckError();
+}
+
+void ProgramPipeline::use() const {
+    glUseProgram(0); glCheckError();
+    glBindProgramPipeline(_id); glCheckError();
+}
+
+std::shared_ptr<ShaderProgram> getSharedStage(ShaderStage stage, const std::string& path) {
+    static std::unordered_map<std::string, std::weak_ptr<ShaderProgram>> cache;
+
+    const std::string key = std::to_string(static_cast<int>(stage)) + ":" + path;
+    if (auto program = cache[key].lock()) {
+        return program;
+    }
+
+    auto program = std::make_shared<ShaderProgram>();
+    if (!program->compileStagePrecompiled(stage, path)) {
+        return nullptr;
+    }
+
+    cache[key] = program;
+    return program;
+}
+
+} // namespace tmig::render
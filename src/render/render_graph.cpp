@@ -0,0 +1,511 @@
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <sstream>
+#include <stdexcept>
+
+#include "tmig/render/render_graph.hpp"
+#include "tmig/util/log.hpp"
+
+namespace tmig::render {
+
+namespace {
+
+bool isDepthFormat(TextureFormat format) {
+    switch (format) {
+        case TextureFormat::DEPTH24:
+        case TextureFormat::DEPTH32F:
+        case TextureFormat::DEPTH24_STENCIL8:
+        case TextureFormat::DEPTH32F_STENCIL8:
+            return true;
+        default:
+            return false;
+    }
+}
+
+DepthAttachmentFormat toDepthAttachmentFormat(TextureFormat format) {
+    switch (format) {
+        case TextureFormat::DEPTH32F:          return DepthAttachmentFormat::DEPTH32F;
+        case TextureFormat::DEPTH24_STENCIL8:  return DepthAttachmentFormat::DEPTH24_STENCIL8;
+        case TextureFormat::DEPTH32F_STENCIL8: return DepthAttachmentFormat::DEPTH32F_STENCIL8;
+        default:                               return DepthAttachmentFormat::DEPTH24;
+    }
+}
+
+} // namespace
+
+RenderGraphTexture RenderGraph::PassBuilder::create(const std::string& name, const RenderGraphTextureDesc& desc) {
+#ifdef DEBUG
+    if (desc.width == 0 || desc.height == 0 || desc.format == TextureFormat::UNDEFINED) {
+        throw std::runtime_error{"[RenderGraph::PassBuilder::create] Invalid texture description for " + name};
+    }
+#endif
+
+    _graph._resources.push_back(Resource{.name = name, .desc = desc});
+    return RenderGraphTexture{static_cast<uint32_t>(_graph._resources.size() - 1)};
+}
+
+RenderGraphTexture RenderGraph::PassBuilder::read(RenderGraphTexture texture) {
+#ifdef DEBUG
+    if (texture.index >= _graph._resources.size()) {
+        throw std::runtime_error{"[RenderGraph::PassBuilder::read] Invalid texture handle"};
+    }
+#endif
+
+    auto& reads = _graph._passes[_pass].reads;
+    if (std::find(reads.begin(), reads.end(), texture.index) == reads.end()) {
+        reads.push_back(texture.index);
+    }
+    return texture;
+}
+
+RenderGraphTexture RenderGraph::PassBuilder::write(RenderGraphTexture texture, uint32_t index) {
+#ifdef DEBUG
+    if (texture.index >= _graph._resources.size()) {
+        throw std::runtime_error{"[RenderGraph::PassBuilder::write] Invalid texture handle"};
+    }
+
+    if (isDepthFormat(_graph._resources[texture.index].desc.format)) {
+        throw std::runtime_error{"[RenderGraph::PassBuilder::write] Depth textures are written with writeDepth"};
+    }
+
+    for (const auto& [resource, attachment] : _graph._passes[_pass].writes) {
+        if (attachment == index) {
+            throw std::runtime_error{"[RenderGraph::PassBuilder::write] Color attachment index written twice"};
+        }
+    }
+#endif
+
+    _graph._passes[_pass].writes.emplace_back(texture.index, index);
+    return texture;
+}
+
+RenderGraphTexture RenderGraph::PassBuilder::writeDepth(RenderGraphTexture texture) {
+#ifdef DEBUG
+    if (texture.index >= _graph._resources.size()) {
+        throw std::runtime_error{"[RenderGraph::PassBuilder::writeDepth] Invalid texture handle"};
+    }
+
+    if (!isDepthFormat(_graph._resources[texture.index].desc.format)) {
+        throw std::runtime_error{"[RenderGraph::PassBuilder::writeDepth] Texture doesn't have a depth attachment format"};
+    }
+#endif
+
+    _graph._passes[_pass].depthWrite = texture.index;
+    return texture;
+}
+
+void RenderGraph::PassBuilder::sideEffect() {
+    _graph._passes[_pass].sideEffect = true;
+}
+
+void RenderGraph::PassBuilder::setBindOptions(const FramebufferBindOptions& options) {
+    _graph._passes[_pass].bindOptions = options;
+}
+
+const Texture2D& RenderGraph::PassContext::texture(RenderGraphTexture texture) const {
+    return _graph.texture(texture);
+}
+
+void RenderGraph::reset() {
+    _resources.clear();
+    _passes.clear();
+    _order.clear();
+    _usedTransientCount = 0;
+    _dirty = true;
+}
+
+RenderGraphTexture RenderGraph::importTexture(const std::string& name, Texture2D& texture) {
+#ifdef DEBUG
+    if (texture.width() == 0 || texture.height() == 0 || texture.format() == TextureFormat::UNDEFINED) {
+        throw std::runtime_error{"[RenderGraph::importTexture] Texture is not initialized: " + name};
+    }
+#endif
+
+    _resources.push_back(Resource{
+        .name = name,
+        .desc = {
+            .width = texture.width(),
+            .height = texture.height(),
+            .format = texture.format(),
+            .samples = texture.samples(),
+        },
+        .imported = &texture,
+    });
+    _dirty = true;
+    return RenderGraphTexture{static_cast<uint32_t>(_resources.size() - 1)};
+}
+
+void RenderGraph::addPass(const std::string& name, const SetupFunction& setup, ExecuteFunction execute) {
+    Pass pass;
+    pass.name = name;
+    pass.execute = std::move(execute);
+    _passes.push_back(std::move(pass));
+    _dirty = true;
+
+    PassBuilder builder{*this, static_cast<uint32_t>(_passes.size() - 1)};
+    setup(builder);
+}
+
+bool RenderGraph::writes(const Pass& pass, uint32_t resource) const {
+    if (pass.depthWrite == resource) return true;
+    return std::any_of(pass.writes.begin(), pass.writes.end(), [resource](const auto& write) {
+        return write.first == resource;
+    });
+}
+
+void RenderGraph::compile() {
+    const auto passCount = static_cast<uint32_t>(_passes.size());
+
+    // Writers of every texture, in the order passes were added
+    std::vector<std::vector<uint32_t>> writers(_resources.size());
+    for (uint32_t pass = 0; pass < passCount; pass++) {
+        for (const auto& [resource, _] : _passes[pass].writes) writers[resource].push_back(pass);
+        if (_passes[pass].depthWrite) writers[*_passes[pass].depthWrite].push_back(pass);
+    }
+
+    // Readers wait for every writer; writers (including read-modify-write passes) wait for earlier writers
+    std::vector<std::vector<uint32_t>> dependencies(passCount);
+    for (uint32_t pass = 0; pass < passCount; pass++) {
+        auto& dependsOn = dependencies[pass];
+        for (uint32_t resource : _passes[pass].reads) {
+            const bool alsoWrites = writes(_passes[pass], resource);
+            for (uint32_t writer : writers[resource]) {
+                if (writer == pass || (alsoWrites && writer > pass)) continue;
+                dependsOn.push_back(writer);
+            }
+        }
+        for (uint32_t resource = 0; resource < _resources.size(); resource++) {
+            if (!writes(_passes[pass], resource)) continue;
+            for (uint32_t writer : writers[resource]) {
+                if (writer < pass) dependsOn.push_back(writer);
+            }
+        }
+        std::sort(dependsOn.begin(), dependsOn.end());
+        dependsOn.erase(std::unique(dependsOn.begin(), dependsOn.end()), dependsOn.end());
+    }
+
+    // Keep passes with side effects or writing imported textures, and everything they depend on
+    std::vector<bool> alive(passCount, false);
+    std::vector<uint32_t> stack;
+    for (uint32_t pass = 0; pass < passCount; pass++) {
+        bool root = _passes[pass].sideEffect;
+        for (uint32_t resource = 0; !root && resource < _resources.size(); resource++) {
+            root = _resources[resource].imported && writes(_passes[pass], resource);
+        }
+        if (root) {
+            alive[pass] = true;
+            stack.push_back(pass);
+        }
+    }
+    while (!stack.empty()) {
+        const uint32_t pass = stack.back();
+        stack.pop_back();
+        for (uint32_t dependency : dependencies[pass]) {
+            if (!alive[dependency]) {
+                alive[dependency] = true;
+                stack.push_back(dependency);
+            }
+        }
+    }
+
+    // Topological order of the surviving passes; ties go to the pass added first
+    std::vector<uint32_t> pendingDependencies(passCount, 0);
+    std::vector<std::vector<uint32_t>> dependents(passCount);
+    uint32_t aliveCount = 0;
+    for (uint32_t pass = 0; pass < passCount; pass++) {
+        if (!alive[pass]) continue;
+        aliveCount++;
+        pendingDependencies[pass] = static_cast<uint32_t>(dependencies[pass].size());
+        for (uint32_t dependency : dependencies[pass]) dependents[dependency].push_back(pass);
+    }
+
+    std::priority_queue<uint32_t, std::vector<uint32_t>, std::greater<uint32_t>> ready;
+    for (uint32_t pass = 0; pass < passCount; pass++) {
+        if (alive[pass] && pendingDependencies[pass] == 0) ready.push(pass);
+    }
+
+    _order.clear();
+    while (!ready.empty()) {
+        const uint32_t pass = ready.top();
+        ready.pop();
+        _order.push_back(pass);
+        for (uint32_t dependent : dependents[pass]) {
+            if (--pendingDependencies[dependent] == 0) ready.push(dependent);
+        }
+    }
+
+    if (_order.size() != aliveCount) {
+        std::stringstream ss;
+        ss << "[RenderGraph::compile] Passes depend on each other in a cycle:";
+        for (uint32_t pass = 0; pass < passCount; pass++) {
+            if (alive[pass] && pendingDependencies[pass] != 0) ss << " " << _passes[pass].name;
+        }
+        throw std::runtime_error{ss.str()};
+    }
+
+    // Lifetime of every texture, in execution order
+    for (auto& resource : _resources) {
+        resource.physical = ~0u;
+        resource.firstUse = ~0u;
+        resource.lastUse = 0;
+        resource.sampled = false;
+    }
+    for (uint32_t position = 0; position < _order.size(); position++) {
+        const Pass& pass = _passes[_order[position]];
+        auto use = [&](uint32_t index) {
+            auto& resource = _resources[index];
+            resource.firstUse = std::min(resource.firstUse, position);
+            resource.lastUse = std::max(resource.lastUse, position);
+        };
+        for (uint32_t resource : pass.reads) {
+            use(resource);
+            _resources[resource].sampled = true;
+        }
+        for (const auto& [resource, _] : pass.writes) use(resource);
+        if (pass.depthWrite) use(*pass.depthWrite);
+    }
+
+    // Assign storage, first use first, reusing storage of the same description whose previous texture
+    // is dead by then. Storage from earlier frames is reused the same way, so identical frames reallocate
+    // nothing. Textures no pass samples (e.g. a depth buffer only used for depth testing) get a
+    // renderbuffer instead, which the driver may keep in tile memory
+    std::vector<uint32_t> transient;
+    for (uint32_t resource = 0; resource < _resources.size(); resource++) {
+        if (!_resources[resource].imported && _resources[resource].firstUse != ~0u) transient.push_back(resource);
+    }
+    std::stable_sort(transient.begin(), transient.end(), [this](uint32_t a, uint32_t b) {
+        return _resources[a].firstUse < _resources[b].firstUse;
+    });
+    _usedTransientCount = transient.size();
+
+    // Position of the last pass using each storage this frame; -1 if unused so far
+    std::vector<int64_t> busyUntil(_physical.size(), -1);
+    for (uint32_t index : transient) {
+        auto& resource = _resources[index];
+
+        for (uint32_t physical = 0; physical < _physical.size(); physical++) {
+            const bool renderbuffer = _physical[physical].renderbuffer != nullptr;
+            if (_physical[physical].desc == resource.desc && renderbuffer == !resource.sampled &&
+                busyUntil[physical] < static_cast<int64_t>(resource.firstUse)) {
+                resource.physical = physical;
+                break;
+            }
+        }
+
+        if (resource.physical == ~0u) {
+            PhysicalTexture physical;
+            physical.desc = resource.desc;
+            if (resource.sampled) {
+                physical.texture = std::make_unique<Texture2D>();
+                physical.texture->resizeMultisample(resource.desc.width, resource.desc.height, resource.desc.format, resource.desc.samples);
+                physical.texture->setWrapS(TextureWrapMode::CLAMP_TO_EDGE);
+                physical.texture->setWrapT(TextureWrapMode::CLAMP_TO_EDGE);
+            } else {
+                physical.renderbuffer = std::make_unique<Renderbuffer>();
+                physical.renderbuffer->resize(resource.desc.width, resource.desc.height, resource.desc.format, resource.desc.samples);
+            }
+
+            _physical.push_back(std::move(physical));
+            busyUntil.push_back(-1);
+            resource.physical = static_cast<uint32_t>(_physical.size() - 1);
+        }
+
+        busyUntil[resource.physical] = resource.lastUse;
+    }
+
+    // Drop storage unused this frame, e.g. after a resize
+    std::vector<uint32_t> remap(_physical.size(), ~0u);
+    uint32_t kept = 0;
+    for (uint32_t physical = 0; physical < _physical.size(); physical++) {
+        if (busyUntil[physical] < 0) continue;
+        remap[physical] = kept;
+        if (kept != physical) _physical[kept] = std::move(_physical[physical]);
+        kept++;
+    }
+    if (kept != _physical.size()) {
+        util::logMessage(
+            util::LogCategory::ENGINE, util::LogSeverity::INFO,
+            "[RenderGraph::compile] Deleting %zu unused transient textures\n", _physical.size() - kept
+        );
+        _physical.resize(kept);
+        for (uint32_t index : transient) {
+            _resources[index].physical = remap[_resources[index].physical];
+        }
+
+        // Object names may be reused by new storage; don't match framebuffers still attaching deleted ones
+        _framebuffers.clear();
+    }
+
+    // Framebuffers, shared by passes attaching the same textures; unused ones are dropped
+    std::unordered_map<std::string, std::unique_ptr<Framebuffer>> framebuffers;
+    for (auto& pass : _passes) pass.framebuffer = nullptr;
+    for (uint32_t passIndex : _order) {
+        Pass& pass = _passes[passIndex];
+        if (pass.writes.empty() && !pass.depthWrite) continue;
+
+        // Texture and renderbuffer names overlap, so the key tells them apart
+        std::stringstream key;
+        auto storageKey = [&](uint32_t resource) {
+            const auto& entry = _resources[resource];
+            if (!entry.imported && _physical[entry.physical].renderbuffer) {
+                key << 'r' << _physical[entry.physical].renderbuffer->id();
+            } else {
+                key << 't' << resourceTexture(resource).id();
+            }
+        };
+        for (const auto& [resource, attachment] : pass.writes) {
+            key << 'c' << attachment << ':';
+            storageKey(resource);
+            key << ';';
+        }
+        if (pass.depthWrite) {
+            key << "d:";
+            storageKey(*pass.depthWrite);
+        }
+
+        auto& framebuffer = framebuffers[key.str()];
+        if (!framebuffer) {
+            auto cached = _framebuffers.find(key.str());
+            framebuffer = cached != _framebuffers.end() ? std::move(cached->second) : framebufferFor(pass);
+        }
+        pass.framebuffer = framebuffer.get();
+    }
+    _framebuffers = std::move(framebuffers);
+
+    _dirty = false;
+}
+
+std::unique_ptr<Framebuffer> RenderGraph::framebufferFor(const Pass& pass) const {
+    FramebufferConfig config;
+    auto attach = [&config](const RenderGraphTextureDesc& desc) {
+#ifdef DEBUG
+        if (config.width != 0 && (desc.width != config.width || desc.height != config.height ||
+            desc.samples != config.samples)) {
+            throw std::runtime_error{"[RenderGraph::compile] Textures written by a pass differ in size or samples"};
+        }
+#endif
+        config.width = desc.width;
+        config.height = desc.height;
+        config.samples = desc.samples;
+    };
+
+    for (const auto& [resource, attachment] : pass.writes) {
+        const auto& desc = _resources[resource].desc;
+        attach(desc);
+        config.colorAttachments[attachment] = FramebufferAttachment{
+            .texture = resourceRenderbuffer(resource) ? nullptr : &resourceTexture(resource),
+            .format = desc.format,
+            .renderbuffer = resourceRenderbuffer(resource),
+        };
+    }
+    if (pass.depthWrite) {
+        const auto& desc = _resources[*pass.depthWrite].desc;
+        attach(desc);
+        config.depthAttachment = FramebufferDepthAttachment{
+            .texture = resourceRenderbuffer(*pass.depthWrite) ? nullptr : &resourceTexture(*pass.depthWrite),
+            .format = toDepthAttachmentFormat(desc.format),
+            .renderbuffer = resourceRenderbuffer(*pass.depthWrite),
+        };
+    }
+
+    auto framebuffer = std::make_unique<Framebuffer>();
+    auto status = framebuffer->setup(config);
+    if (status != Framebuffer::Status::COMPLETE) {
+        std::stringstream ss;
+        ss << "[RenderGraph::compile] Failed setting up framebuffer of pass " << pass.name << ": " << status;
+        throw std::runtime_error{ss.str()};
+    }
+    return framebuffer;
+}
+
+void RenderGraph::invalidateAttachments(const Pass& pass, uint32_t position, bool first) const {
+    auto discardable = [&](uint32_t index) {
+        const auto& resource = _resources[index];
+        if (resource.imported) return false;
+        if (first) {
+            return resource.firstUse == position &&
+                std::find(pass.reads.begin(), pass.reads.end(), index) == pass.reads.end();
+        }
+        return resource.lastUse == position;
+    };
+
+    std::vector<uint32_t> colorIndices;
+    for (const auto& [resource, attachment] : pass.writes) {
+        if (discardable(resource)) colorIndices.push_back(attachment);
+    }
+    pass.framebuffer->invalidate(colorIndices, pass.depthWrite && discardable(*pass.depthWrite));
+}
+
+void RenderGraph::execute() {
+    if (_dirty) {
+        compile();
+    }
+
+    for (uint32_t position = 0; position < _order.size(); position++) {
+        const Pass& pass = _passes[_order[position]];
+
+        // Whatever the storage held before (another texture aliasing it, the previous frame) isn't needed
+        if (pass.framebuffer) {
+            invalidateAttachments(pass, position, true);
+            pass.framebuffer->bind(pass.bindOptions);
+        }
+
+        if (pass.execute) {
+            pass.execute(PassContext{*this, pass.framebuffer});
+        }
+
+        // Nothing reads these attachments anymore, so they don't need to be written back
+        if (pass.framebuffer) {
+            invalidateAttachments(pass, position, false);
+        }
+    }
+}
+
+Texture2D& RenderGraph::resourceTexture(uint32_t resource) const {
+    const auto& entry = _resources[resource];
+    return entry.imported ? *entry.imported : *_physical[entry.physical].texture;
+}
+
+Renderbuffer* RenderGraph::resourceRenderbuffer(uint32_t resource) const {
+    const auto& entry = _resources[resource];
+    return entry.imported ? nullptr : _physical[entry.physical].renderbuffer.get();
+}
+
+const Texture2D& RenderGraph::texture(RenderGraphTexture texture) const {
+#ifdef DEBUG
+    if (texture.index >= _resources.size()) {
+        throw std::runtime_error{"[RenderGraph::texture] Invalid texture handle"};
+    }
+
+    const auto& resource = _resources[texture.index];
+    if (_dirty || (!resource.imported && resource.physical == ~0u)) {
+        throw std::runtime_error{"[RenderGraph::texture] Texture has no storage; is it used by a surviving pass? " + resource.name};
+    }
+
+    if (resourceRenderbuffer(texture.index)) {
+        throw std::runtime_error{"[RenderGraph::texture] Texture is never read by a pass, so it has no sampleable storage: " + resource.name};
+    }
+#endif
+
+    return resourceTexture(texture.index);
+}
+
+std::vector<std::string> RenderGraph::executionOrder() const {
+    std::vector<std::string> names;
+    names.reserve(_order.size());
+    for (uint32_t pass : _order) {
+        names.push_back(_passes[pass].name);
+    }
+    return names;
+}
+
+size_t RenderGraph::memorySize() const {
+    size_t size = 0;
+    for (const auto& physical : _physical) {
+        size += physical.texture ? physical.texture->memorySize() : physical.renderbuffer->memorySize();
+    }
+    return size;
+}
+
+} // namespace tmig::render
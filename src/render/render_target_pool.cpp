@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+#include "tmig/render/render_target_pool.hpp"
+#include "tmig/util/log.hpp"
+
+namespace tmig::render {
+
+RenderTargetPool::Handle::Handle(Handle&& other) noexcept
+    : _target{other._target}
+{
+    other._target = nullptr;
+}
+
+RenderTargetPool::Handle& RenderTargetPool::Handle::operator=(Handle&& other) noexcept {
+    if (this != &other) {
+        release();
+
+        _target = other._target;
+        other._target = nullptr;
+    }
+    return *this;
+}
+
+void RenderTargetPool::Handle::release() {
+    if (_target) {
+        _target->inUse = false;
+    }
+    _target = nullptr;
+}
+
+RenderTargetPool::RenderTargetPool(uint32_t maxIdleFrames) : _maxIdleFrames{maxIdleFrames} {}
+
+RenderTargetPool::Handle RenderTargetPool::acquire(const RenderTargetDesc& desc) {
+#ifdef DEBUG
+    if (desc.width == 0 || desc.height == 0) {
+        throw std::runtime_error{"[RenderTargetPool::acquire] Render targets can't be empty"};
+    }
+#endif
+
+    RenderTarget* target = nullptr;
+    for (auto& candidate : _targets) {
+        if (!candidate->inUse && candidate->desc == desc) {
+            target = candidate.get();
+            break;
+        }
+    }
+
+    if (!target) {
+        auto created = std::make_unique<RenderTarget>();
+        created->desc = desc;
+
+        FramebufferConfig config{
+            .width = desc.width,
+            .height = desc.height,
+            .colorAttachments = {
+                {0, FramebufferAttachment{.texture = &created->texture, .format = desc.format}},
+            },
+            .samples = desc.samples,
+        };
+        if (desc.depthFormat.has_value()) {
+            config.depthAttachment = FramebufferDepthAttachment{
+                .texture = &created->depthTexture,
+                .format = desc.depthFormat.value(),
+            };
+        }
+
+        auto status = created->framebuffer.setup(config);
+        if (status != Framebuffer::Status::COMPLETE) {
+            std::stringstream ss;
+            ss << "[RenderTargetPool::acquire] Failed setting up render target framebuffer: " << status;
+            throw std::runtime_error{ss.str()};
+        }
+
+        util::logMessage(
+            util::LogCategory::ENGINE, util::LogSeverity::INFO,
+            "Created pooled render target %ux%u; %zu targets\n",
+            desc.width, desc.height, _targets.size() + 1
+        );
+
+        target = created.get();
+        _targets.push_back(std::move(created));
+    }
+
+    // Effects set their own sampling state; don't let it leak to the next user
+    target->texture.setSamplerState({
+        .wrapS = TextureWrapMode::CLAMP_TO_EDGE,
+        .wrapT = TextureWrapMode::CLAMP_TO_EDGE,
+    });
+
+    target->inUse = true;
+    target->lastUsedFrame = _frame;
+    return Handle{target};
+}
+
+void RenderTargetPool::beginFrame() {
+    _frame++;
+
+    const auto erased = std::remove_if(_targets.begin(), _targets.end(), [this](const auto& target) {
+        return !target->inUse && _frame - target->lastUsedFrame > _maxIdleFrames;
+    });
+    if (erased != _targets.end()) {
+        util::logMessage(
+            util::LogCategory::ENGINE, util::LogSeverity::INFO,
+            "Deleting %zu idle pooled render targets\n", static_cast<size_t>(_targets.end() - erased)
+        );
+        _targets.erase(erased, _targets.end());
+    }
+}
+
+void RenderTargetPool::trim() {
+    _targets.erase(
+        std::remove_if(_targets.begin(), _targets.end(), [](const auto& target) { return !target->inUse; }),
+        _targets.end()
+    );
+}
+
+size_t RenderTargetPool::inUseCount() const {
+    return static_cast<size_t>(std::count_if(_targets.begin(), _targets.end(), [](const auto& target) {
+        return target->inUse;
+    }));
+}
+
+size_t RenderTargetPool::memorySize() const {
+    size_t size = 0;
+    for (const auto& target : _targets) {
+        size += target->texture.memorySize() + target->depthTexture.memorySize();
+    }
+    return size;
+}
+
+std::shared_ptr<RenderTargetPool> getSharedRenderTargetPool() {
+    static std::weak_ptr<RenderTargetPool> cache;
+
+    if (auto pool = cache.lock()) {
+        return pool;
+    }
+
+    auto pool = std::make_shared<RenderTargetPool>();
+    cache = pool;
+    return pool;
+}
+
+} // namespace tmig::render
@@ -0,0 +1,90 @@
+#include <stdexcept>
+
+#include "glad/glad.h"
+
+#include "tmig/render/renderbuffer.hpp"
+#include "tmig/render/internal.hpp"
+#include "tmig/util/log.hpp"
+
+namespace tmig::render {
+
+Renderbuffer::Renderbuffer() {
+    glCreateRenderbuffers(1, &_id); glCheckError();
+    util::logMessage(
+        util::LogCategory::ENGINE, util::LogSeverity::INFO,
+        "Created Renderbuffer: %u\n", _id
+    );
+}
+
+Renderbuffer::~Renderbuffer() {
+    if (_id == 0) return;
+
+    util::logMessage(
+        util::LogCategory::ENGINE, util::LogSeverity::INFO,
+        "Deleting Renderbuffer: %u\n", _id
+    );
+    glDeleteRenderbuffers(1, &_id); glCheckError();
+}
+
+Renderbuffer::Renderbuffer(Renderbuffer&& other) noexcept
+    : _id{other._id},
+      _width{other._width},
+      _height{other._height},
+      _samples{other._samples},
+      _format{other._format}
+{
+    other._id = 0;
+    other._width = 0;
+    other._height = 0;
+    other._samples = 1;
+    other._format = TextureFormat::UNDEFINED;
+}
+
+Renderbuffer& Renderbuffer::operator=(Renderbuffer&& other) noexcept {
+    if (this != &other) {
+        if (_id != 0) {
+            glDeleteRenderbuffers(1, &_id);
+        }
+
+        _id = other._id;
+        _width = other._width;
+        _height = other._height;
+        _samples = other._samples;
+        _format = other._format;
+
+        other._id = 0;
+        other._width = 0;
+        other._height = 0;
+        other._samples = 1;
+        other._format = TextureFormat::UNDEFINED;
+    }
+    return *this;
+}
+
+void Renderbuffer::resize(uint32_t width, uint32_t height, TextureFormat format, uint32_t samples) {
+#ifdef DEBUG
+    if (format == TextureFormat::UNDEFINED) {
+        throw std::runtime_error{"[Renderbuffer::resize] TextureFormat::UNDEFINED isn't a valid internal format"};
+    }
+
+    if (Texture2D::isCompressedFormat(format)) {
+        throw std::runtime_error{"[Renderbuffer::resize] Block compressed formats can't be rendered into"};
+    }
+#endif
+
+    _width = width;
+    _height = height;
+    _format = format;
+    _samples = samples > 1 ? samples : 1;
+
+    // A sample count of 0 allocates a single sample renderbuffer
+    glNamedRenderbufferStorageMultisample(
+        _id, _samples > 1 ? static_cast<GLsizei>(_samples) : 0, toInternalFormat(_format), width, height
+    ); glCheckError();
+}
+
+size_t Renderbuffer::memorySize() const {
+    return static_cast<size_t>(_width) * _height * Texture2D::texelSize(_format) * _samples;
+}
+
+} // namespace tmig::render
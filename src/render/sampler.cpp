@@ -0,0 +1,123 @@
+#include <functional>
+#include <unordered_map>
+
+#include "glad/glad.h"
+
+#include "tmig/render/sampler.hpp"
+#include "tmig/render/internal.hpp"
+#include "tmig/util/log.hpp"
+
+// Anisotropic filtering is core only since GL 4.6; EXT_texture_filter_anisotropic uses the same value
+#ifndef GL_TEXTURE_MAX_ANISOTROPY_EXT
+#define GL_TEXTURE_MAX_ANISOTROPY_EXT 0x84FE
+#endif
+
+namespace tmig::render {
+
+bool SamplerState::operator==(const SamplerState& other) const {
+    return wrapS == other.wrapS &&
+        wrapT == other.wrapT &&
+        minFilter == other.minFilter &&
+        magFilter == other.magFilter &&
+        borderColor.x == other.borderColor.x &&
+        borderColor.y == other.borderColor.y &&
+        borderColor.z == other.borderColor.z &&
+        borderColor.w == other.borderColor.w &&
+        maxAnisotropy == other.maxAnisotropy;
+}
+
+size_t SamplerState::hash() const {
+    size_t seed = 0;
+    auto combine = [&seed](size_t value) {
+        seed ^= value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+    };
+
+    combine(static_cast<size_t>(wrapS));
+    combine(static_cast<size_t>(wrapT));
+    combine(static_cast<size_t>(minFilter));
+    combine(static_cast<size_t>(magFilter));
+    for (int i = 0; i < 4; i++) {
+        combine(std::hash<float>{}(borderColor[i]));
+    }
+    combine(std::hash<float>{}(maxAnisotropy));
+    return seed;
+}
+
+Sampler::Sampler(const SamplerState& state) : _state{state} {
+    glCreateSamplers(1, &_id); glCheckError();
+    glSamplerParameteri(_id, GL_TEXTURE_WRAP_S, toGL(state.wrapS)); glCheckError();
+    glSamplerParameteri(_id, GL_TEXTURE_WRAP_T, toGL(state.wrapT)); glCheckError();
+    glSamplerParameteri(_id, GL_TEXTURE_MIN_FILTER, toGL(state.minFilter)); glCheckError();
+    glSamplerParameteri(_id, GL_TEXTURE_MAG_FILTER, toGL(state.magFilter)); glCheckError();
+    glSamplerParameterfv(_id, GL_TEXTURE_BORDER_COLOR, &state.borderColor.x); glCheckError();
+    if (state.maxAnisotropy > 1.0f) {
+        glSamplerParameterf(_id, GL_TEXTURE_MAX_ANISOTROPY_EXT, state.maxAnisotropy); glCheckError();
+    }
+
+    util::logMessage(
+        util::LogCategory::ENGINE, util::LogSeverity::INFO,
+        "Created Sampler: %u\n", _id
+    );
+}
+
+Sampler::~Sampler() {
+    if (_id == 0) return;
+
+    util::logMessage(
+        util::LogCategory::ENGINE, util::LogSeverity::INFO,
+        "Deleting Sampler: %u\n", _id
+    );
+    glDeleteSamplers(1, &_id); glCheckError();
+}
+
+Sampler::Sampler(Sampler&& other) noexcept : _id{other._id}, _state{other._state} {
+    other._id = 0;
+}
+
+Sampler& Sampler::operator=(Sampler&& other) noexcept {
+    if (this != &other) {
+        if (_id != 0) {
+            glDeleteSamplers(1, &_id);
+        }
+
+        _id = other._id;
+        _state = other._state;
+        other._id = 0;
+    }
+    return *this;
+}
+
+void Sampler::bind(uint32_t unit) const {
+    glBindSampler(unit, _id); glCheckError();
+}
+
+void Sampler::unbind(uint32_t unit) {
+    glBindSampler(unit, 0); glCheckError();
+}
+
+std::shared_ptr<const Sampler> getSampler(const SamplerState& state) {
+    struct StateHash {
+        size_t operator()(const SamplerState& s) const { return s.hash(); }
+    };
+    static std::unordered_map<SamplerState, std::weak_ptr<const Sampler>, StateHash> cache;
+
+    auto& cached = cache[state];
+    if (auto sampler = cached.lock()) {
+        return sampler;
+    }
+
+    auto sampler = std::make_shared<const Sampler>(state);
+    cached = sampler;
+    return sampler;
+}
+
+void bindSamplers(uint32_t firstUnit, const std::vector<const Sampler*>& samplers) {
+    std::vector<GLuint> ids;
+    ids.reserve(samplers.size());
+    for (const Sampler* sampler : samplers) {
+        ids.push_back(sampler ? sampler->id() : 0);
+    }
+    glBindSamplers(firstUnit, static_cast<GLsizei>(ids.size()), ids.data()); glCheckError();
+}
+
+} // namespace tmig::render
\ No newline at end of file
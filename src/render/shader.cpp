@@ -1,15 +1,155 @@
+#include <cstdlib>
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <regex>
 
 #include "glad/glad.h"
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
 
 #include "tmig/render/shader.hpp"
 #include "tmig/util/log.hpp"
 #include "tmig/util/file.hpp"
+#include "tmig/util/resources.hpp"
+
+#ifndef GL_SHADER_BINARY_FORMAT_SPIR_V_ARB
+#define GL_SHADER_BINARY_FORMAT_SPIR_V_ARB 0x9551
+#endif
 
 namespace tmig::render {
 
+/// @brief Signature of `glSpecializeShader`, which is not part of the OpenGL 4.4 loader
+typedef void (APIENTRYP PFNGLSPECIALIZESHADERPROC_)(
+    GLuint shader,
+    const GLchar* entryPoint,
+    GLuint numSpecializationConstants,
+    const GLuint* constantIndex,
+    const GLuint* constantValue
+);
+
+/// @brief Returns `glSpecializeShader` if the context supports `ARB_gl_spirv`, `nullptr` otherwise
+static PFNGLSPECIALIZESHADERPROC_ getSpecializeShaderProc() {
+    static bool queried = false;
+    static PFNGLSPECIALIZESHADERPROC_ proc = nullptr;
+    if (queried) return proc;
+    queried = true;
+
+    if (glfwExtensionSupported("GL_ARB_gl_spirv") == GLFW_TRUE) {
+        proc = reinterpret_cast<PFNGLSPECIALIZESHADERPROC_>(glfwGetProcAddress("glSpecializeShaderARB"));
+        if (proc == nullptr) {
+            proc = reinterpret_cast<PFNGLSPECIALIZESHADERPROC_>(glfwGetProcAddress("glSpecializeShader"));
+        }
+    }
+
+    util::logMessage(
+        util::LogCategory::OPENGL, util::LogSeverity::INFO,
+        "ARB_gl_spirv %s\n", proc != nullptr ? "supported" : "not supported"
+    );
+    return proc;
+}
+
+/// @brief Upload a SPIR-V module into `shader` and specialize its `main` entry point
+/// @return Whether specialization succeeded
+static bool specializeSpirvStage(
+    PFNGLSPECIALIZESHADERPROC_ specializeShader,
+    uint32_t shader,
+    const std::string& binary,
+    const std::vector<GLuint>& indices,
+    const std::vector<GLuint>& values,
+    const char* typeName
+) {
+    glShaderBinary(1, &shader, GL_SHADER_BINARY_FORMAT_SPIR_V_ARB, binary.data(), static_cast<GLsizei>(binary.size()));
+    glCheckError();
+    specializeShader(shader, "main", static_cast<GLuint>(indices.size()), indices.data(), values.data());
+
+    int success;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        char infoLog[1024];
+        glGetShaderInfoLog(shader, sizeof(infoLog), nullptr, infoLog);
+        util::logMessage(util::LogCategory::SHADER, util::LogSeverity::ERROR,
+                         "%s specialization failed:\n%s\n", typeName, infoLog);
+        return false;
+    }
+
+    util::logMessage(util::LogCategory::SHADER, util::LogSeverity::INFO,
+                     "%s loaded from SPIR-V\n", typeName);
+    return true;
+}
+
+/// @brief Collect the explicit `layout(location = N)` of every uniform declared outside of a block
+/// @return Whether every such uniform has one, or a `binding` (opaque types never set by name)
+static bool collectUniformLocations(const std::string& source, std::unordered_map<std::string, int>& locations) {
+    // Strip comments and preprocessor lines, leaving declarations separated by ';'
+    std::string code;
+    for (size_t i = 0; i < source.size(); i++) {
+        if (source.compare(i, 2, "//") == 0) {
+            i = source.find('\n', i);
+            if (i == std::string::npos) break;
+        } else if (source.compare(i, 2, "/*") == 0) {
+            i = source.find("*/", i);
+            if (i == std::string::npos) break;
+            i++;
+            continue;
+        }
+        code += source[i];
+    }
+
+    std::istringstream lines{code};
+    std::string line, declarations;
+    while (std::getline(lines, line)) {
+        const size_t first = line.find_first_not_of(" \t");
+        if (first != std::string::npos && line[first] == '#') continue;
+        declarations += line + ' ';
+    }
+
+    static const std::regex uniformRegex{R"(\buniform\b)"};
+    static const std::regex locationRegex{R"(\blocation\s*=\s*(\d+))"};
+    static const std::regex bindingRegex{R"(\bbinding\s*=)"};
+    static const std::regex nameRegex{R"((\w+)\s*(\[[^\]]*\])?\s*$)"};
+
+    std::istringstream statements{declarations};
+    std::string statement;
+    while (std::getline(statements, statement, ';')) {
+        std::smatch uniform;
+        if (!std::regex_search(statement, uniform, uniformRegex)) continue;
+
+        // Uniform blocks are bound by binding point, their members never set by name
+        if (statement.find('{') != std::string::npos) continue;
+
+        const std::string qualifiers = uniform.prefix().str();
+        std::string declaration = uniform.suffix().str();
+        declaration = declaration.substr(0, declaration.find('='));
+
+        std::smatch location, name;
+        if (std::regex_search(qualifiers, location, locationRegex) && std::regex_search(declaration, name, nameRegex)) {
+            locations[name[1].str()] = std::stoi(location[1].str());
+        } else if (!std::regex_search(qualifiers, bindingRegex)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// @brief Convert a `ShaderStage` into an OpenGL shader type
+static GLenum toGL(ShaderStage stage) {
+    switch (stage) {
+    case ShaderStage::VERTEX:   return GL_VERTEX_SHADER;
+    case ShaderStage::FRAGMENT: return GL_FRAGMENT_SHADER;
+    }
+    return GL_VERTEX_SHADER;
+}
+
+/// @brief Readable name of a `ShaderStage`, used for logging
+static const char* toString(ShaderStage stage) {
+    switch (stage) {
+    case ShaderStage::VERTEX:   return "Vertex Shader";
+    case ShaderStage::FRAGMENT: return "Fragment Shader";
+    }
+    return "Unknown Shader";
+}
+
 ShaderProgram::~ShaderProgram() {
     if (_id == 0) return;
 
@@ -23,10 +163,16 @@ ShaderProgram::~ShaderProgram() {
 ShaderProgram::ShaderProgram(ShaderProgram&& other) noexcept
     : _id{other._id},
       _linked{other._linked},
-      uniformLocationCache{std::move(other.uniformLocationCache)}
+      _separable{other._separable},
+      _stage{other._stage},
+      uniformLocationCache{std::move(other.uniformLocationCache)},
+      _explicitLocations{other._explicitLocations},
+      explicitUniformLocations{std::move(other.explicitUniformLocations)}
 {
     other._id = 0;
     other._linked = false;
+    other._separable = false;
+    other._explicitLocations = false;
 }
 
 ShaderProgram& ShaderProgram::operator=(ShaderProgram&& other) noexcept {
@@ -37,40 +183,23 @@ ShaderProgram& ShaderProgram::operator=(ShaderProgram&& other) noexcept {
 
         _id = other._id;
         _linked = other._linked;
+        _separable = other._separable;
+        _stage = other._stage;
         uniformLocationCache = std::move(other.uniformLocationCache);
+        _explicitLocations = other._explicitLocations;
+        explicitUniformLocations = std::move(other.explicitUniformLocations);
 
         other._id = 0;
         other._linked = false;
+        other._separable = false;
+        other._explicitLocations = false;
     }
     return *this;
 }
 
 bool ShaderProgram::compileFromFiles(const std::string& vertexPath, const std::string& fragmentPath) {
     // Delete old program if any
-    if (_id != 0) {
-        util::logMessage(
-            util::LogCategory::ENGINE, util::LogSeverity::INFO,
-            "Deleting shader program: %u\n", _id
-        );
-        glDeleteProgram(_id);
-        _id = 0;
-        _linked = false;
-    }
-
-    // Create new program
-    _id = glCreateProgram();
-    if (_id == 0) {
-        util::logMessage(
-            util::LogCategory::OPENGL, util::LogSeverity::ERROR,
-            "Failed to create shader program\n"
-        );
-        return false;
-    }
-
-    util::logMessage(
-        util::LogCategory::OPENGL, util::LogSeverity::INFO,
-        "Created shader: %u\n", _id
-    );
+    release();
 
     // Attempt to read files
     std::string vertexCode, fragmentCode;
@@ -82,8 +211,15 @@ bool ShaderProgram::compileFromFiles(const std::string& vertexPath, const std::s
         return false;
     }
 
-    const char* vCode = vertexCode.c_str();
-    const char* fCode = fragmentCode.c_str();
+    return compileFromSources(vertexCode, fragmentCode);
+}
+
+bool ShaderProgram::compileFromSources(const std::string& vertexSource, const std::string& fragmentSource) {
+    // Delete old program if any
+    release();
+
+    const char* vCode = vertexSource.c_str();
+    const char* fCode = fragmentSource.c_str();
 
     uint32_t vertexShader   = glCreateShader(GL_VERTEX_SHADER);
     uint32_t fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
@@ -101,33 +237,104 @@ bool ShaderProgram::compileFromFiles(const std::string& vertexPath, const std::s
         return false;
     }
 
-    // Attach shaders to program and link
-    glAttachShader(_id, vertexShader);
-    glAttachShader(_id, fragmentShader);
-    glLinkProgram(_id);
+    return linkProgram(vertexShader, fragmentShader);
+}
 
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
+bool ShaderProgram::compilePrecompiled(
+    const std::string& vertexPath,
+    const std::string& fragmentPath,
+    const std::vector<SpecializationConstant>& constants
+) {
+    // Delete old program if any
+    release();
 
-    // Check link status
-    int linkStatus;
-    glGetProgramiv(_id, GL_LINK_STATUS, &linkStatus);
-    if (!linkStatus) {
-        char infoLog[1024];
-        glGetProgramInfoLog(_id, sizeof(infoLog), nullptr, infoLog);
-        util::logMessage(
-            util::LogCategory::SHADER, util::LogSeverity::ERROR,
-            "Program linking failed:\n%s\n", infoLog
-        );
+    std::string vertexCode, fragmentCode;
+    try {
+        vertexCode   = util::readResource(vertexPath);
+        fragmentCode = util::readResource(fragmentPath);
+    } catch (const std::exception& e) {
+        util::logMessage(util::LogCategory::ENGINE, util::LogSeverity::ERROR, "%s\n", e.what());
         return false;
     }
 
-    _linked = true;
-    util::logMessage(
-        util::LogCategory::ENGINE, util::LogSeverity::INFO,
-        "Shader program %u linked\n", _id
+    std::unordered_map<std::string, int> locations;
+    uint32_t vertexShader = loadSpirvShader(
+        GL_VERTEX_SHADER, vertexPath, vertexCode, constants, locations, "Vertex Shader"
+    );
+    uint32_t fragmentShader = vertexShader == 0 ? 0 : loadSpirvShader(
+        GL_FRAGMENT_SHADER, fragmentPath, fragmentCode, constants, locations, "Fragment Shader"
+    );
+
+    if (vertexShader != 0 && fragmentShader != 0) {
+        if (!linkProgram(vertexShader, fragmentShader)) return false;
+
+        setExplicitUniformLocations(std::move(locations));
+        return true;
+    }
+    if (vertexShader != 0) glDeleteShader(vertexShader);
+
+    // Fallback: compile the GLSL sources, passing specialization constants as defines
+    return compileFromSources(
+        injectSpecializationDefines(vertexCode, constants),
+        injectSpecializationDefines(fragmentCode, constants)
     );
-    return true;
+}
+
+bool ShaderProgram::compileStagePrecompiled(
+    ShaderStage stage,
+    const std::string& path,
+    const std::vector<SpecializationConstant>& constants
+) {
+    // Delete old program if any
+    release();
+
+    std::string code;
+    try {
+        code = util::readResource(path);
+    } catch (const std::exception& e) {
+        util::logMessage(util::LogCategory::ENGINE, util::LogSeverity::ERROR, "%s\n", e.what());
+        return false;
+    }
+
+    std::unordered_map<std::string, int> locations;
+    uint32_t shader = loadSpirvShader(toGL(stage), path, code, constants, locations, toString(stage));
+    if (shader != 0) {
+        if (!linkStageProgram(stage, shader)) return false;
+
+        setExplicitUniformLocations(std::move(locations));
+        return true;
+    }
+
+    // Fallback: compile the GLSL source, passing specialization constants as defines
+    return compileStageFromSource(stage, injectSpecializationDefines(code, constants));
+}
+
+bool ShaderProgram::compileStageFromFile(ShaderStage stage, const std::string& path) {
+    std::string code;
+    try {
+        code = util::readFileContent(path);
+    } catch (const std::exception& e) {
+        util::logMessage(util::LogCategory::ENGINE, util::LogSeverity::ERROR, "%s\n", e.what());
+        return false;
+    }
+
+    return compileStageFromSource(stage, code);
+}
+
+bool ShaderProgram::compileStageFromSource(ShaderStage stage, const std::string& source) {
+    // Delete old program if any
+    release();
+
+    // Compile the stage on its own so it can be linked as a separable program
+    uint32_t shader = glCreateShader(toGL(stage));
+    const char* code = source.c_str();
+    glShaderSource(shader, 1, &code, nullptr);
+    if (!compileShaderStage(shader, toString(stage))) {
+        glDeleteShader(shader);
+        return false;
+    }
+
+    return linkStageProgram(stage, shader);
 }
 
 void ShaderProgram::use() const {
@@ -193,6 +400,125 @@ void ShaderProgram::setTexture(const std::string& name, const Texture2D& texture
     setInt(name, static_cast<int>(unit));
 }
 
+void ShaderProgram::setTexture(const std::string& name, const Texture2DArray& texture, uint32_t unit) {
+    if (!_linked) return;
+
+    texture.bind(unit);
+    setInt(name, static_cast<int>(unit));
+}
+
+bool ShaderProgram::linkProgram(uint32_t vertexShader, uint32_t fragmentShader) {
+    // Create new program
+    _id = glCreateProgram();
+    if (_id == 0) {
+        util::logMessage(
+            util::LogCategory::OPENGL, util::LogSeverity::ERROR,
+            "Failed to create shader program\n"
+        );
+        glDeleteShader(vertexShader);
+        glDeleteShader(fragmentShader);
+        return false;
+    }
+
+    util::logMessage(
+        util::LogCategory::OPENGL, util::LogSeverity::INFO,
+        "Created shader: %u\n", _id
+    );
+
+    // Attach shaders to program and link
+    glAttachShader(_id, vertexShader);
+    glAttachShader(_id, fragmentShader);
+    glLinkProgram(_id);
+
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    // Check link status
+    int linkStatus;
+    glGetProgramiv(_id, GL_LINK_STATUS, &linkStatus);
+    if (!linkStatus) {
+        char infoLog[1024];
+        glGetProgramInfoLog(_id, sizeof(infoLog), nullptr, infoLog);
+        util::logMessage(
+            util::LogCategory::SHADER, util::LogSeverity::ERROR,
+            "Program linking failed:\n%s\n", infoLog
+        );
+        release();
+        return false;
+    }
+
+    _linked = true;
+    util::logMessage(
+        util::LogCategory::ENGINE, util::LogSeverity::INFO,
+        "Shader program %u linked\n", _id
+    );
+    return true;
+}
+
+bool ShaderProgram::linkStageProgram(ShaderStage stage, uint32_t shader) {
+    _id = glCreateProgram();
+    if (_id == 0) {
+        util::logMessage(
+            util::LogCategory::OPENGL, util::LogSeverity::ERROR,
+            "Failed to create shader program\n"
+        );
+        glDeleteShader(shader);
+        return false;
+    }
+
+    glProgramParameteri(_id, GL_PROGRAM_SEPARABLE, GL_TRUE); glCheckError();
+    glAttachShader(_id, shader);
+    glLinkProgram(_id);
+    glDetachShader(_id, shader);
+    glDeleteShader(shader);
+
+    // Check link status
+    int linkStatus;
+    glGetProgramiv(_id, GL_LINK_STATUS, &linkStatus);
+    if (!linkStatus) {
+        char infoLog[1024];
+        glGetProgramInfoLog(_id, sizeof(infoLog), nullptr, infoLog);
+        util::logMessage(
+            util::LogCategory::SHADER, util::LogSeverity::ERROR,
+            "Separable program linking failed:\n%s\n", infoLog
+        );
+        release();
+        return false;
+    }
+
+    _linked = true;
+    _separable = true;
+    _stage = stage;
+    util::logMessage(
+        util::LogCategory::ENGINE, util::LogSeverity::INFO,
+        "Separable %s program %u linked\n", toString(stage), _id
+    );
+    return true;
+}
+
+void ShaderProgram::release() {
+    if (_id != 0) {
+        util::logMessage(
+            util::LogCategory::ENGINE, util::LogSeverity::INFO,
+            "Deleting shader program: %u\n", _id
+        );
+        glDeleteProgram(_id);
+        _id = 0;
+    }
+
+    _linked = false;
+    _separable = false;
+    uniformLocationCache.clear();
+    _explicitLocations = false;
+    explicitUniformLocations.clear();
+}
+
+void ShaderProgram::setExplicitUniformLocations(std::unordered_map<std::string, int> locations) {
+    explicitUniformLocations = std::move(locations);
+    _explicitLocations = true;
+    uniformLocationCache.clear();
+}
+
 int ShaderProgram::getUniformLocation(const std::string& name) {
     if (!_linked) return 0;
 
@@ -201,11 +527,97 @@ int ShaderProgram::getUniformLocation(const std::string& name) {
         return it->second;
     }
 
-    int location = glGetUniformLocation(_id, name.c_str());
+    int location = _explicitLocations
+        ? getExplicitUniformLocation(name)
+        : glGetUniformLocation(_id, name.c_str());
     uniformLocationCache[name] = location;
     return location;
 }
 
+int ShaderProgram::getExplicitUniformLocation(const std::string& name) const {
+    auto it = explicitUniformLocations.find(name);
+    if (it != explicitUniformLocations.end()) {
+        return it->second;
+    }
+
+    // Elements of an array, e.g. "weights[3]", take consecutive locations from the array's
+    const size_t bracket = name.find('[');
+    if (bracket == std::string::npos || name.back() != ']') return -1;
+
+    it = explicitUniformLocations.find(name.substr(0, bracket));
+    if (it == explicitUniformLocations.end()) return -1;
+
+    return it->second + static_cast<int>(std::strtol(name.c_str() + bracket + 1, nullptr, 10));
+}
+
+uint32_t ShaderProgram::loadSpirvShader(
+    uint32_t type,
+    const std::string& path,
+    const std::string& source,
+    const std::vector<SpecializationConstant>& constants,
+    std::unordered_map<std::string, int>& locations,
+    const char* typeName
+) {
+    const auto binaryPath = util::getSpirvPath(path);
+    if (binaryPath.empty()) return 0;
+
+    const auto specializeShader = getSpecializeShaderProc();
+    if (specializeShader == nullptr) return 0;
+
+    if (!collectUniformLocations(source, locations)) {
+        util::logMessage(
+            util::LogCategory::SHADER, util::LogSeverity::INFO,
+            "%s has uniforms without an explicit location, compiling GLSL: %s\n", typeName, path.c_str()
+        );
+        return 0;
+    }
+
+    std::string binary;
+    try {
+        binary = util::readFileContent(binaryPath);
+    } catch (const std::exception& e) {
+        util::logMessage(util::LogCategory::ENGINE, util::LogSeverity::WARNING, "%s\n", e.what());
+        return 0;
+    }
+
+    std::vector<GLuint> indices, values;
+    for (const auto& constant : constants) {
+        indices.push_back(constant.id);
+        values.push_back(static_cast<GLuint>(constant.value));
+    }
+
+    uint32_t shader = glCreateShader(type);
+    if (!specializeSpirvStage(specializeShader, shader, binary, indices, values, typeName)) {
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+std::string ShaderProgram::injectSpecializationDefines(
+    const std::string& source,
+    const std::vector<SpecializationConstant>& constants
+) {
+    if (constants.empty()) return source;
+
+    std::ostringstream defines;
+    for (const auto& constant : constants) {
+        defines << "#define TMIG_SPECIALIZATION_" << constant.id << " " << constant.value << "\n";
+    }
+
+    // `#version` must stay the first directive, so defines go on the line after it
+    size_t insertAt = 0;
+    const size_t versionPos = source.find("#version");
+    if (versionPos != std::string::npos) {
+        const size_t lineEnd = source.find('\n', versionPos);
+        insertAt = lineEnd == std::string::npos ? source.size() : lineEnd + 1;
+    }
+
+    std::string result = source;
+    result.insert(insertAt, defines.str());
+    return result;
+}
+
 bool ShaderProgram::compileShaderStage(uint32_t shader, const char* typeName) {
     glCompileShader(shader);
 
@@ -1,16 +1,34 @@
 #include <stdexcept>
+#include <algorithm>
 #include <cassert>
+#include <vector>
 
 #include "stb/stb_image.h"
 #include "glad/glad.h"
 
 #include "tmig/render/texture2D.hpp"
+#include "tmig/render/internal.hpp"
 #include "tmig/util/log.hpp"
+#include "tmig/util/half.hpp"
+
+// S3TC constants aren't part of the generated GL 4.4 core loader; they come from EXT_texture_compression_s3tc
+// and EXT_texture_sRGB, which every desktop driver exposes
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT 0x8C4D
+#endif
+#ifndef GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT 0x8C4F
+#endif
 
 namespace tmig::render {
 
-/// @brief Convert a `TextureFormat` into a sized OpenGL internal format
-static GLenum toInternalFormat(TextureFormat format) {
+uint32_t toInternalFormat(TextureFormat format) {
     switch (format) {
     case TextureFormat::R8:                return GL_R8;
     case TextureFormat::RG8:               return GL_RG8;
@@ -27,9 +45,20 @@ static GLenum toInternalFormat(TextureFormat format) {
     case TextureFormat::RGB32F:            return GL_RGB32F;
     case TextureFormat::RGBA32F:           return GL_RGBA32F;
 
+    case TextureFormat::R11F_G11F_B10F:    return GL_R11F_G11F_B10F;
+
     case TextureFormat::SRGB8:             return GL_SRGB8;
     case TextureFormat::SRGBA8:            return GL_SRGB8_ALPHA8;
 
+    case TextureFormat::BC1:               return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+    case TextureFormat::BC1_SRGB:          return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT;
+    case TextureFormat::BC3:               return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    case TextureFormat::BC3_SRGB:          return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+    case TextureFormat::BC4:               return GL_COMPRESSED_RED_RGTC1;
+    case TextureFormat::BC5:               return GL_COMPRESSED_RG_RGTC2;
+    case TextureFormat::BC7:               return GL_COMPRESSED_RGBA_BPTC_UNORM;
+    case TextureFormat::BC7_SRGB:          return GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
+
     case TextureFormat::DEPTH16:           return GL_DEPTH_COMPONENT16;
     case TextureFormat::DEPTH24:           return GL_DEPTH_COMPONENT24;
     case TextureFormat::DEPTH32F:          return GL_DEPTH_COMPONENT32F;
@@ -44,8 +73,7 @@ static GLenum toInternalFormat(TextureFormat format) {
     return 0;
 }
 
-/// @brief Convert a `TextureFormat` into a OpenGL data format
-static GLenum toFormat(TextureFormat format) {
+uint32_t toFormat(TextureFormat format) {
     switch (format) {
     case TextureFormat::R8:
     case TextureFormat::R16F:
@@ -60,6 +88,7 @@ static GLenum toFormat(TextureFormat format) {
     case TextureFormat::RGB8:
     case TextureFormat::RGB16F:
     case TextureFormat::RGB32F:
+    case TextureFormat::R11F_G11F_B10F:
     case TextureFormat::SRGB8:
         return GL_RGB;
 
@@ -81,14 +110,22 @@ static GLenum toFormat(TextureFormat format) {
     case TextureFormat::DEPTH32F_STENCIL8:
         return GL_DEPTH_STENCIL;
 
+    // Compressed data is uploaded with glCompressedTextureSubImage2D, which takes no format/type
+    case TextureFormat::BC1:
+    case TextureFormat::BC1_SRGB:
+    case TextureFormat::BC3:
+    case TextureFormat::BC3_SRGB:
+    case TextureFormat::BC4:
+    case TextureFormat::BC5:
+    case TextureFormat::BC7:
+    case TextureFormat::BC7_SRGB:
     case TextureFormat::UNDEFINED:
         return 0;
     }
     return 0;
 }
 
-/// @brief Convert a `TextureFormat` into a OpenGL data type
-static GLenum toType(TextureFormat format) {
+uint32_t toType(TextureFormat format) {
     switch (format) {
     case TextureFormat::R8:
     case TextureFormat::RG8:
@@ -112,6 +149,9 @@ static GLenum toType(TextureFormat format) {
     case TextureFormat::DEPTH32F:
         return GL_FLOAT;
 
+    case TextureFormat::R11F_G11F_B10F:
+        return GL_UNSIGNED_INT_10F_11F_11F_REV;
+
     case TextureFormat::DEPTH16:
         return GL_UNSIGNED_SHORT;
 
@@ -124,12 +164,28 @@ static GLenum toType(TextureFormat format) {
     case TextureFormat::DEPTH32F_STENCIL8:
         return GL_FLOAT_32_UNSIGNED_INT_24_8_REV;
 
+    case TextureFormat::BC1:
+    case TextureFormat::BC1_SRGB:
+    case TextureFormat::BC3:
+    case TextureFormat::BC3_SRGB:
+    case TextureFormat::BC4:
+    case TextureFormat::BC5:
+    case TextureFormat::BC7:
+    case TextureFormat::BC7_SRGB:
     case TextureFormat::UNDEFINED:
         return 0;
     }
     return 0;
 }
 
+TextureFormat sourceFormatFor(TextureFormat format) {
+    switch (format) {
+        case TextureFormat::SRGB8:  return TextureFormat::RGB8;
+        case TextureFormat::SRGBA8: return TextureFormat::RGBA8;
+        default:                    return format;
+    }
+}
+
 inline const char* toString(TextureFormat format) {
     switch (format) {
     case TextureFormat::R8:                return "R8";
@@ -147,9 +203,20 @@ inline const char* toString(TextureFormat format) {
     case TextureFormat::RGB32F:            return "RGB32F";
     case TextureFormat::RGBA32F:           return "RGBA32F";
 
+    case TextureFormat::R11F_G11F_B10F:    return "R11F_G11F_B10F";
+
     case TextureFormat::SRGB8:             return "SRGB8";
     case TextureFormat::SRGBA8:            return "SRGB8_ALPHA8";
 
+    case TextureFormat::BC1:               return "BC1";
+    case TextureFormat::BC1_SRGB:          return "BC1_SRGB";
+    case TextureFormat::BC3:               return "BC3";
+    case TextureFormat::BC3_SRGB:          return "BC3_SRGB";
+    case TextureFormat::BC4:               return "BC4";
+    case TextureFormat::BC5:               return "BC5";
+    case TextureFormat::BC7:               return "BC7";
+    case TextureFormat::BC7_SRGB:          return "BC7_SRGB";
+
     case TextureFormat::DEPTH16:           return "DEPTH16";
     case TextureFormat::DEPTH24:           return "DEPTH24";
     case TextureFormat::DEPTH32F:          return "DEPTH32F";
@@ -164,7 +231,7 @@ inline const char* toString(TextureFormat format) {
     return "Unknown";
 }
 
-static GLenum toGL(TextureWrapMode wrap) {
+uint32_t toGL(TextureWrapMode wrap) {
     switch (wrap) {
         case TextureWrapMode::REPEAT:          return GL_REPEAT;
         case TextureWrapMode::MIRRORED_REPEAT: return GL_MIRRORED_REPEAT;
@@ -174,7 +241,7 @@ static GLenum toGL(TextureWrapMode wrap) {
     }
 }
 
-static GLenum toGL(TextureMinFilter filter) {
+uint32_t toGL(TextureMinFilter filter) {
     switch (filter) {
         case TextureMinFilter::NEAREST:                return GL_NEAREST;
         case TextureMinFilter::LINEAR:                 return GL_LINEAR;
@@ -186,7 +253,7 @@ static GLenum toGL(TextureMinFilter filter) {
     }
 }
 
-static GLenum toGL(TextureMagFilter filter) {
+uint32_t toGL(TextureMagFilter filter) {
     switch (filter) {
         case TextureMagFilter::NEAREST: return GL_NEAREST;
         case TextureMagFilter::LINEAR:  return GL_LINEAR;
@@ -194,9 +261,16 @@ static GLenum toGL(TextureMagFilter filter) {
     }
 }
 
+uint32_t mipLevelCount(uint32_t width, uint32_t height) {
+    uint32_t levels = 1;
+    for (uint32_t size = std::max(width, height); size > 1; size >>= 1) {
+        levels++;
+    }
+    return levels;
+}
+
 Texture2D::Texture2D() {
     glCreateTextures(GL_TEXTURE_2D, 1, &_id); glCheckError();
-    applySamplerState();
     util::logMessage(
         util::LogCategory::ENGINE, util::LogSeverity::INFO,
         "Created Texture2D: %u\n", _id
@@ -217,17 +291,18 @@ Texture2D::Texture2D(Texture2D&& other) noexcept
     : _id{other._id},
       _width{other._width},
       _height{other._height},
+      _levels{other._levels},
+      _samples{other._samples},
       _hasMipmaps{other._hasMipmaps},
       _internalFormat{other._internalFormat},
-      _wrapS{other._wrapS},
-      _wrapT{other._wrapT},
-      _minFilter{other._minFilter},
-      _magFilter{other._magFilter},
-      _borderColor{other._borderColor}
+      _samplerState{other._samplerState},
+      _sampler{std::move(other._sampler)}
 {
     other._id = 0;
     other._width = 0;
     other._height = 0;
+    other._levels = 1;
+    other._samples = 1;
     other._hasMipmaps = false;
     other._internalFormat = TextureFormat::UNDEFINED;
 }
@@ -241,17 +316,18 @@ Texture2D& Texture2D::operator=(Texture2D&& other) noexcept {
         _id = other._id;
         _width = other._width;
         _height = other._height;
+        _levels = other._levels;
+        _samples = other._samples;
         _hasMipmaps = other._hasMipmaps;
         _internalFormat = other._internalFormat;
-        _wrapS = other._wrapS;
-        _wrapT = other._wrapT;
-        _minFilter = other._minFilter;
-        _magFilter = other._magFilter;
-        _borderColor = other._borderColor;
+        _samplerState = other._samplerState;
+        _sampler = std::move(other._sampler);
 
         other._id = 0;
         other._width = 0;
         other._height = 0;
+        other._levels = 1;
+        other._samples = 1;
         other._hasMipmaps = false;
         other._internalFormat = TextureFormat::UNDEFINED;
     }
@@ -259,7 +335,37 @@ Texture2D& Texture2D::operator=(Texture2D&& other) noexcept {
 }
 
 bool Texture2D::loadFromFile(const std::string& filename, bool flipY) {
-    stbi_set_flip_vertically_on_load(flipY);
+    return loadFromFile(filename, TextureLoadOptions{.flipY = flipY});
+}
+
+bool Texture2D::loadFromFile(const std::string& filename, const TextureLoadOptions& options) {
+    const std::string ktx2Extension = ".ktx2";
+    if (filename.size() >= ktx2Extension.size() &&
+        filename.compare(filename.size() - ktx2Extension.size(), ktx2Extension.size(), ktx2Extension) == 0) {
+        return loadFromKtx2(filename);
+    }
+
+    const std::string bakedPath = getBakedTexturePath(filename, options);
+    if (!bakedPath.empty() && loadFromBaked(bakedPath)) {
+        return true;
+    }
+
+    const bool loaded = stbi_is_hdr(filename.c_str())
+        ? loadFromHdr(filename, options)
+        : loadFromImage(filename, options);
+
+    if (loaded && !bakedPath.empty() && !saveBaked(bakedPath)) {
+        util::logMessage(
+            util::LogCategory::ENGINE, util::LogSeverity::WARNING,
+            "[Texture2D::loadFromFile] Failed to bake %s into %s\n", filename.c_str(), bakedPath.c_str()
+        );
+    }
+    return loaded;
+}
+
+bool Texture2D::loadFromImage(const std::string& filename, const TextureLoadOptions& options) {
+    // Thread-local, so loading from several threads (e.g. `TextureLoader` workers) doesn't race
+    stbi_set_flip_vertically_on_load_thread(options.flipY);
     int w, h, channels;
     unsigned char* data = stbi_load(filename.c_str(), &w, &h, &channels, 0);
     if (!data) return false;
@@ -276,13 +382,74 @@ bool Texture2D::loadFromFile(const std::string& filename, bool flipY) {
             return false;
     }
 
-    resize(w, h, format);
+    TextureFormat internalFormat = format;
+    if (options.srgb && format == TextureFormat::RGB8) internalFormat = TextureFormat::SRGB8;
+    if (options.srgb && format == TextureFormat::RGBA8) internalFormat = TextureFormat::SRGBA8;
+
+    resize(w, h, internalFormat, options.mipmaps ? mipLevelCount(w, h) : 1);
+
+    // Decoded rows are tightly packed, which breaks the default 4-byte row alignment for RGB images
+    GLint previousAlignment = 4;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &previousAlignment);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
     setData(data, format);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, previousAlignment);
     stbi_image_free(data);
+
+    if (options.mipmaps) {
+        generateMipmaps();
+    }
     return true;
 }
 
-void Texture2D::setData(const void* data, TextureFormat sourceFormat) {
+bool Texture2D::loadFromHdr(const std::string& filename, const TextureLoadOptions& options) {
+    stbi_set_flip_vertically_on_load_thread(options.flipY);
+    int w, h, channels;
+    float* data = stbi_loadf(filename.c_str(), &w, &h, &channels, 0);
+    if (!data) return false;
+
+    const size_t pixelCount = static_cast<size_t>(w) * h;
+    TextureFormat internalFormat;
+    TextureFormat sourceFormat;
+    std::vector<uint32_t> packed;
+    std::vector<uint16_t> halves;
+
+    if (channels == 3 && !options.hdrFullPrecision) {
+        // 4 bytes per texel instead of 8 (RGB16F is padded to RGBA by most drivers)
+        internalFormat = sourceFormat = TextureFormat::R11F_G11F_B10F;
+        packed.resize(pixelCount);
+        util::packR11G11B10F(data, packed.data(), pixelCount);
+    } else {
+        switch (channels) {
+            case 1: internalFormat = sourceFormat = TextureFormat::R16F; break;
+            case 2: internalFormat = sourceFormat = TextureFormat::RG16F; break;
+            case 3: internalFormat = sourceFormat = TextureFormat::RGB16F; break;
+            case 4: internalFormat = sourceFormat = TextureFormat::RGBA16F; break;
+            default:
+                stbi_image_free(data);
+                return false;
+        }
+        halves.resize(pixelCount * channels);
+        util::floatToHalf(data, halves.data(), halves.size());
+    }
+    stbi_image_free(data);
+
+    resize(w, h, internalFormat, options.mipmaps ? mipLevelCount(w, h) : 1);
+
+    // RGB16F rows are 6 bytes per texel, which breaks the default 4-byte row alignment
+    GLint previousAlignment = 4;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &previousAlignment);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    setData(packed.empty() ? static_cast<const void*>(halves.data()) : packed.data(), sourceFormat);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, previousAlignment);
+
+    if (options.mipmaps) {
+        generateMipmaps();
+    }
+    return true;
+}
+
+void Texture2D::setData(const void* data, TextureFormat sourceFormat, uint32_t level) {
 #ifdef DEBUG
     // Validate that texture has been properly initialized
     if (_width == 0 || _height == 0 || _internalFormat == TextureFormat::UNDEFINED) {
@@ -297,11 +464,106 @@ void Texture2D::setData(const void* data, TextureFormat sourceFormat) {
     if (!Texture2D::isFormatCompatible(_internalFormat, sourceFormat)) {
         throw std::runtime_error("[Texture2D::setData] Incompatible source/internal texture format");
     }
+
+    if (level >= _levels) {
+        throw std::runtime_error{"[Texture2D::setData] Mip level out of range"};
+    }
+
+    if (_samples > 1) {
+        throw std::runtime_error{"[Texture2D::setData] Multisample textures can't be uploaded to"};
+    }
+#endif
+
+    const uint32_t width = std::max(_width >> level, 1u);
+    const uint32_t height = std::max(_height >> level, 1u);
+
+    // A new base level makes the generated mips stale
+    if (level == 0) _hasMipmaps = false;
+
+    if (isCompressedFormat(sourceFormat)) {
+        const auto size = static_cast<GLsizei>(compressedImageSize(sourceFormat, width, height));
+        glCompressedTextureSubImage2D(
+            _id, level, 0, 0, width, height, toInternalFormat(sourceFormat), size, data
+        ); glCheckError();
+        return;
+    }
+
+    const auto format = toFormat(sourceFormat);
+    const auto type = toType(sourceFormat);
+    glTextureSubImage2D(_id, level, 0, 0, width, height, format, type, data); glCheckError();
+}
+
+void Texture2D::setSubData(const void* data, TextureFormat sourceFormat, const TextureRegion& region) {
+    const uint32_t levelWidth = std::max(_width >> region.level, 1u);
+    const uint32_t levelHeight = std::max(_height >> region.level, 1u);
+    const uint32_t width = region.width != 0 ? region.width : levelWidth - std::min(region.x, levelWidth);
+    const uint32_t height = region.height != 0 ? region.height : levelHeight - std::min(region.y, levelHeight);
+
+#ifdef DEBUG
+    if (_width == 0 || _height == 0 || _internalFormat == TextureFormat::UNDEFINED) {
+        throw std::runtime_error{"[Texture2D::setSubData] Texture is not initialized"};
+    }
+
+    if (_samples > 1) {
+        throw std::runtime_error{"[Texture2D::setSubData] Multisample textures can't be uploaded to"};
+    }
+
+    if (sourceFormat == TextureFormat::UNDEFINED) {
+        throw std::runtime_error{"[Texture2D::setSubData] TextureFormat::UNDEFINED isn't a valid source format"};
+    }
+
+    if (!Texture2D::isFormatCompatible(_internalFormat, sourceFormat)) {
+        throw std::runtime_error{"[Texture2D::setSubData] Incompatible source/internal texture format"};
+    }
+
+    if (region.level >= _levels) {
+        throw std::runtime_error{"[Texture2D::setSubData] Mip level out of range"};
+    }
+
+    if (region.x + width > levelWidth || region.y + height > levelHeight) {
+        throw std::runtime_error{"[Texture2D::setSubData] Region exceeds the mip level"};
+    }
+
+    if (isCompressedFormat(sourceFormat)) {
+        const bool alignedX = region.x % 4 == 0 && (width % 4 == 0 || region.x + width == levelWidth);
+        const bool alignedY = region.y % 4 == 0 && (height % 4 == 0 || region.y + height == levelHeight);
+        if (!alignedX || !alignedY || region.rowPitch != 0) {
+            throw std::runtime_error{"[Texture2D::setSubData] Compressed regions must be block aligned and tightly packed"};
+        }
+    } else if (region.rowPitch != 0 && region.rowPitch % texelSize(sourceFormat) != 0) {
+        throw std::runtime_error{"[Texture2D::setSubData] Row pitch must be a multiple of the pixel size"};
+    }
 #endif
 
+    if (width == 0 || height == 0) return;
+
+    // A new base level makes the generated mips stale
+    if (region.level == 0) _hasMipmaps = false;
+
+    if (isCompressedFormat(sourceFormat)) {
+        const auto size = static_cast<GLsizei>(compressedImageSize(sourceFormat, width, height));
+        glCompressedTextureSubImage2D(
+            _id, region.level, region.x, region.y, width, height, toInternalFormat(sourceFormat), size, data
+        ); glCheckError();
+        return;
+    }
+
+    // Rows are described by their pitch instead of the default 4-byte alignment
+    GLint previousAlignment = 4;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &previousAlignment);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    if (region.rowPitch != 0) {
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, static_cast<GLint>(region.rowPitch / texelSize(sourceFormat)));
+    }
+
     const auto format = toFormat(sourceFormat);
     const auto type = toType(sourceFormat);
-    glTextureSubImage2D(_id, 0, 0, 0, _width, _height, format, type, data); glCheckError();
+    glTextureSubImage2D(_id, region.level, region.x, region.y, width, height, format, type, data); glCheckError();
+
+    if (region.rowPitch != 0) {
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, previousAlignment);
 }
 
 void Texture2D::recreateTextureObject() {
@@ -309,76 +571,170 @@ void Texture2D::recreateTextureObject() {
         glDeleteTextures(1, &_id); glCheckError();
         _id = 0;
     }
-    glCreateTextures(GL_TEXTURE_2D, 1, &_id); glCheckError();
-    applySamplerState();
+    glCreateTextures(_samples > 1 ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D, 1, &_id); glCheckError();
 }
 
-void Texture2D::applySamplerState() const {
-    if (_id == 0) return;
-    glTextureParameteri(_id, GL_TEXTURE_WRAP_S, toGL(_wrapS)); glCheckError();
-    glTextureParameteri(_id, GL_TEXTURE_WRAP_T, toGL(_wrapT)); glCheckError();
-    glTextureParameteri(_id, GL_TEXTURE_MIN_FILTER, toGL(_minFilter)); glCheckError();
-    glTextureParameteri(_id, GL_TEXTURE_MAG_FILTER, toGL(_magFilter)); glCheckError();
-    glTextureParameterfv(_id, GL_TEXTURE_BORDER_COLOR, &_borderColor.x); glCheckError();
-}
-
-void Texture2D::resize(uint32_t width, uint32_t height, TextureFormat internalFormat) {
+void Texture2D::resize(uint32_t width, uint32_t height, TextureFormat internalFormat, uint32_t levels) {
 #ifdef DEBUG
     if (internalFormat == TextureFormat::UNDEFINED) {
         throw std::runtime_error{"[Texture2D::resize] TextureFormat::UNDEFINED isn't a valid internal format"};
     }
+
+    if (levels == 0) {
+        throw std::runtime_error{"[Texture2D::resize] A texture needs at least one mip level"};
+    }
 #endif
 
     // Immutable storage cannot be reallocated; recreate the texture object
+    _samples = 1;
     recreateTextureObject();
 
     // Reset mipmaps flag because resizing removes the existing mipmaps
     _hasMipmaps = false;
     _width = width;
     _height = height;
+    _levels = levels;
     _internalFormat = internalFormat;
 
-    glTextureStorage2D(_id, 1, toInternalFormat(_internalFormat), width, height); glCheckError();
+    glTextureStorage2D(_id, levels, toInternalFormat(_internalFormat), width, height); glCheckError();
+}
+
+void Texture2D::resizeMultisample(uint32_t width, uint32_t height, TextureFormat internalFormat, uint32_t samples) {
+    if (samples <= 1) {
+        resize(width, height, internalFormat);
+        return;
+    }
+
+#ifdef DEBUG
+    if (internalFormat == TextureFormat::UNDEFINED) {
+        throw std::runtime_error{"[Texture2D::resizeMultisample] TextureFormat::UNDEFINED isn't a valid internal format"};
+    }
+
+    if (isCompressedFormat(internalFormat)) {
+        throw std::runtime_error{"[Texture2D::resizeMultisample] Block compressed formats can't be multisampled"};
+    }
+
+    GLint maxSamples = 0;
+    glGetIntegerv(GL_MAX_SAMPLES, &maxSamples);
+    if (samples > static_cast<uint32_t>(maxSamples)) {
+        throw std::runtime_error{"[Texture2D::resizeMultisample] Sample count above GL_MAX_SAMPLES"};
+    }
+#endif
+
+    _samples = samples;
+    recreateTextureObject();
+
+    _hasMipmaps = false;
+    _width = width;
+    _height = height;
+    _levels = 1;
+    _internalFormat = internalFormat;
+
+    glTextureStorage2DMultisample(
+        _id, static_cast<GLsizei>(samples), toInternalFormat(_internalFormat), width, height, GL_TRUE
+    ); glCheckError();
 }
 
 void Texture2D::setWrapS(TextureWrapMode wrap) {
-    _wrapS = wrap;
-    glTextureParameteri(_id, GL_TEXTURE_WRAP_S, toGL(wrap));
+    _samplerState.wrapS = wrap;
+    _sampler = nullptr;
 }
 
 void Texture2D::setWrapT(TextureWrapMode wrap) {
-    _wrapT = wrap;
-    glTextureParameteri(_id, GL_TEXTURE_WRAP_T, toGL(wrap));
+    _samplerState.wrapT = wrap;
+    _sampler = nullptr;
 }
 
 void Texture2D::setMinFilter(TextureMinFilter filter) {
-    _minFilter = filter;
-    glTextureParameteri(_id, GL_TEXTURE_MIN_FILTER, toGL(filter));
+    _samplerState.minFilter = filter;
+    _sampler = nullptr;
 }
 
 void Texture2D::setMagFilter(TextureMagFilter filter) {
-    _magFilter = filter;
-    glTextureParameteri(_id, GL_TEXTURE_MAG_FILTER, toGL(filter));
+    _samplerState.magFilter = filter;
+    _sampler = nullptr;
 }
 
 void Texture2D::setBorderColor(const glm::vec4& color) {
-    _borderColor = color;
-    glTextureParameterfv(_id, GL_TEXTURE_BORDER_COLOR, &color.x); glCheckError();
+    _samplerState.borderColor = color;
+    _sampler = nullptr;
+}
+
+void Texture2D::setSamplerState(const SamplerState& state) {
+    _samplerState = state;
+    _sampler = nullptr;
+}
+
+const Sampler& Texture2D::sampler() const {
+    if (!_sampler) {
+        _sampler = getSampler(_samplerState);
+    }
+    return *_sampler;
 }
 
 void Texture2D::generateMipmaps() {
     if (_hasMipmaps) return;
 
+#ifdef DEBUG
+    if (isCompressedFormat(_internalFormat)) {
+        throw std::runtime_error{"[Texture2D::generateMipmaps] Block compressed textures can't generate mipmaps"};
+    }
+
+    if (_samples > 1) {
+        throw std::runtime_error{"[Texture2D::generateMipmaps] Multisample textures can't have mipmaps"};
+    }
+#endif
+
+    // Storage is immutable; only the levels allocated by `resize` can be filled
+    if (_levels < 2) {
+        util::logMessage(
+            util::LogCategory::ENGINE, util::LogSeverity::WARNING,
+            "[Texture2D::generateMipmaps] Texture %u has a single level; allocate a mip chain when resizing or loading\n", _id
+        );
+        return;
+    }
+
     _hasMipmaps = true;
     glGenerateTextureMipmap(_id); glCheckError();
 }
 
+void Texture2D::dropTopMipLevels(uint32_t count) {
+    if (count == 0 || _levels <= count) return;
+
+    const uint32_t levels = _levels - count;
+    const uint32_t width = std::max(_width >> count, 1u);
+    const uint32_t height = std::max(_height >> count, 1u);
+
+    uint32_t newId;
+    glCreateTextures(GL_TEXTURE_2D, 1, &newId); glCheckError();
+    glTextureStorage2D(newId, levels, toInternalFormat(_internalFormat), width, height); glCheckError();
+    for (uint32_t level = 0; level < levels; level++) {
+        glCopyImageSubData(
+            _id, GL_TEXTURE_2D, level + count, 0, 0, 0,
+            newId, GL_TEXTURE_2D, level, 0, 0, 0,
+            std::max(width >> level, 1u), std::max(height >> level, 1u), 1
+        ); glCheckError();
+    }
+
+    glDeleteTextures(1, &_id); glCheckError();
+    _id = newId;
+    _width = width;
+    _height = height;
+    _levels = levels;
+}
+
 void Texture2D::bind(uint32_t unit) const {
+    bind(unit, sampler());
+}
+
+void Texture2D::bind(uint32_t unit, const Sampler& sampler) const {
     glBindTextureUnit(unit, _id); glCheckError();
+    sampler.bind(unit);
 }
 
 void Texture2D::unbind(uint32_t unit) {
     glBindTextureUnit(unit, 0); glCheckError();
+    Sampler::unbind(unit);
 }
 
 bool Texture2D::isFormatCompatible(TextureFormat internal, TextureFormat source) {
@@ -398,6 +754,18 @@ bool Texture2D::isFormatCompatible(TextureFormat internal, TextureFormat source)
         case TextureFormat::SRGBA8:
             return source == TextureFormat::RGBA8;
 
+        // ---------- Block Compressed Formats ----------
+        // Blocks are uploaded as they are, so only the exact same format is accepted
+        case TextureFormat::BC1:
+        case TextureFormat::BC1_SRGB:
+        case TextureFormat::BC3:
+        case TextureFormat::BC3_SRGB:
+        case TextureFormat::BC4:
+        case TextureFormat::BC5:
+        case TextureFormat::BC7:
+        case TextureFormat::BC7_SRGB:
+            return source == internal;
+
         // ---------- Half Float Formats ----------
         case TextureFormat::R16F:
             return source == TextureFormat::R16F || source == TextureFormat::R32F;
@@ -424,6 +792,12 @@ bool Texture2D::isFormatCompatible(TextureFormat internal, TextureFormat source)
         case TextureFormat::RGBA32F:
             return source == TextureFormat::RGBA32F;
 
+        // ---------- Packed Float Formats ----------
+        case TextureFormat::R11F_G11F_B10F:
+            return source == TextureFormat::R11F_G11F_B10F ||
+                source == TextureFormat::RGB16F ||
+                source == TextureFormat::RGB32F;
+
         // ---------- Depth Formats ----------
         case TextureFormat::DEPTH16:
             return source == TextureFormat::DEPTH16;
@@ -452,5 +826,104 @@ bool Texture2D::isFormatCompatible(TextureFormat internal, TextureFormat source)
     }
 }
 
+/// @brief Bytes per texel of an uncompressed format
+size_t Texture2D::texelSize(TextureFormat format) {
+    switch (format) {
+        case TextureFormat::R8:
+        case TextureFormat::STENCIL8:
+            return 1;
+
+        case TextureFormat::RG8:
+        case TextureFormat::R16F:
+        case TextureFormat::DEPTH16:
+            return 2;
+
+        case TextureFormat::RGB8:
+        case TextureFormat::SRGB8:
+            return 3;
+
+        case TextureFormat::RGBA8:
+        case TextureFormat::SRGBA8:
+        case TextureFormat::RG16F:
+        case TextureFormat::R11F_G11F_B10F:
+        case TextureFormat::R32F:
+        case TextureFormat::DEPTH24:
+        case TextureFormat::DEPTH32F:
+        case TextureFormat::DEPTH24_STENCIL8:
+            return 4;
+
+        case TextureFormat::RGB16F:
+            return 6;
+
+        case TextureFormat::RGBA16F:
+        case TextureFormat::RG32F:
+        case TextureFormat::DEPTH32F_STENCIL8:
+            return 8;
+
+        case TextureFormat::RGB32F:
+            return 12;
+
+        case TextureFormat::RGBA32F:
+            return 16;
+
+        default:
+            return 0;
+    }
+}
+
+size_t Texture2D::memorySize() const {
+    size_t size = 0;
+    for (uint32_t level = 0; level < _levels; level++) {
+        const uint32_t width = std::max(_width >> level, 1u);
+        const uint32_t height = std::max(_height >> level, 1u);
+        size += isCompressedFormat(_internalFormat)
+            ? compressedImageSize(_internalFormat, width, height)
+            : static_cast<size_t>(width) * height * texelSize(_internalFormat);
+    }
+    return size * _samples;
+}
+
+bool Texture2D::isCompressedFormat(TextureFormat format) {
+    switch (format) {
+        case TextureFormat::BC1:
+        case TextureFormat::BC1_SRGB:
+        case TextureFormat::BC3:
+        case TextureFormat::BC3_SRGB:
+        case TextureFormat::BC4:
+        case TextureFormat::BC5:
+        case TextureFormat::BC7:
+        case TextureFormat::BC7_SRGB:
+            return true;
+        default:
+            return false;
+    }
+}
+
+size_t Texture2D::compressedImageSize(TextureFormat format, uint32_t width, uint32_t height) {
+    size_t blockSize = 0;
+    switch (format) {
+        case TextureFormat::BC1:
+        case TextureFormat::BC1_SRGB:
+        case TextureFormat::BC4:
+            blockSize = 8;
+            break;
+
+        case TextureFormat::BC3:
+        case TextureFormat::BC3_SRGB:
+        case TextureFormat::BC5:
+        case TextureFormat::BC7:
+        case TextureFormat::BC7_SRGB:
+            blockSize = 16;
+            break;
+
+        default:
+            return 0;
+    }
+
+    // Partial blocks at the edges still take a whole block
+    const size_t blocksX = (width + 3) / 4;
+    const size_t blocksY = (height + 3) / 4;
+    return blocksX * blocksY * blockSize;
+}
 
 } // namespace tmig::render
\ No newline at end of file
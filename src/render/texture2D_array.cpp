@@ -0,0 +1,187 @@
+#include <stdexcept>
+#include <algorithm>
+
+#include "glad/glad.h"
+
+#include "tmig/render/texture2D_array.hpp"
+#include "tmig/render/internal.hpp"
+#include "tmig/util/log.hpp"
+
+namespace tmig::render {
+
+Texture2DArray::Texture2DArray() {
+    glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &_id); glCheckError();
+    util::logMessage(
+        util::LogCategory::ENGINE, util::LogSeverity::INFO,
+        "Created Texture2DArray: %u\n", _id
+    );
+}
+
+Texture2DArray::~Texture2DArray() {
+    if (_id == 0) return;
+
+    util::logMessage(
+        util::LogCategory::ENGINE, util::LogSeverity::INFO,
+        "Deleting Texture2DArray: %u\n", _id
+    );
+    glDeleteTextures(1, &_id); glCheckError();
+}
+
+Texture2DArray::Texture2DArray(Texture2DArray&& other) noexcept
+    : _id{other._id},
+      _width{other._width},
+      _height{other._height},
+      _layers{other._layers},
+      _levels{other._levels},
+      _internalFormat{other._internalFormat},
+      _samplerState{other._samplerState},
+      _sampler{std::move(other._sampler)}
+{
+    other._id = 0;
+    other._width = 0;
+    other._height = 0;
+    other._layers = 0;
+    other._levels = 1;
+    other._internalFormat = TextureFormat::UNDEFINED;
+}
+
+Texture2DArray& Texture2DArray::operator=(Texture2DArray&& other) noexcept {
+    if (this != &other) {
+        if (_id != 0) {
+            glDeleteTextures(1, &_id);
+        }
+
+        _id = other._id;
+        _width = other._width;
+        _height = other._height;
+        _layers = other._layers;
+        _levels = other._levels;
+        _internalFormat = other._internalFormat;
+        _samplerState = other._samplerState;
+        _sampler = std::move(other._sampler);
+
+        other._id = 0;
+        other._width = 0;
+        other._height = 0;
+        other._layers = 0;
+        other._levels = 1;
+        other._internalFormat = TextureFormat::UNDEFINED;
+    }
+    return *this;
+}
+
+void Texture2DArray::resize(uint32_t width, uint32_t height, uint32_t layers, TextureFormat internalFormat, uint32_t levels) {
+#ifdef DEBUG
+    if (internalFormat == TextureFormat::UNDEFINED) {
+        throw std::runtime_error{"[Texture2DArray::resize] TextureFormat::UNDEFINED isn't a valid internal format"};
+    }
+
+    if (layers == 0 || levels == 0) {
+        throw std::runtime_error{"[Texture2DArray::resize] A texture array needs at least one layer and mip level"};
+    }
+#endif
+
+    // Immutable storage cannot be reallocated; recreate the texture object
+    glDeleteTextures(1, &_id); glCheckError();
+    glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &_id); glCheckError();
+
+    _width = width;
+    _height = height;
+    _layers = layers;
+    _levels = levels;
+    _internalFormat = internalFormat;
+
+    glTextureStorage3D(_id, levels, toInternalFormat(internalFormat), width, height, layers); glCheckError();
+}
+
+void Texture2DArray::setLayerData(uint32_t layer, const void* data, TextureFormat sourceFormat, uint32_t level) {
+#ifdef DEBUG
+    if (_layers == 0 || _internalFormat == TextureFormat::UNDEFINED) {
+        throw std::runtime_error{"[Texture2DArray::setLayerData] Texture array is not initialized"};
+    }
+
+    if (layer >= _layers || level >= _levels) {
+        throw std::runtime_error{"[Texture2DArray::setLayerData] Layer or mip level out of range"};
+    }
+
+    if (!Texture2D::isFormatCompatible(_internalFormat, sourceFormat)) {
+        throw std::runtime_error{"[Texture2DArray::setLayerData] Incompatible source/internal texture format"};
+    }
+#endif
+
+    const uint32_t width = std::max(_width >> level, 1u);
+    const uint32_t height = std::max(_height >> level, 1u);
+
+    if (Texture2D::isCompressedFormat(sourceFormat)) {
+        const auto size = static_cast<GLsizei>(Texture2D::compressedImageSize(sourceFormat, width, height));
+        glCompressedTextureSubImage3D(
+            _id, level, 0, 0, layer, width, height, 1, toInternalFormat(sourceFormat), size, data
+        ); glCheckError();
+        return;
+    }
+
+    // Layers are tightly packed, without the default 4-byte row alignment
+    GLint previousAlignment = 4;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &previousAlignment);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    glTextureSubImage3D(
+        _id, level, 0, 0, layer, width, height, 1, toFormat(sourceFormat), toType(sourceFormat), data
+    ); glCheckError();
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, previousAlignment);
+}
+
+void Texture2DArray::setWrapS(TextureWrapMode wrap) {
+    _samplerState.wrapS = wrap;
+    _sampler = nullptr;
+}
+
+void Texture2DArray::setWrapT(TextureWrapMode wrap) {
+    _samplerState.wrapT = wrap;
+    _sampler = nullptr;
+}
+
+void Texture2DArray::setMinFilter(TextureMinFilter filter) {
+    _samplerState.minFilter = filter;
+    _sampler = nullptr;
+}
+
+void Texture2DArray::setMagFilter(TextureMagFilter filter) {
+    _samplerState.magFilter = filter;
+    _sampler = nullptr;
+}
+
+void Texture2DArray::setSamplerState(const SamplerState& state) {
+    _samplerState = state;
+    _sampler = nullptr;
+}
+
+const Sampler& Texture2DArray::sampler() const {
+    if (!_sampler) {
+        _sampler = getSampler(_samplerState);
+    }
+    return *_sampler;
+}
+
+void Texture2DArray::generateMipmaps() {
+#ifdef DEBUG
+    if (Texture2D::isCompressedFormat(_internalFormat)) {
+        throw std::runtime_error{"[Texture2DArray::generateMipmaps] Block compressed textures can't generate mipmaps"};
+    }
+#endif
+
+    glGenerateTextureMipmap(_id); glCheckError();
+}
+
+void Texture2DArray::bind(uint32_t unit) const {
+    glBindTextureUnit(unit, _id); glCheckError();
+    sampler().bind(unit);
+}
+
+void Texture2DArray::unbind(uint32_t unit) {
+    glBindTextureUnit(unit, 0); glCheckError();
+    Sampler::unbind(unit);
+}
+
+} // namespace tmig::render
\ No newline at end of file
@@ -0,0 +1,152 @@
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "stb/stb_image.h"
+
+#include "tmig/render/texture_atlas.hpp"
+#include "tmig/util/log.hpp"
+
+namespace tmig::render {
+
+TextureAtlas::TextureAtlas(uint32_t width, uint32_t height, TextureFormat format, uint32_t padding)
+    : _padding{padding} {
+#ifdef DEBUG
+    if (Texture2D::isCompressedFormat(format)) {
+        throw std::runtime_error{"[TextureAtlas] Block compressed atlases are not supported"};
+    }
+#endif
+
+    _texture.resize(width, height, format);
+    _texture.setWrapS(TextureWrapMode::CLAMP_TO_EDGE);
+    _texture.setWrapT(TextureWrapMode::CLAMP_TO_EDGE);
+}
+
+std::optional<glm::uvec2> TextureAtlas::allocate(uint32_t width, uint32_t height) {
+    // Best fit: the lowest shelf that is tall enough and has room left
+    Shelf* best = nullptr;
+    for (auto& shelf : _shelves) {
+        if (shelf.height >= height && shelf.usedWidth + width <= _texture.width()) {
+            if (!best || shelf.height < best->height) best = &shelf;
+        }
+    }
+
+    // Otherwise open a new shelf below the others
+    if (!best) {
+        if (_usedHeight + height > _texture.height() || width > _texture.width()) {
+            return std::nullopt;
+        }
+        _shelves.push_back(Shelf{.y = _usedHeight, .height = height, .usedWidth = 0});
+        _usedHeight += height;
+        best = &_shelves.back();
+    }
+
+    const glm::uvec2 position{best->usedWidth, best->y};
+    best->usedWidth += width;
+    return position;
+}
+
+std::optional<AtlasRegion> TextureAtlas::add(uint32_t width, uint32_t height, const void* data, TextureFormat sourceFormat) {
+#ifdef DEBUG
+    if (!Texture2D::isFormatCompatible(_texture.format(), sourceFormat)) {
+        throw std::runtime_error{"[TextureAtlas::add] Incompatible source/atlas texture format"};
+    }
+#endif
+
+    if (width == 0 || height == 0) return std::nullopt;
+
+    auto position = allocate(width + 2 * _padding, height + 2 * _padding);
+    if (!position) {
+        util::logMessage(
+            util::LogCategory::ENGINE, util::LogSeverity::WARNING,
+            "TextureAtlas %u is full, can't fit %ux%u image\n", _texture.id(), width, height
+        );
+        return std::nullopt;
+    }
+
+    AtlasRegion region;
+    region.offset = *position + glm::uvec2{_padding};
+    region.size = glm::uvec2{width, height};
+
+    const glm::vec2 atlasSize{static_cast<float>(_texture.width()), static_cast<float>(_texture.height())};
+    region.uvRect = glm::vec4{glm::vec2{region.offset} / atlasSize, glm::vec2{region.size} / atlasSize};
+
+    TextureRegion target;
+    target.x = position->x;
+    target.y = position->y;
+    target.width = width + 2 * _padding;
+    target.height = height + 2 * _padding;
+
+    if (_padding == 0) {
+        _texture.setSubData(data, sourceFormat, target);
+    } else {
+        // Extend the edge texels into the padding, so filtering at the borders only sees this image
+        const size_t texel = Texture2D::texelSize(sourceFormat);
+        const auto* source = static_cast<const unsigned char*>(data);
+        std::vector<unsigned char> padded(static_cast<size_t>(target.width) * target.height * texel);
+        for (uint32_t y = 0; y < target.height; y++) {
+            const uint32_t sourceY = std::min(y > _padding ? y - _padding : 0, height - 1);
+            const unsigned char* sourceRow = source + static_cast<size_t>(sourceY) * width * texel;
+            unsigned char* row = padded.data() + static_cast<size_t>(y) * target.width * texel;
+
+            for (uint32_t x = 0; x < _padding; x++) {
+                std::memcpy(row + x * texel, sourceRow, texel);
+                std::memcpy(row + (_padding + width + x) * texel, sourceRow + (width - 1) * texel, texel);
+            }
+            std::memcpy(row + _padding * texel, sourceRow, static_cast<size_t>(width) * texel);
+        }
+        _texture.setSubData(padded.data(), sourceFormat, target);
+    }
+
+    _usedArea += static_cast<uint64_t>(width) * height;
+    return region;
+}
+
+std::optional<AtlasRegion> TextureAtlas::addFromFile(const std::string& path, bool flipY) {
+    // Decode with the atlas channel count, so any file fits its format
+    int channels;
+    TextureFormat source;
+    switch (_texture.format()) {
+        case TextureFormat::R8:     channels = 1; source = TextureFormat::R8; break;
+        case TextureFormat::RG8:    channels = 2; source = TextureFormat::RG8; break;
+        case TextureFormat::RGB8:
+        case TextureFormat::SRGB8:  channels = 3; source = TextureFormat::RGB8; break;
+        case TextureFormat::RGBA8:
+        case TextureFormat::SRGBA8: channels = 4; source = TextureFormat::RGBA8; break;
+        default:
+            util::logMessage(
+                util::LogCategory::ENGINE, util::LogSeverity::ERROR,
+                "[TextureAtlas::addFromFile] Atlas format must be 8-bit to load image files\n"
+            );
+            return std::nullopt;
+    }
+
+    stbi_set_flip_vertically_on_load_thread(flipY);
+    int w, h, fileChannels;
+    unsigned char* data = stbi_load(path.c_str(), &w, &h, &fileChannels, channels);
+    if (!data) {
+        util::logMessage(
+            util::LogCategory::ENGINE, util::LogSeverity::ERROR,
+            "[TextureAtlas::addFromFile] Failed to load image: %s\n", path.c_str()
+        );
+        return std::nullopt;
+    }
+
+    auto region = add(static_cast<uint32_t>(w), static_cast<uint32_t>(h), data, source);
+    stbi_image_free(data);
+    return region;
+}
+
+void TextureAtlas::clear() {
+    _shelves.clear();
+    _usedHeight = 0;
+    _usedArea = 0;
+}
+
+float TextureAtlas::occupancy() const {
+    const double area = static_cast<double>(_texture.width()) * _texture.height();
+    return area > 0.0 ? static_cast<float>(_usedArea / area) : 0.0f;
+}
+
+} // namespace tmig::render
\ No newline at end of file
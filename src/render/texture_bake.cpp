@@ -0,0 +1,245 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <fstream>
+#include <vector>
+
+#include "glad/glad.h"
+
+#include "tmig/render/texture2D.hpp"
+#include "tmig/render/internal.hpp"
+#include "tmig/util/file.hpp"
+#include "tmig/util/log.hpp"
+
+namespace tmig::render {
+
+namespace {
+
+/// @brief Identifies baked texture files
+constexpr char BAKED_MAGIC[8] = {'T', 'M', 'I', 'G', 'T', 'E', 'X', '\0'};
+
+/// @brief Bumped whenever the layout or the content of baked files changes, which invalidates old ones
+constexpr uint32_t BAKED_VERSION = 1;
+
+/// @brief Level data starts at multiples of this, so uploads read aligned memory
+constexpr uint64_t BAKED_ALIGNMENT = 64;
+
+/// @brief File header, followed by one `BakedLevel` per level and the level data
+struct BakedHeader {
+    char magic[8];
+    uint32_t version;
+
+    /// @brief OpenGL sized internal format; stable unlike `TextureFormat` values
+    uint32_t glInternalFormat;
+
+    uint32_t width;
+    uint32_t height;
+    uint32_t levels;
+    uint32_t reserved;
+};
+static_assert(sizeof(BakedHeader) == 32, "Baked texture header must be tightly packed");
+
+struct BakedLevel {
+    uint64_t offset;
+    uint64_t size;
+};
+
+std::string& bakeFolder() {
+    static std::string folder = [] {
+        const char* env = std::getenv("TMIG_TEXTURE_BAKE_FOLDER");
+        return std::string{env ? env : ""};
+    }();
+    return folder;
+}
+
+/// @brief Find the `TextureFormat` of an OpenGL internal format, `UNDEFINED` if none
+TextureFormat fromInternalFormat(uint32_t glInternalFormat) {
+    for (int i = 0; i < static_cast<int>(TextureFormat::UNDEFINED); i++) {
+        const auto format = static_cast<TextureFormat>(i);
+        if (toInternalFormat(format) == glInternalFormat) return format;
+    }
+    return TextureFormat::UNDEFINED;
+}
+
+/// @brief Size in bytes of a level as stored in a baked file
+size_t levelSize(TextureFormat format, uint32_t width, uint32_t height) {
+    if (Texture2D::isCompressedFormat(format)) {
+        return Texture2D::compressedImageSize(format, width, height);
+    }
+    return static_cast<size_t>(width) * height * Texture2D::texelSize(sourceFormatFor(format));
+}
+
+/// @brief 64-bit FNV-1a, continuing from `hash`
+uint64_t fnv1a(const void* data, size_t size, uint64_t hash = 0xCBF29CE484222325ull) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+bool fail(const std::string& path, const char* reason) {
+    util::logMessage(
+        util::LogCategory::ENGINE, util::LogSeverity::ERROR,
+        "[Texture2D::loadFromBaked] %s: %s\n", reason, path.c_str()
+    );
+    return false;
+}
+
+} // namespace
+
+void setTextureBakeFolder(const std::string& folder) {
+    bakeFolder() = folder;
+}
+
+const std::string& getTextureBakeFolder() {
+    return bakeFolder();
+}
+
+std::string getBakedTexturePath(const std::string& path, const TextureLoadOptions& options) {
+    if (bakeFolder().empty()) return {};
+
+    // Identify the source by location, size and modification time; hashing its content would cost
+    // as much as the decode baking avoids
+    std::error_code error;
+    const auto absolute = std::filesystem::absolute(path, error).lexically_normal().string();
+    const auto size = static_cast<uint64_t>(std::filesystem::file_size(path, error));
+    if (error) return {};
+    const auto modified = static_cast<int64_t>(std::filesystem::last_write_time(path, error).time_since_epoch().count());
+    if (error) return {};
+
+    const uint8_t flags[4] = {options.flipY, options.srgb, options.mipmaps, options.hdrFullPrecision};
+    uint64_t hash = fnv1a(absolute.data(), absolute.size());
+    hash = fnv1a(&size, sizeof(size), hash);
+    hash = fnv1a(&modified, sizeof(modified), hash);
+    hash = fnv1a(flags, sizeof(flags), hash);
+    hash = fnv1a(&BAKED_VERSION, sizeof(BAKED_VERSION), hash);
+
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.tmtex", static_cast<unsigned long long>(hash));
+    return (std::filesystem::path{bakeFolder()} / name).string();
+}
+
+bool Texture2D::loadFromBaked(const std::string& path) {
+    const util::MappedFile file{path};
+    if (!file.isOpen()) return false;
+
+    BakedHeader header;
+    if (file.size() < sizeof(header)) return fail(path, "Truncated baked texture");
+    std::memcpy(&header, file.data(), sizeof(header));
+
+    if (std::memcmp(header.magic, BAKED_MAGIC, sizeof(BAKED_MAGIC)) != 0) return fail(path, "Not a baked texture");
+    if (header.version != BAKED_VERSION) return fail(path, "Unsupported baked texture version");
+
+    const TextureFormat format = fromInternalFormat(header.glInternalFormat);
+    if (format == TextureFormat::UNDEFINED) return fail(path, "Unsupported baked texture format");
+
+    if (header.width == 0 || header.height == 0 || header.levels == 0 ||
+        header.levels > mipLevelCount(header.width, header.height)) {
+        return fail(path, "Invalid baked texture size");
+    }
+
+    const size_t tableEnd = sizeof(header) + sizeof(BakedLevel) * header.levels;
+    if (file.size() < tableEnd) return fail(path, "Truncated baked texture");
+
+    std::vector<BakedLevel> levels(header.levels);
+    std::memcpy(levels.data(), file.data() + sizeof(header), sizeof(BakedLevel) * header.levels);
+    for (uint32_t level = 0; level < header.levels; level++) {
+        const uint32_t width = std::max(header.width >> level, 1u);
+        const uint32_t height = std::max(header.height >> level, 1u);
+        if (levels[level].size != levelSize(format, width, height) ||
+            levels[level].offset > file.size() || levels[level].size > file.size() - levels[level].offset) {
+            return fail(path, "Baked texture level out of bounds");
+        }
+    }
+
+    // Levels are tightly packed, unlike GL's default 4-byte row alignment
+    GLint previousAlignment = 4;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &previousAlignment);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    resize(header.width, header.height, format, header.levels);
+    for (uint32_t level = 0; level < header.levels; level++) {
+        setData(file.data() + levels[level].offset, sourceFormatFor(format), level);
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, previousAlignment);
+
+    // Same state as the decoded texture the file was baked from; the sampler state is left alone
+    _hasMipmaps = header.levels > 1;
+    return true;
+}
+
+bool Texture2D::saveBaked(const std::string& path) const {
+#ifdef DEBUG
+    if (_width == 0 || _height == 0 || _internalFormat == TextureFormat::UNDEFINED) {
+        throw std::runtime_error{"[Texture2D::saveBaked] Texture is not initialized"};
+    }
+#endif
+
+    BakedHeader header{};
+    std::memcpy(header.magic, BAKED_MAGIC, sizeof(BAKED_MAGIC));
+    header.version = BAKED_VERSION;
+    header.glInternalFormat = toInternalFormat(_internalFormat);
+    header.width = _width;
+    header.height = _height;
+    header.levels = _levels;
+
+    std::vector<BakedLevel> levels(_levels);
+    uint64_t offset = sizeof(header) + sizeof(BakedLevel) * _levels;
+    for (uint32_t level = 0; level < _levels; level++) {
+        offset = (offset + BAKED_ALIGNMENT - 1) / BAKED_ALIGNMENT * BAKED_ALIGNMENT;
+        levels[level].offset = offset;
+        levels[level].size = levelSize(_internalFormat, std::max(_width >> level, 1u), std::max(_height >> level, 1u));
+        offset += levels[level].size;
+    }
+
+    std::vector<unsigned char> bytes(offset, 0);
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    std::memcpy(bytes.data() + sizeof(header), levels.data(), sizeof(BakedLevel) * _levels);
+
+    GLint previousAlignment = 4;
+    glGetIntegerv(GL_PACK_ALIGNMENT, &previousAlignment);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+    const TextureFormat source = sourceFormatFor(_internalFormat);
+    for (uint32_t level = 0; level < _levels; level++) {
+        void* destination = bytes.data() + levels[level].offset;
+        const auto size = static_cast<GLsizei>(levels[level].size);
+        if (isCompressedFormat(_internalFormat)) {
+            glGetCompressedTextureImage(_id, level, size, destination); glCheckError();
+        } else {
+            glGetTextureImage(_id, level, toFormat(source), toType(source), size, destination); glCheckError();
+        }
+    }
+
+    glPixelStorei(GL_PACK_ALIGNMENT, previousAlignment);
+
+    // Write next to the destination, then rename over it
+    std::error_code error;
+    const std::filesystem::path destination{path};
+    if (destination.has_parent_path()) {
+        std::filesystem::create_directories(destination.parent_path(), error);
+    }
+
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream out{temporary, std::ios::binary | std::ios::trunc};
+        if (!out) return false;
+        out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        if (!out) return false;
+    }
+
+    std::filesystem::rename(temporary, destination, error);
+    if (error) {
+        std::filesystem::remove(temporary, error);
+        return false;
+    }
+    return true;
+}
+
+} // namespace tmig::render
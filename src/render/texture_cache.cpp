@@ -0,0 +1,197 @@
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "tmig/render/texture_cache.hpp"
+#include "tmig/util/log.hpp"
+
+namespace tmig::render {
+
+struct TextureHandle::Entry {
+    /// @brief Owning cache, or `nullptr` once the cache is destroyed
+    TextureCache* cache = nullptr;
+
+    std::string path;
+    TextureLoadOptions options;
+    Texture2D texture;
+
+    /// @brief Memory currently used by `texture`
+    size_t bytes = 0;
+
+    /// @brief Memory used by `texture` at full quality
+    size_t fullBytes = 0;
+
+    /// @brief Whether the texture content is loaded; evicted textures hold a 1x1 placeholder
+    bool resident = false;
+
+    /// @brief Whether top mip levels were dropped
+    bool reduced = false;
+
+    /// @brief Frame of the last use
+    uint64_t lastUsed = 0;
+};
+
+const Texture2D& TextureHandle::texture() const {
+#ifdef DEBUG
+    if (!_entry) {
+        throw std::runtime_error{"[TextureHandle::texture] Handle is empty"};
+    }
+#endif
+
+    if (_entry->cache) {
+        _entry->cache->use(*_entry);
+    }
+    return _entry->texture;
+}
+
+const std::string& TextureHandle::path() const {
+    static const std::string empty;
+    return _entry ? _entry->path : empty;
+}
+
+TextureCache::TextureCache(const TextureCacheConfig& config) : _config{config} {}
+
+TextureCache::~TextureCache() {
+    // Handles may outlive the cache; they keep their texture but stop reloading it
+    for (auto& [key, entry] : _entries) {
+        entry->cache = nullptr;
+    }
+}
+
+std::string TextureCache::makeKey(const std::string& path, const TextureLoadOptions& options) {
+    std::string key = path;
+    key += '|';
+    key += options.flipY ? 'f' : '-';
+    key += options.srgb ? 's' : '-';
+    key += options.mipmaps ? 'm' : '-';
+    key += options.hdrFullPrecision ? 'h' : '-';
+    return key;
+}
+
+TextureHandle TextureCache::get(const std::string& path, const TextureLoadOptions& options) {
+    const std::string key = makeKey(path, options);
+    if (auto it = _entries.find(key); it != _entries.end()) {
+        use(*it->second);
+        return TextureHandle{it->second};
+    }
+
+    auto entry = std::make_shared<TextureHandle::Entry>();
+    entry->cache = this;
+    entry->path = path;
+    entry->options = options;
+    entry->lastUsed = _frame;
+    if (!load(*entry)) {
+        return TextureHandle{};
+    }
+
+    _entries.emplace(key, entry);
+    trim();
+    return TextureHandle{entry};
+}
+
+bool TextureCache::load(TextureHandle::Entry& entry) {
+    _usedBytes -= entry.bytes;
+
+    entry.resident = entry.texture.loadFromFile(entry.path, entry.options);
+    entry.reduced = false;
+    entry.bytes = entry.texture.memorySize();
+    entry.fullBytes = entry.bytes;
+    _usedBytes += entry.bytes;
+
+    if (!entry.resident) {
+        util::logMessage(
+            util::LogCategory::ENGINE, util::LogSeverity::ERROR,
+            "[TextureCache] Failed to load texture: %s\n", entry.path.c_str()
+        );
+    }
+    return entry.resident;
+}
+
+void TextureCache::use(TextureHandle::Entry& entry) {
+    entry.lastUsed = _frame;
+
+    // Reduced textures are still usable, so only restore them when it fits the budget
+    const bool restore = !entry.resident ||
+        (entry.reduced && _usedBytes - entry.bytes + entry.fullBytes <= _config.budget);
+    if (restore && load(entry)) {
+        trim();
+    }
+}
+
+void TextureCache::beginFrame() {
+    _frame++;
+}
+
+void TextureCache::setBudget(size_t budget) {
+    _config.budget = budget;
+    trim();
+}
+
+void TextureCache::trim() {
+    if (_usedBytes <= _config.budget) return;
+
+    // Least recently used first; textures used this frame are left alone
+    std::vector<std::pair<std::string, TextureHandle::Entry*>> candidates;
+    for (auto& [key, entry] : _entries) {
+        if (entry->resident && entry->lastUsed < _frame) {
+            candidates.emplace_back(key, entry.get());
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) {
+        return a.second->lastUsed < b.second->lastUsed;
+    });
+
+    for (auto& [key, entry] : candidates) {
+        if (_usedBytes <= _config.budget) break;
+
+        // Nobody refers to it; release it entirely
+        if (_entries[key].use_count() == 1) {
+            _usedBytes -= entry->bytes;
+            _entries.erase(key);
+            continue;
+        }
+
+        Texture2D& texture = entry->texture;
+        _usedBytes -= entry->bytes;
+
+        // Prefer lowering the resolution of mipmapped textures over unloading them
+        bool reduced = false;
+        while (_usedBytes + texture.memorySize() > _config.budget &&
+               texture.levelCount() > 1 &&
+               std::max(texture.width(), texture.height()) / 2 >= _config.minimumReducedSize) {
+            texture.dropTopMipLevels(1);
+            reduced = true;
+        }
+
+        if (reduced) {
+            entry->reduced = true;
+        } else {
+            // Keep the object with a placeholder until the next use reloads it
+            texture.resize(1, 1, texture.format());
+            entry->resident = false;
+        }
+
+        entry->bytes = texture.memorySize();
+        _usedBytes += entry->bytes;
+    }
+
+    if (_usedBytes > _config.budget) {
+        util::logMessage(
+            util::LogCategory::ENGINE, util::LogSeverity::WARNING,
+            "[TextureCache] %zu bytes in use exceed the %zu bytes budget\n", _usedBytes, _config.budget
+        );
+    }
+}
+
+void TextureCache::releaseUnused() {
+    for (auto it = _entries.begin(); it != _entries.end();) {
+        if (it->second.use_count() == 1) {
+            _usedBytes -= it->second->bytes;
+            it = _entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+} // namespace tmig::render
\ No newline at end of file
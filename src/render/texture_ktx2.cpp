@@ -0,0 +1,163 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include "glad/glad.h"
+
+#include "tmig/render/texture2D.hpp"
+#include "tmig/render/internal.hpp"
+#include "tmig/util/log.hpp"
+
+namespace tmig::render {
+
+namespace {
+
+/// @brief KTX2 file identifier, the first 12 bytes of every file
+constexpr unsigned char KTX2_IDENTIFIER[12] = {
+    0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A
+};
+
+/// @brief KTX2 header, following the identifier
+struct Ktx2Header {
+    uint32_t vkFormat;
+    uint32_t typeSize;
+    uint32_t pixelWidth;
+    uint32_t pixelHeight;
+    uint32_t pixelDepth;
+    uint32_t layerCount;
+    uint32_t faceCount;
+    uint32_t levelCount;
+    uint32_t supercompressionScheme;
+
+    // Index
+    uint32_t dfdByteOffset;
+    uint32_t dfdByteLength;
+    uint32_t kvdByteOffset;
+    uint32_t kvdByteLength;
+
+    // sgdByteOffset and sgdByteLength, two unused uint64 values only 4-byte aligned in this struct
+    uint32_t sgdIndex[4];
+};
+static_assert(sizeof(Ktx2Header) == 68, "Ktx2Header must match the file layout");
+
+/// @brief Entry of the level index, following the header; level 0 is the base level
+struct Ktx2Level {
+    uint64_t byteOffset;
+    uint64_t byteLength;
+    uint64_t uncompressedByteLength;
+};
+
+/// @brief Map a `VkFormat` value to a `TextureFormat`, or `UNDEFINED` if unsupported
+TextureFormat fromVkFormat(uint32_t vkFormat) {
+    switch (vkFormat) {
+        case 9:   return TextureFormat::R8;       // VK_FORMAT_R8_UNORM
+        case 16:  return TextureFormat::RG8;      // VK_FORMAT_R8G8_UNORM
+        case 23:  return TextureFormat::RGB8;     // VK_FORMAT_R8G8B8_UNORM
+        case 29:  return TextureFormat::SRGB8;    // VK_FORMAT_R8G8B8_SRGB
+        case 37:  return TextureFormat::RGBA8;    // VK_FORMAT_R8G8B8A8_UNORM
+        case 43:  return TextureFormat::SRGBA8;   // VK_FORMAT_R8G8B8A8_SRGB
+        case 97:  return TextureFormat::RGBA16F;  // VK_FORMAT_R16G16B16A16_SFLOAT
+        case 109: return TextureFormat::RGBA32F;  // VK_FORMAT_R32G32B32A32_SFLOAT
+        case 122: return TextureFormat::R11F_G11F_B10F; // VK_FORMAT_B10G11R11_UFLOAT_PACK32
+        case 133: return TextureFormat::BC1;      // VK_FORMAT_BC1_RGBA_UNORM_BLOCK
+        case 134: return TextureFormat::BC1_SRGB; // VK_FORMAT_BC1_RGBA_SRGB_BLOCK
+        case 137: return TextureFormat::BC3;      // VK_FORMAT_BC3_UNORM_BLOCK
+        case 138: return TextureFormat::BC3_SRGB; // VK_FORMAT_BC3_SRGB_BLOCK
+        case 139: return TextureFormat::BC4;      // VK_FORMAT_BC4_UNORM_BLOCK
+        case 141: return TextureFormat::BC5;      // VK_FORMAT_BC5_UNORM_BLOCK
+        case 145: return TextureFormat::BC7;      // VK_FORMAT_BC7_UNORM_BLOCK
+        case 146: return TextureFormat::BC7_SRGB; // VK_FORMAT_BC7_SRGB_BLOCK
+        default:  return TextureFormat::UNDEFINED;
+    }
+}
+
+bool fail(const std::string& path, const char* reason) {
+    util::logMessage(
+        util::LogCategory::ENGINE, util::LogSeverity::ERROR,
+        "[Texture2D::loadFromKtx2] %s: %s\n", reason, path.c_str()
+    );
+    return false;
+}
+
+} // namespace
+
+bool Texture2D::loadFromKtx2(const std::string& path) {
+    std::ifstream file{path, std::ios::binary};
+    if (!file) return fail(path, "Failed to open file");
+    const std::vector<unsigned char> bytes{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+
+    if (bytes.size() < sizeof(KTX2_IDENTIFIER) + sizeof(Ktx2Header) ||
+        std::memcmp(bytes.data(), KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) != 0) {
+        return fail(path, "Not a KTX2 file");
+    }
+
+    Ktx2Header header;
+    std::memcpy(&header, bytes.data() + sizeof(KTX2_IDENTIFIER), sizeof(header));
+
+    if (header.supercompressionScheme != 0) return fail(path, "Supercompressed KTX2 files are not supported");
+    if (header.pixelDepth > 1 || header.layerCount > 1 || header.faceCount != 1) {
+        return fail(path, "Only 2D KTX2 textures are supported");
+    }
+    if (header.pixelWidth == 0 || header.pixelHeight == 0) return fail(path, "Invalid KTX2 dimensions");
+    if (header.levelCount > mipLevelCount(header.pixelWidth, header.pixelHeight)) {
+        return fail(path, "KTX2 level count exceeds the full mip chain");
+    }
+
+    const TextureFormat format = fromVkFormat(header.vkFormat);
+    if (format == TextureFormat::UNDEFINED) return fail(path, "Unsupported KTX2 vkFormat");
+
+    // A level count of 0 asks the loader to generate mipmaps; only the base level is stored then
+    const uint32_t storedLevels = std::max(header.levelCount, 1u);
+    const size_t levelIndexOffset = sizeof(KTX2_IDENTIFIER) + sizeof(Ktx2Header);
+    if (bytes.size() < levelIndexOffset + storedLevels * sizeof(Ktx2Level)) {
+        return fail(path, "Truncated KTX2 level index");
+    }
+
+    std::vector<Ktx2Level> levels(storedLevels);
+    std::memcpy(levels.data(), bytes.data() + levelIndexOffset, storedLevels * sizeof(Ktx2Level));
+    for (const auto& level : levels) {
+        if (level.byteOffset > bytes.size() || level.byteLength > bytes.size() - level.byteOffset) {
+            return fail(path, "Truncated KTX2 level data");
+        }
+    }
+
+    // Validate every level before touching the current storage; uploads read a whole level
+    for (uint32_t level = 0; level < storedLevels; level++) {
+        const uint32_t width = std::max(header.pixelWidth >> level, 1u);
+        const uint32_t height = std::max(header.pixelHeight >> level, 1u);
+        const size_t expectedSize = isCompressedFormat(format)
+            ? compressedImageSize(format, width, height)
+            : static_cast<size_t>(width) * height * texelSize(sourceFormatFor(format));
+        if (levels[level].byteLength < expectedSize) {
+            return fail(path, "KTX2 level is smaller than expected");
+        }
+    }
+
+    // Block compressed formats can't generate mipmaps, so they keep the base level only
+    const bool generate = header.levelCount == 0 && !isCompressedFormat(format);
+    const uint32_t allocatedLevels = generate ? mipLevelCount(header.pixelWidth, header.pixelHeight) : storedLevels;
+
+    // KTX2 rows are tightly packed, unlike GL's default 4-byte row alignment
+    GLint previousAlignment = 4;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &previousAlignment);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    resize(header.pixelWidth, header.pixelHeight, format, allocatedLevels);
+    for (uint32_t level = 0; level < storedLevels; level++) {
+        setData(bytes.data() + levels[level].byteOffset, sourceFormatFor(format), level);
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, previousAlignment);
+
+    // Like `loadFromFile`, the sampling filter is left to the caller
+    if (generate) {
+        generateMipmaps();
+    } else if (storedLevels > 1) {
+        _hasMipmaps = true;
+    }
+    return true;
+}
+
+} // namespace tmig::render
@@ -0,0 +1,254 @@
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "stb/stb_image.h"
+#include "glad/glad.h"
+
+#include "tmig/render/texture_loader.hpp"
+#include "tmig/render/internal.hpp"
+#include "tmig/util/log.hpp"
+
+namespace tmig::render {
+
+/// @brief Pick the source and internal formats for a decoded 8-bit image
+static bool pickFormats(int channels, bool srgb, TextureFormat& source, TextureFormat& internal) {
+    switch (channels) {
+        case 1: source = TextureFormat::R8; break;
+        case 2: source = TextureFormat::RG8; break;
+        case 3: source = TextureFormat::RGB8; break;
+        case 4: source = TextureFormat::RGBA8; break;
+        default: return false;
+    }
+
+    internal = source;
+    if (srgb && source == TextureFormat::RGB8) internal = TextureFormat::SRGB8;
+    if (srgb && source == TextureFormat::RGBA8) internal = TextureFormat::SRGBA8;
+    return true;
+}
+
+TextureLoader::TextureLoader(const TextureLoaderConfig& config) : _config{config} {
+    _config.uploadSlotCount = std::max(_config.uploadSlotCount, 1u);
+    _config.uploadSlotSize = std::max<size_t>(_config.uploadSlotSize, 4);
+
+    // One persistently mapped buffer split into slots; writes are coherent, fences guard reuse
+    const GLsizeiptr size = static_cast<GLsizeiptr>(_config.uploadSlotSize * _config.uploadSlotCount);
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glCreateBuffers(1, &_uploadBuffer); glCheckError();
+    glNamedBufferStorage(_uploadBuffer, size, nullptr, flags); glCheckError();
+    _uploadMemory = static_cast<unsigned char*>(glMapNamedBufferRange(_uploadBuffer, 0, size, flags)); glCheckError();
+    _slotFences.assign(_config.uploadSlotCount, nullptr);
+
+    uint32_t workerCount = _config.workerCount;
+    if (workerCount == 0) {
+        workerCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+    }
+    for (uint32_t i = 0; i < workerCount; i++) {
+        _workers.emplace_back(&TextureLoader::workerLoop, this);
+    }
+
+    util::logMessage(
+        util::LogCategory::ENGINE, util::LogSeverity::INFO,
+        "Created TextureLoader: %u workers, %u upload slots\n", workerCount, _config.uploadSlotCount
+    );
+}
+
+TextureLoader::~TextureLoader() {
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _stopping = true;
+    }
+    _condition.notify_all();
+    for (auto& worker : _workers) {
+        worker.join();
+    }
+
+    // Fail whatever is left; callbacks are skipped since their owners may be going away too
+    for (auto* jobs : {&_queued, &_decoded, &_uploading}) {
+        for (auto& job : *jobs) {
+            deliver(*job, nullptr, false);
+        }
+        jobs->clear();
+    }
+
+    // The GPU may still be reading from the ring
+    for (void* fence : _slotFences) {
+        if (!fence) continue;
+        GLsync sync = static_cast<GLsync>(fence);
+        glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, std::numeric_limits<GLuint64>::max());
+        glDeleteSync(sync);
+    }
+
+    util::logMessage(
+        util::LogCategory::ENGINE, util::LogSeverity::INFO,
+        "Deleting TextureLoader: %u\n", _uploadBuffer
+    );
+    glUnmapNamedBuffer(_uploadBuffer); glCheckError();
+    glDeleteBuffers(1, &_uploadBuffer); glCheckError();
+}
+
+std::shared_future<std::shared_ptr<Texture2D>> TextureLoader::load(
+    const std::string& path,
+    const TextureLoadOptions& options,
+    Callback onReady
+) {
+    auto job = std::make_unique<Job>();
+    job->path = path;
+    job->options = options;
+    job->onReady = std::move(onReady);
+    auto future = job->promise.get_future().share();
+
+    _pending++;
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _queued.push_back(std::move(job));
+    }
+    _condition.notify_one();
+    return future;
+}
+
+void TextureLoader::workerLoop() {
+    while (true) {
+        std::unique_ptr<Job> job;
+        {
+            std::unique_lock<std::mutex> lock{_mutex};
+            _condition.wait(lock, [this] { return _stopping || !_queued.empty(); });
+            if (_stopping) return;
+
+            job = std::move(_queued.front());
+            _queued.pop_front();
+        }
+
+        // The flip setting is thread-local, so concurrent decodes don't race on it
+        stbi_set_flip_vertically_on_load_thread(job->options.flipY);
+        job->pixels = stbi_load(job->path.c_str(), &job->width, &job->height, &job->channels, 0);
+
+        std::lock_guard<std::mutex> lock{_mutex};
+        _decoded.push_back(std::move(job));
+    }
+}
+
+void TextureLoader::update(size_t byteBudget) {
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        while (!_decoded.empty()) {
+            _uploading.push_back(std::move(_decoded.front()));
+            _decoded.pop_front();
+        }
+    }
+    if (_uploading.empty()) return;
+
+    // Decoded rows are tightly packed, which breaks the default 4-byte row alignment for RGB images
+    GLint previousAlignment = 4;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &previousAlignment);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _uploadBuffer); glCheckError();
+
+    while (!_uploading.empty() && byteBudget > 0) {
+        Job& job = *_uploading.front();
+        if (!stageJob(job, byteBudget)) break;
+
+        if (job.texture && job.options.mipmaps) {
+            job.texture->generateMipmaps();
+        }
+        deliver(job, job.texture);
+        _uploading.pop_front();
+    }
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0); glCheckError();
+    glPixelStorei(GL_UNPACK_ALIGNMENT, previousAlignment);
+}
+
+bool TextureLoader::stageJob(Job& job, size_t& byteBudget) {
+    TextureFormat source, internal;
+    if (!job.pixels || !pickFormats(job.channels, job.options.srgb, source, internal)) {
+        util::logMessage(
+            util::LogCategory::ENGINE, util::LogSeverity::ERROR,
+            "[TextureLoader] Failed to load texture: %s\n", job.path.c_str()
+        );
+        job.texture = nullptr;
+        return true;
+    }
+
+    if (!job.texture) {
+        job.texture = std::make_shared<Texture2D>();
+        const uint32_t levels = job.options.mipmaps ? mipLevelCount(job.width, job.height) : 1;
+        job.texture->resize(job.width, job.height, internal, levels);
+    }
+
+    const GLenum format = toFormat(source);
+    const size_t rowSize = static_cast<size_t>(job.width) * job.channels;
+    const uint32_t height = static_cast<uint32_t>(job.height);
+
+    // Rows wider than a slot can't be staged; upload them straight from client memory
+    if (rowSize > _config.uploadSlotSize) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        glTextureSubImage2D(
+            job.texture->id(), 0, 0, 0, job.width, job.height,
+            format, GL_UNSIGNED_BYTE, job.pixels
+        ); glCheckError();
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _uploadBuffer);
+        byteBudget -= std::min(byteBudget, rowSize * height);
+        return true;
+    }
+
+    while (job.stagedRows < height && byteBudget > 0) {
+        // Don't block: if the GPU still reads the next slot, resume on a later update
+        void*& fence = _slotFences[_nextSlot];
+        if (fence) {
+            GLsync sync = static_cast<GLsync>(fence);
+            if (glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 0) == GL_TIMEOUT_EXPIRED) return false;
+            glDeleteSync(sync);
+            fence = nullptr;
+        }
+
+        const size_t budgetRows = std::max<size_t>(byteBudget / rowSize, 1);
+        const uint32_t rows = static_cast<uint32_t>(std::min({
+            static_cast<size_t>(height - job.stagedRows),
+            _config.uploadSlotSize / rowSize,
+            budgetRows
+        }));
+        const size_t offset = _nextSlot * _config.uploadSlotSize;
+        const size_t bytes = rows * rowSize;
+
+        std::memcpy(_uploadMemory + offset, job.pixels + job.stagedRows * rowSize, bytes);
+        glTextureSubImage2D(
+            job.texture->id(), 0, 0, job.stagedRows, job.width, rows,
+            format, GL_UNSIGNED_BYTE, reinterpret_cast<const void*>(offset)
+        ); glCheckError();
+        fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+        _nextSlot = (_nextSlot + 1) % _config.uploadSlotCount;
+        job.stagedRows += rows;
+        byteBudget -= std::min(byteBudget, bytes);
+    }
+
+    // Uploads are ordered with later GL commands, so the texture is usable once every row is staged
+    return job.stagedRows == height;
+}
+
+void TextureLoader::deliver(Job& job, std::shared_ptr<Texture2D> texture, bool runCallback) {
+    if (job.pixels) {
+        stbi_image_free(job.pixels);
+        job.pixels = nullptr;
+    }
+
+    job.promise.set_value(texture);
+    if (runCallback && job.onReady) {
+        job.onReady(texture);
+    }
+    _pending--;
+}
+
+void TextureLoader::finish() {
+    while (pendingCount() > 0) {
+        update(std::numeric_limits<size_t>::max());
+        std::this_thread::yield();
+    }
+}
+
+size_t TextureLoader::pendingCount() const {
+    return _pending.load();
+}
+
+} // namespace tmig::render
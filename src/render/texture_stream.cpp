@@ -0,0 +1,173 @@
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "glad/glad.h"
+
+#include "tmig/render/texture_stream.hpp"
+#include "tmig/render/internal.hpp"
+#include "tmig/util/log.hpp"
+
+namespace tmig::render {
+
+TextureStream::TextureStream(size_t frameSize, uint32_t bufferCount) : _frameSize{frameSize} {
+#ifdef DEBUG
+    if (frameSize == 0 || bufferCount == 0) {
+        throw std::runtime_error{"[TextureStream::TextureStream] Frame size and buffer count must not be 0"};
+    }
+#endif
+
+    // Keep every slot start aligned for any pixel type
+    _slotStride = (frameSize + 255) & ~size_t{255};
+
+    // One persistently mapped buffer split into slots; writes are coherent, fences guard reuse
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    const auto size = static_cast<GLsizeiptr>(_slotStride * bufferCount);
+    glCreateBuffers(1, &_buffer); glCheckError();
+    glNamedBufferStorage(_buffer, size, nullptr, flags); glCheckError();
+    _memory = static_cast<unsigned char*>(glMapNamedBufferRange(_buffer, 0, size, flags)); glCheckError();
+    _fences.assign(bufferCount, nullptr);
+
+    util::logMessage(
+        util::LogCategory::ENGINE, util::LogSeverity::INFO,
+        "Created TextureStream: %u\n", _buffer
+    );
+}
+
+TextureStream::~TextureStream() {
+    if (_buffer == 0) return;
+
+    // The GPU may still be reading from the slots
+    for (void* fence : _fences) {
+        if (!fence) continue;
+        GLsync sync = static_cast<GLsync>(fence);
+        glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, std::numeric_limits<GLuint64>::max());
+        glDeleteSync(sync);
+    }
+
+    util::logMessage(
+        util::LogCategory::ENGINE, util::LogSeverity::INFO,
+        "Deleting TextureStream: %u\n", _buffer
+    );
+    glUnmapNamedBuffer(_buffer); glCheckError();
+    glDeleteBuffers(1, &_buffer); glCheckError();
+}
+
+TextureStream::TextureStream(TextureStream&& other) noexcept
+    : _buffer{other._buffer},
+      _memory{other._memory},
+      _frameSize{other._frameSize},
+      _slotStride{other._slotStride},
+      _fences{std::move(other._fences)},
+      _nextSlot{other._nextSlot},
+      _mapped{other._mapped},
+      _stallCount{other._stallCount}
+{
+    other._buffer = 0;
+    other._memory = nullptr;
+    other._fences.clear();
+    other._mapped = false;
+}
+
+TextureStream& TextureStream::operator=(TextureStream&& other) noexcept {
+    if (this != &other) {
+        if (_buffer != 0) {
+            for (void* fence : _fences) {
+                if (!fence) continue;
+                GLsync sync = static_cast<GLsync>(fence);
+                glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, std::numeric_limits<GLuint64>::max());
+                glDeleteSync(sync);
+            }
+            glUnmapNamedBuffer(_buffer);
+            glDeleteBuffers(1, &_buffer);
+        }
+
+        _buffer = other._buffer;
+        _memory = other._memory;
+        _frameSize = other._frameSize;
+        _slotStride = other._slotStride;
+        _fences = std::move(other._fences);
+        _nextSlot = other._nextSlot;
+        _mapped = other._mapped;
+        _stallCount = other._stallCount;
+
+        other._buffer = 0;
+        other._memory = nullptr;
+        other._fences.clear();
+        other._mapped = false;
+    }
+    return *this;
+}
+
+void* TextureStream::map() {
+    void*& fence = _fences[_nextSlot];
+    if (fence) {
+        GLsync sync = static_cast<GLsync>(fence);
+
+        // Usually signaled long ago; otherwise the CPU is a full ring ahead and has to wait
+        if (glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 0) == GL_TIMEOUT_EXPIRED) {
+            _stallCount++;
+            glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, std::numeric_limits<GLuint64>::max());
+        }
+        glDeleteSync(sync);
+        fence = nullptr;
+    }
+
+    _mapped = true;
+    return _memory + _nextSlot * _slotStride;
+}
+
+void TextureStream::upload(Texture2D& texture, TextureFormat sourceFormat, const TextureRegion& region) {
+#ifdef DEBUG
+    if (!_mapped) {
+        throw std::runtime_error{"[TextureStream::upload] No slot is mapped; call map first"};
+    }
+
+    if (regionSize(texture, sourceFormat, region) > _frameSize) {
+        throw std::runtime_error{"[TextureStream::upload] Region is larger than the frame size"};
+    }
+#endif
+
+    // With an unpack buffer bound, the data pointer is a byte offset into it
+    const size_t offset = _nextSlot * _slotStride;
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _buffer); glCheckError();
+    texture.setSubData(reinterpret_cast<const void*>(offset), sourceFormat, region);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0); glCheckError();
+
+    _fences[_nextSlot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0); glCheckError();
+    _nextSlot = (_nextSlot + 1) % static_cast<uint32_t>(_fences.size());
+    _mapped = false;
+}
+
+void TextureStream::write(Texture2D& texture, const void* data, TextureFormat sourceFormat, const TextureRegion& region) {
+    const size_t size = regionSize(texture, sourceFormat, region);
+
+#ifdef DEBUG
+    if (size > _frameSize) {
+        throw std::runtime_error{"[TextureStream::write] Region is larger than the frame size"};
+    }
+#endif
+
+    std::memcpy(map(), data, size);
+    upload(texture, sourceFormat, region);
+}
+
+size_t TextureStream::regionSize(const Texture2D& texture, TextureFormat sourceFormat, const TextureRegion& region) {
+    const uint32_t levelWidth = std::max(texture.width() >> region.level, 1u);
+    const uint32_t levelHeight = std::max(texture.height() >> region.level, 1u);
+    const uint32_t width = region.width != 0 ? region.width : levelWidth - std::min(region.x, levelWidth);
+    const uint32_t height = region.height != 0 ? region.height : levelHeight - std::min(region.y, levelHeight);
+    if (width == 0 || height == 0) return 0;
+
+    if (Texture2D::isCompressedFormat(sourceFormat)) {
+        return Texture2D::compressedImageSize(sourceFormat, width, height);
+    }
+
+    // The last row only spans the region, not the whole pitch
+    const size_t rowSize = static_cast<size_t>(width) * Texture2D::texelSize(sourceFormat);
+    const size_t rowPitch = region.rowPitch != 0 ? region.rowPitch : rowSize;
+    return rowPitch * (height - 1) + rowSize;
+}
+
+} // namespace tmig::render
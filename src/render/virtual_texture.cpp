@@ -0,0 +1,411 @@
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <cmath>
+
+#include "stb/stb_image.h"
+#include "glad/glad.h"
+
+#include "tmig/render/virtual_texture.hpp"
+#include "tmig/render/internal.hpp"
+#include "tmig/util/log.hpp"
+
+namespace tmig::render {
+
+/// @brief Feedback texels with this level are empty (cleared, no geometry)
+static constexpr uint8_t NO_PAGE_LEVEL = 255;
+
+VirtualTexture::VirtualTexture(const VirtualTextureConfig& config, PageLoader loader)
+    : _config{config}, _loader{std::move(loader)}
+{
+#ifdef DEBUG
+    if (config.pageSize == 0 || config.width == 0 || config.height == 0 ||
+        config.width % config.pageSize != 0 || config.height % config.pageSize != 0) {
+        throw std::runtime_error{"[VirtualTexture::VirtualTexture] Virtual size must be a multiple of the page size"};
+    }
+
+    // A page of a coarser level covers exactly 2x2 pages of the finer one only for power of two counts;
+    // sampling (`fract(uv * pages)` in virtual_texture.glsl) relies on it
+    const auto isPowerOfTwo = [](uint32_t value) { return (value & (value - 1)) == 0; };
+    if (!isPowerOfTwo(config.width / config.pageSize) || !isPowerOfTwo(config.height / config.pageSize)) {
+        throw std::runtime_error{"[VirtualTexture::VirtualTexture] Page counts must be powers of two"};
+    }
+
+    if (config.width / config.pageSize > 4096 || config.height / config.pageSize > 4096) {
+        throw std::runtime_error{"[VirtualTexture::VirtualTexture] At most 4096 pages per side are supported"};
+    }
+
+    if (config.cachePages == 0 || config.cachePages > 256) {
+        throw std::runtime_error{"[VirtualTexture::VirtualTexture] Cache must be 1 to 256 pages wide"};
+    }
+
+    if (!_loader) {
+        throw std::runtime_error{"[VirtualTexture::VirtualTexture] A page loader is required"};
+    }
+#endif
+
+    _config.feedbackScale = std::max(_config.feedbackScale, 1u);
+    _config.maxUploadsPerUpdate = std::max(_config.maxUploadsPerUpdate, 1u);
+
+    // One page table texel per page, one page table level per virtual level
+    const uint32_t pagesWide = config.width / config.pageSize;
+    const uint32_t pagesHigh = config.height / config.pageSize;
+    _pageTable.resize(pagesWide, pagesHigh, TextureFormat::RGBA8, mipLevelCount(pagesWide, pagesHigh));
+    _pageTable.setMinFilter(TextureMinFilter::NEAREST_MIPMAP_NEAREST);
+    _pageTable.setMagFilter(TextureMagFilter::NEAREST);
+
+    const uint32_t paddedSize = config.pageSize + 2 * config.pageBorder;
+    const uint32_t cacheSize = config.cachePages * paddedSize;
+    _cache.resize(cacheSize, cacheSize, config.srgb ? TextureFormat::SRGBA8 : TextureFormat::RGBA8);
+    _cache.setWrapS(TextureWrapMode::CLAMP_TO_EDGE);
+    _cache.setWrapT(TextureWrapMode::CLAMP_TO_EDGE);
+    _slots.assign(config.cachePages * config.cachePages, CacheSlot{INVALID_PAGE});
+
+    FramebufferConfig feedbackConfig;
+    feedbackConfig.width = 1;
+    feedbackConfig.height = 1;
+    feedbackConfig.colorAttachments[0] = {&_feedbackColor, TextureFormat::RGBA8};
+    feedbackConfig.depthAttachment = FramebufferDepthAttachment{&_feedbackDepth, DepthAttachmentFormat::DEPTH24};
+    _feedbackFramebuffer.setup(feedbackConfig);
+
+    _readbacks.resize(3);
+    for (auto& readback : _readbacks) {
+        glCreateBuffers(1, &readback.buffer); glCheckError();
+    }
+
+    // The coarsest level is the fallback of every other page, so it is loaded up front and pinned
+    const uint32_t topLevel = _pageTable.levelCount() - 1;
+    std::vector<uint8_t> pixels(static_cast<size_t>(paddedSize) * paddedSize * 4);
+    for (uint32_t y = 0; y < pagesY(topLevel); y++) {
+        for (uint32_t x = 0; x < pagesX(topLevel); x++) {
+            LoadedPage page{pageKey(topLevel, x, y), {}, _loader(topLevel, x, y, paddedSize, pixels.data())};
+            if (!page.loaded) {
+                util::logMessage(
+                    util::LogCategory::ENGINE, util::LogSeverity::ERROR,
+                    "[VirtualTexture] Failed to load page (%u, %u) of level %u\n", x, y, topLevel
+                );
+                std::fill(pixels.begin(), pixels.end(), uint8_t{0});
+            }
+            page.pixels = pixels;
+            upload(page, true);
+        }
+    }
+    updatePageTable();
+
+    for (uint32_t i = 0; i < std::max(_config.workerCount, 1u); i++) {
+        _workers.emplace_back(&VirtualTexture::workerLoop, this);
+    }
+
+    util::logMessage(
+        util::LogCategory::ENGINE, util::LogSeverity::INFO,
+        "Created VirtualTexture: %ux%u, %u levels, %u cache pages\n",
+        config.width, config.height, _pageTable.levelCount(), config.cachePages * config.cachePages
+    );
+}
+
+VirtualTexture::~VirtualTexture() {
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _stopping = true;
+    }
+    _condition.notify_all();
+    for (auto& worker : _workers) {
+        worker.join();
+    }
+
+    for (auto& readback : _readbacks) {
+        if (readback.fence) {
+            glDeleteSync(static_cast<GLsync>(readback.fence));
+        }
+        glDeleteBuffers(1, &readback.buffer); glCheckError();
+    }
+
+    util::logMessage(
+        util::LogCategory::ENGINE, util::LogSeverity::INFO,
+        "Deleting VirtualTexture: %ux%u\n", _config.width, _config.height
+    );
+}
+
+VirtualTexture::PageLoader VirtualTexture::folderLoader(const std::string& folder) {
+    return [folder](uint32_t level, uint32_t x, uint32_t y, uint32_t size, uint8_t* pixels) {
+        const std::string path = folder + "/" + std::to_string(level) + "/" +
+            std::to_string(x) + "_" + std::to_string(y) + ".png";
+
+        // Pages are addressed bottom row first, like texture coordinates
+        stbi_set_flip_vertically_on_load_thread(true);
+        int width, height, channels;
+        unsigned char* data = stbi_load(path.c_str(), &width, &height, &channels, 4);
+        if (!data) return false;
+
+        const bool valid = static_cast<uint32_t>(width) == size && static_cast<uint32_t>(height) == size;
+        if (valid) {
+            std::memcpy(pixels, data, static_cast<size_t>(size) * size * 4);
+        }
+        stbi_image_free(data);
+        return valid;
+    };
+}
+
+void VirtualTexture::beginFeedback(uint32_t screenWidth, uint32_t screenHeight) {
+    const uint32_t width = std::max(screenWidth / _config.feedbackScale, 1u);
+    const uint32_t height = std::max(screenHeight / _config.feedbackScale, 1u);
+    if (width != _feedbackFramebuffer.width() || height != _feedbackFramebuffer.height()) {
+        _feedbackFramebuffer.resize(width, height);
+    }
+
+    FramebufferBindOptions options;
+    options.clearColor = false;
+    _feedbackFramebuffer.bind(options);
+
+    // Texels no geometry covers decode as "no page"
+    const float empty[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+    glClearBufferfv(GL_COLOR, 0, empty); glCheckError();
+}
+
+void VirtualTexture::endFeedback() {
+    Readback& readback = _readbacks[_nextReadback];
+
+    // The slot is still in flight; skip this feedback rather than wait for it
+    if (readback.fence) return;
+
+    readback.width = _feedbackFramebuffer.width();
+    readback.height = _feedbackFramebuffer.height();
+    const auto size = static_cast<GLsizei>(readback.width * readback.height * 4);
+
+    GLint currentSize = 0;
+    glGetNamedBufferParameteriv(readback.buffer, GL_BUFFER_SIZE, &currentSize);
+    if (currentSize < size) {
+        glNamedBufferData(readback.buffer, size, nullptr, GL_STREAM_READ); glCheckError();
+    }
+
+    // Copy into the pixel pack buffer; returns immediately, the fence tells when the data is there
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.buffer); glCheckError();
+    glGetTextureImage(_feedbackColor.id(), 0, GL_RGBA, GL_UNSIGNED_BYTE, size, nullptr); glCheckError();
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0); glCheckError();
+    readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    _nextReadback = (_nextReadback + 1) % static_cast<uint32_t>(_readbacks.size());
+}
+
+void VirtualTexture::setUniforms(ShaderProgram& shader, uint32_t pageTableUnit, uint32_t cacheUnit) const {
+    shader.setTexture("vtPageTable", _pageTable, pageTableUnit);
+    shader.setTexture("vtCache", _cache, cacheUnit);
+    shader.setVec2("vtPage", glm::vec2{static_cast<float>(_config.pageSize), static_cast<float>(_config.pageBorder)});
+    shader.setVec2("vtCacheSize", glm::vec2{static_cast<float>(_cache.width()), static_cast<float>(_cache.height())});
+    shader.setFloat("vtFeedbackBias", -std::log2(static_cast<float>(_config.feedbackScale)));
+}
+
+void VirtualTexture::update() {
+    _frame++;
+
+    // Consume every finished readback, without waiting for unfinished ones
+    for (auto& readback : _readbacks) {
+        if (!readback.fence) continue;
+
+        GLsync sync = static_cast<GLsync>(readback.fence);
+        if (glClientWaitSync(sync, 0, 0) == GL_TIMEOUT_EXPIRED) continue;
+        glDeleteSync(sync);
+        readback.fence = nullptr;
+
+        const size_t size = static_cast<size_t>(readback.width) * readback.height * 4;
+        const auto* pixels = static_cast<const uint8_t*>(
+            glMapNamedBufferRange(readback.buffer, 0, static_cast<GLsizeiptr>(size), GL_MAP_READ_BIT)
+        ); glCheckError();
+        if (pixels) {
+            processFeedback(pixels, readback.width, readback.height);
+        }
+        glUnmapNamedBuffer(readback.buffer); glCheckError();
+    }
+
+    std::deque<LoadedPage> loaded;
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        const size_t count = std::min<size_t>(_loaded.size(), _config.maxUploadsPerUpdate);
+        for (size_t i = 0; i < count; i++) {
+            loaded.push_back(std::move(_loaded.front()));
+            _loaded.pop_front();
+        }
+    }
+
+    for (size_t i = 0; i < loaded.size(); i++) {
+        LoadedPage& page = loaded[i];
+        _pending.erase(page.page);
+        if (!page.loaded) {
+            // Never requested again; its ancestors keep standing in for it
+            _failed.insert(page.page);
+            const uint32_t level = static_cast<uint32_t>(page.page >> 48);
+            util::logMessage(
+                util::LogCategory::ENGINE, util::LogSeverity::WARNING,
+                "[VirtualTexture] Failed to load page (%u, %u) of level %u\n",
+                static_cast<uint32_t>(page.page & 0xFFFFFF),
+                static_cast<uint32_t>((page.page >> 24) & 0xFFFFFF),
+                level
+            );
+            continue;
+        }
+
+        // No slot to spare; this page and the ones after it go back to the front of the queue, still
+        // pending (so they aren't requested twice), for the next update
+        if (!upload(page, false)) {
+            _pending.insert(page.page);
+
+            std::lock_guard<std::mutex> lock{_mutex};
+            for (size_t rest = loaded.size(); rest-- > i;) {
+                _loaded.push_front(std::move(loaded[rest]));
+            }
+            break;
+        }
+    }
+
+    if (_pageTableDirty) {
+        updatePageTable();
+    }
+}
+
+void VirtualTexture::processFeedback(const uint8_t* pixels, uint32_t width, uint32_t height) {
+    std::unordered_set<uint64_t> seen;
+    for (size_t i = 0; i < static_cast<size_t>(width) * height; i++) {
+        const uint8_t* texel = pixels + i * 4;
+        const uint8_t level = texel[3];
+        if (level == NO_PAGE_LEVEL || level >= _pageTable.levelCount()) continue;
+
+        const uint32_t x = texel[0] | ((texel[2] & 0x0F) << 8);
+        const uint32_t y = texel[1] | ((texel[2] >> 4) << 8);
+        if (!seen.insert(pageKey(level, x, y)).second) continue;
+
+        request(level, std::min(x, pagesX(level) - 1), std::min(y, pagesY(level) - 1));
+    }
+}
+
+void VirtualTexture::request(uint32_t level, uint32_t x, uint32_t y) {
+    // Walk up to the first resident ancestor, touching it so it stays available as a fallback. Release
+    // builds don't check for power of two page counts, so keep halved coordinates inside the coarser level
+    std::vector<uint64_t> missing;
+    for (uint32_t l = level; l < _pageTable.levelCount(); l++, x >>= 1, y >>= 1) {
+        x = std::min(x, pagesX(l) - 1);
+        y = std::min(y, pagesY(l) - 1);
+        const uint64_t key = pageKey(l, x, y);
+        if (auto it = _resident.find(key); it != _resident.end()) {
+            _slots[it->second].lastUsed = _frame;
+            break;
+        }
+        if (!_pending.count(key) && !_failed.count(key)) {
+            missing.push_back(key);
+        }
+    }
+    if (missing.empty()) return;
+
+    // Coarse pages first, so detail sharpens progressively
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        for (auto it = missing.rbegin(); it != missing.rend(); ++it) {
+            _queued.push_back(*it);
+            _pending.insert(*it);
+        }
+    }
+    _condition.notify_all();
+}
+
+bool VirtualTexture::upload(const LoadedPage& page, bool locked) {
+    // Free slot first, otherwise the least recently used page not referenced by this update
+    uint32_t slot = static_cast<uint32_t>(_slots.size());
+    for (uint32_t i = 0; i < _slots.size(); i++) {
+        const CacheSlot& candidate = _slots[i];
+        if (candidate.page == INVALID_PAGE) {
+            slot = i;
+            break;
+        }
+        if (candidate.locked || candidate.lastUsed >= _frame) continue;
+        if (slot == _slots.size() || candidate.lastUsed < _slots[slot].lastUsed) {
+            slot = i;
+        }
+    }
+    if (slot == _slots.size()) return false;
+
+    CacheSlot& target = _slots[slot];
+    if (target.page != INVALID_PAGE) {
+        _resident.erase(target.page);
+    }
+    target.page = page.page;
+    target.lastUsed = _frame;
+    target.locked = locked;
+    _resident[page.page] = slot;
+
+    const uint32_t paddedSize = _config.pageSize + 2 * _config.pageBorder;
+    TextureRegion region;
+    region.x = (slot % _config.cachePages) * paddedSize;
+    region.y = (slot / _config.cachePages) * paddedSize;
+    region.width = paddedSize;
+    region.height = paddedSize;
+    _cache.setSubData(page.pixels.data(), TextureFormat::RGBA8, region);
+
+    _pageTableDirty = true;
+    return true;
+}
+
+void VirtualTexture::updatePageTable() {
+    // Each entry maps its page, or inherits the mapping of its parent, from the coarsest level down
+    std::vector<uint8_t> parent;
+    for (uint32_t level = _pageTable.levelCount(); level-- > 0;) {
+        const uint32_t width = pagesX(level);
+        const uint32_t height = pagesY(level);
+        const uint32_t parentWidth = level + 1 < _pageTable.levelCount() ? pagesX(level + 1) : 1;
+        const uint32_t parentHeight = level + 1 < _pageTable.levelCount() ? pagesY(level + 1) : 1;
+        std::vector<uint8_t> entries(static_cast<size_t>(width) * height * 4, 0);
+
+        for (uint32_t y = 0; y < height; y++) {
+            for (uint32_t x = 0; x < width; x++) {
+                uint8_t* entry = entries.data() + (static_cast<size_t>(y) * width + x) * 4;
+                if (auto it = _resident.find(pageKey(level, x, y)); it != _resident.end()) {
+                    entry[0] = static_cast<uint8_t>(it->second % _config.cachePages);
+                    entry[1] = static_cast<uint8_t>(it->second / _config.cachePages);
+                    entry[2] = static_cast<uint8_t>(level);
+                    entry[3] = 255;
+                } else if (!parent.empty()) {
+                    // Clamped like in `request`, in case release builds were given odd page counts
+                    const uint32_t parentX = std::min(x >> 1, parentWidth - 1);
+                    const uint32_t parentY = std::min(y >> 1, parentHeight - 1);
+                    const size_t parentIndex = static_cast<size_t>(parentY) * parentWidth + parentX;
+                    std::memcpy(entry, parent.data() + parentIndex * 4, 4);
+                }
+            }
+        }
+
+        TextureRegion region;
+        region.level = level;
+        _pageTable.setSubData(entries.data(), TextureFormat::RGBA8, region);
+        parent = std::move(entries);
+    }
+
+    _pageTableDirty = false;
+}
+
+void VirtualTexture::workerLoop() {
+    const uint32_t paddedSize = _config.pageSize + 2 * _config.pageBorder;
+    while (true) {
+        uint64_t key;
+        {
+            std::unique_lock<std::mutex> lock{_mutex};
+            _condition.wait(lock, [this] { return _stopping || !_queued.empty(); });
+            if (_stopping) return;
+
+            key = _queued.front();
+            _queued.pop_front();
+        }
+
+        LoadedPage page{key, std::vector<uint8_t>(static_cast<size_t>(paddedSize) * paddedSize * 4), false};
+        page.loaded = _loader(
+            static_cast<uint32_t>(key >> 48),
+            static_cast<uint32_t>(key & 0xFFFFFF),
+            static_cast<uint32_t>((key >> 24) & 0xFFFFFF),
+            paddedSize,
+            page.pixels.data()
+        );
+
+        std::lock_guard<std::mutex> lock{_mutex};
+        _loaded.push_back(std::move(page));
+    }
+}
+
+} // namespace tmig::render
@@ -34,7 +34,7 @@ struct WindowDeleter {
 
 namespace tmig::render::window {
 
-void init(int width,int height, const std::string &title) {
+void init(int width,int height, const std::string &title, int samples) {
     if (initialized) return;
     initialized = true;
 
@@ -47,7 +47,7 @@ void init(int width,int height, const std::string &title) {
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 4);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-    glfwWindowHint(GLFW_SAMPLES, 4); // Enable 4x MSAA
+    glfwWindowHint(GLFW_SAMPLES, samples);
 
     // Create window
     glfwWindow = std::shared_ptr<GLFWwindow>{
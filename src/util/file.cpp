@@ -2,6 +2,16 @@
 #include <sstream>
 #include <stdexcept>
 
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include "tmig/util/file.hpp"
 
 namespace tmig::util {
@@ -16,4 +26,73 @@ std::string readFileContent(const std::string& filePath) {
     return buffer.str();
 }
 
+MappedFile::MappedFile(const std::string& filePath) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(
+        filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr
+    );
+    if (file == INVALID_HANDLE_VALUE) return;
+
+    LARGE_INTEGER size;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping) {
+            _data = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            _size = _data ? static_cast<size_t>(size.QuadPart) : 0;
+
+            // The view keeps the mapping alive
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+#else
+    const int file = open(filePath.c_str(), O_RDONLY);
+    if (file < 0) return;
+
+    struct stat info;
+    if (fstat(file, &info) == 0 && info.st_size > 0) {
+        void* data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+        if (data != MAP_FAILED) {
+            _data = static_cast<const unsigned char*>(data);
+            _size = static_cast<size_t>(info.st_size);
+        }
+    }
+
+    // The mapping stays valid after closing the descriptor
+    ::close(file);
+#endif
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept : _data{other._data}, _size{other._size} {
+    other._data = nullptr;
+    other._size = 0;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        _data = other._data;
+        _size = other._size;
+        other._data = nullptr;
+        other._size = 0;
+    }
+    return *this;
+}
+
+void MappedFile::close() {
+    if (!_data) return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(_data);
+#else
+    munmap(const_cast<unsigned char*>(_data), _size);
+#endif
+    _data = nullptr;
+    _size = 0;
+}
+
 } // namespace tmig::util
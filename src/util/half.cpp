@@ -0,0 +1,135 @@
+#include <algorithm>
+#include <cstring>
+
+#include "tmig/util/half.hpp"
+
+// F16C is picked at runtime, so builds without -mf16c still use it where available
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define TMIG_HALF_F16C 1
+#endif
+
+namespace tmig::util {
+
+static uint32_t floatBits(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static float bitsToFloat(uint32_t bits) {
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+uint16_t floatToHalf(float value) {
+    uint32_t bits = floatBits(value);
+    const uint32_t sign = (bits >> 16) & 0x8000;
+    bits &= 0x7FFFFFFF;
+
+    uint32_t half;
+    if (bits >= 0x47800000) {
+        // Too large for a half (>= 65536), infinity or NaN
+        half = bits > 0x7F800000 ? 0x7E00 : 0x7C00;
+    } else if (bits < 0x38800000) {
+        // Subnormal half or zero; adding the magic value aligns the mantissa and rounds it
+        const uint32_t magic = ((127 - 15) + (23 - 10) + 1) << 23;
+        half = floatBits(bitsToFloat(bits) + bitsToFloat(magic)) - magic;
+    } else {
+        // Rebias the exponent and round the dropped 13 mantissa bits to nearest even
+        const uint32_t odd = (bits >> 13) & 1;
+        bits += (static_cast<uint32_t>(15 - 127) << 23) + 0xFFF + odd;
+        half = bits >> 13;
+    }
+    return static_cast<uint16_t>(half | sign);
+}
+
+float halfToFloat(uint16_t value) {
+    const uint32_t sign = static_cast<uint32_t>(value & 0x8000) << 16;
+    const uint32_t exponent = (value >> 10) & 0x1F;
+    const uint32_t mantissa = value & 0x3FF;
+
+    if (exponent == 0) {
+        // Zero or subnormal: mantissa * 2^-24
+        const float magnitude = static_cast<float>(mantissa) * bitsToFloat(0x33800000);
+        return sign ? -magnitude : magnitude;
+    }
+    if (exponent == 31) {
+        return bitsToFloat(sign | 0x7F800000 | (mantissa << 13));
+    }
+    return bitsToFloat(sign | ((exponent + 127 - 15) << 23) | (mantissa << 13));
+}
+
+#ifdef TMIG_HALF_F16C
+__attribute__((target("avx,f16c")))
+static void floatToHalfF16C(const float* source, uint16_t* destination, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256 values = _mm256_loadu_ps(source + i);
+        const __m128i halves = _mm256_cvtps_ph(values, _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), halves);
+    }
+    for (; i < count; i++) {
+        destination[i] = floatToHalf(source[i]);
+    }
+}
+#endif
+
+bool hasHardwareHalfConversion() {
+#ifdef TMIG_HALF_F16C
+    static const bool supported = __builtin_cpu_supports("avx") && __builtin_cpu_supports("f16c");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+void floatToHalf(const float* source, uint16_t* destination, size_t count) {
+#ifdef TMIG_HALF_F16C
+    if (hasHardwareHalfConversion()) {
+        floatToHalfF16C(source, destination, count);
+        return;
+    }
+#endif
+
+    for (size_t i = 0; i < count; i++) {
+        destination[i] = floatToHalf(source[i]);
+    }
+}
+
+/// @brief Shorten a non-negative half to an unsigned small float with `mantissaBits` mantissa bits
+static uint32_t halfToSmallFloat(uint16_t half, uint32_t mantissaBits) {
+    // Negative values (and negative NaNs) have no representation
+    if (half & 0x8000) return 0;
+
+    // NaN must keep a mantissa bit; rounding could turn it into infinity
+    if ((half & 0x7C00) == 0x7C00 && (half & 0x03FF) != 0) {
+        return (0x1Fu << mantissaBits) | 1;
+    }
+
+    // Same exponent bias as a half, so rounding the mantissa is enough; carries into the exponent
+    const uint32_t shift = 10 - mantissaBits;
+    const uint32_t odd = (half >> shift) & 1;
+    return (half + (1u << (shift - 1)) - 1 + odd) >> shift;
+}
+
+void packR11G11B10F(const float* rgb, uint32_t* destination, size_t count) {
+    // Convert through halves in chunks, to use the vectorized conversion
+    constexpr size_t CHUNK = 1024;
+    uint16_t halves[CHUNK * 3];
+
+    for (size_t start = 0; start < count; start += CHUNK) {
+        const size_t chunk = std::min(CHUNK, count - start);
+        floatToHalf(rgb + start * 3, halves, chunk * 3);
+
+        for (size_t i = 0; i < chunk; i++) {
+            const uint32_t r = halfToSmallFloat(halves[i * 3 + 0], 6);
+            const uint32_t g = halfToSmallFloat(halves[i * 3 + 1], 6);
+            const uint32_t b = halfToSmallFloat(halves[i * 3 + 2], 5);
+            destination[start + i] = (r & 0x7FF) | ((g & 0x7FF) << 11) | ((b & 0x3FF) << 22);
+        }
+    }
+}
+
+} // namespace tmig::util
@@ -4,9 +4,9 @@
 #include "glad/glad.h"
 
 #include "tmig/util/postprocessing.hpp"
-#include "tmig/util/resources.hpp"
 #include "tmig/util/shapes.hpp"
 #include "tmig/render/shader.hpp"
+#include "tmig/render/program_pipeline.hpp"
 #include "tmig/render/mesh.hpp"
 
 namespace tmig::util {
@@ -18,19 +18,27 @@ struct ScreenQuadRenderer {
         glm::vec2 uv;
     };
 
-    render::ShaderProgram shader;
+    std::shared_ptr<render::ShaderProgram> vertexStage;
+    render::ShaderProgram fragmentStage;
+    render::ProgramPipeline pipeline;
     render::Mesh<Vert> mesh;
     std::unique_ptr<render::DataBuffer<Vert>> vertexBuffer;
     std::unique_ptr<render::DataBuffer<uint32_t>> indexBuffer;
 
     ScreenQuadRenderer() {
         // Prepare shader
-        if (!shader.compileFromFiles(
-            getResourcePath("engine/shaders/screen_quad.vert"),
-            getResourcePath("engine/shaders/screen_quad.frag")
+        vertexStage = render::getSharedStage(
+            render::ShaderStage::VERTEX,
+            "engine/shaders/screen_quad.vert"
+        );
+        if (!vertexStage || !fragmentStage.compileStagePrecompiled(
+            render::ShaderStage::FRAGMENT,
+            "engine/shaders/screen_quad.frag"
         )) {
             throw std::runtime_error{"Failed to compile screen quad shader"};
         }
+        pipeline.setStage(*vertexStage);
+        pipeline.setStage(fragmentStage);
 
         // Prepare mesh data
         std::vector<Vert> vertices;
@@ -61,8 +69,8 @@ struct ScreenQuadRenderer {
 void renderScreenQuadTexture(const render::Texture2D& texture) {
     static ScreenQuadRenderer renderer;
 
-    renderer.shader.use();
-    renderer.shader.setTexture("scene", texture, 0);
+    renderer.pipeline.use();
+    renderer.fragmentStage.setTexture("scene", texture, 0);
     glDisable(GL_DEPTH_TEST);
     renderer.mesh.render();
     glEnable(GL_DEPTH_TEST);
@@ -71,19 +79,22 @@ void renderScreenQuadTexture(const render::Texture2D& texture) {
 void renderScreenQuadSplit(const render::Texture2D& left, const render::Texture2D& right) {
     static ScreenQuadRenderer renderer;
     static render::ShaderProgram splitShader;
+    static render::ProgramPipeline splitPipeline;
     static bool splitReady = false;
 
     if (!splitReady) {
-        if (!splitShader.compileFromFiles(
-            getResourcePath("engine/shaders/screen_quad.vert"),
-            getResourcePath("engine/shaders/screen_quad_split.frag")
+        if (!splitShader.compileStagePrecompiled(
+            render::ShaderStage::FRAGMENT,
+            "engine/shaders/screen_quad_split.frag"
         )) {
             throw std::runtime_error{"Failed to compile screen quad split shader"};
         }
+        splitPipeline.setStage(*renderer.vertexStage);
+        splitPipeline.setStage(splitShader);
         splitReady = true;
     }
 
-    splitShader.use();
+    splitPipeline.use();
     splitShader.setTexture("scene", left, 0);
     splitShader.setTexture("processed", right, 1);
     glDisable(GL_DEPTH_TEST);
@@ -1,13 +1,72 @@
+#include <cstdlib>
+#include <filesystem>
+#include <stdexcept>
+
 #include "tmig/util/resources.hpp"
+#include "tmig/util/file.hpp"
 
 #ifndef PROJECT_ROOT_FOLDER
 #define PROJECT_ROOT_FOLDER ""
 #endif
 
+#ifndef TMIG_SPIRV_FOLDER
+#define TMIG_SPIRV_FOLDER ""
+#endif
+
 namespace tmig::util {
 
+namespace {
+
+std::string& resourceOverrideFolder() {
+    static std::string folder = [] {
+        const char* env = std::getenv("TMIG_RESOURCE_OVERRIDE");
+        return std::string{env ? env : ""};
+    }();
+    return folder;
+}
+
+} // namespace
+
 std::string getResourcePath(const std::string& path) {
     return std::string{PROJECT_ROOT_FOLDER} + "/resources/" + path;
 }
 
+void setResourceOverrideFolder(const std::string& folder) {
+    resourceOverrideFolder() = folder;
+}
+
+std::string readResource(const std::string& path) {
+    const std::string& overrideFolder = resourceOverrideFolder();
+    if (!overrideFolder.empty()) {
+        const std::string overridePath = overrideFolder + "/" + path;
+        if (std::filesystem::exists(overridePath)) {
+            return readFileContent(overridePath);
+        }
+    }
+
+    if (auto embedded = getEmbeddedResource(path)) {
+        return std::string{*embedded};
+    }
+
+    const std::string resourcePath = getResourcePath(path);
+    if (std::filesystem::exists(resourcePath)) {
+        return readFileContent(resourcePath);
+    }
+
+    throw std::runtime_error{"[util::readResource] Resource not found: " + path};
+}
+
+std::string getSpirvPath(const std::string& path) {
+    const std::string spirvFolder{TMIG_SPIRV_FOLDER};
+    if (spirvFolder.empty()) return "";
+
+    // An overridden resource is being iterated on, so its binary is stale
+    const std::string& overrideFolder = resourceOverrideFolder();
+    if (!overrideFolder.empty() && std::filesystem::exists(overrideFolder + "/" + path)) return "";
+
+    // Binaries mirror the resources/ tree, e.g. engine/shaders/blur.frag -> engine/shaders/blur.frag.spv
+    const std::string binaryPath = spirvFolder + "/" + path + ".spv";
+    return std::filesystem::exists(binaryPath) ? binaryPath : "";
+}
+
 } // namespace tmig::util
\ No newline at end of file
@@ -6,11 +6,13 @@
 #include "tmig/render/render.hpp"
 #include "tmig/render/instanced_mesh.hpp"
 #include "tmig/render/framebuffer.hpp"
+#include "tmig/render/render_graph.hpp"
 #include "tmig/render/uniform_buffer.hpp"
 #include "tmig/render/window.hpp"
 #include "tmig/render/shader.hpp"
 #include "tmig/render/texture2D.hpp"
 #include "tmig/render/postprocessing/bloom.hpp"
+#include "tmig/render/postprocessing/tone_mapping.hpp"
 #include "tmig/render/ui.hpp"
 #include "tmig/util/camera_controller.hpp"
 #include "tmig/util/shapes.hpp"
@@ -180,45 +182,35 @@ int main() {
     render::UniformBuffer<SceneData> ubo;
     ubo.bindTo(0);
 
-    render::Framebuffer sceneFramebuffer;
-    render::Texture2D sceneDepthTexture;
-    render::Texture2D sceneOutputTexture;
-    sceneOutputTexture.setWrapS(render::TextureWrapMode::CLAMP_TO_EDGE);
-    sceneOutputTexture.setWrapT(render::TextureWrapMode::CLAMP_TO_EDGE);
-    sceneOutputTexture.setMinFilter(render::TextureMinFilter::LINEAR);
-    sceneOutputTexture.setMagFilter(render::TextureMagFilter::LINEAR);
-    auto status = sceneFramebuffer.setup({
-        .width = 1280,
-        .height = 720,
-        .colorAttachments = {
-            {0, render::FramebufferAttachment{
-                .texture = &sceneOutputTexture,
-                .format = render::TextureFormat::RGBA16F,
-            }},
-        },
-        .depthAttachment = render::FramebufferDepthAttachment{
-            .texture = &sceneDepthTexture,
-            .format = render::DepthAttachmentFormat::DEPTH24_STENCIL8,
-        },
-    });
-    if (status != render::Framebuffer::Status::COMPLETE) {
-        std::cerr << "Framebuffer failed; status: " << status << "\n";
-        return 1;
-    }
+    // The frame is described as a render graph; scene color and depth are transient textures it owns
+    render::RenderGraph renderGraph;
 
+    // Intermediate targets of every effect come from this pool
+    auto targetPool = render::getSharedRenderTargetPool();
     render::postprocessing::BloomEffect bloomEffect{{
+        .mode = render::postprocessing::BloomMode::PROGRESSIVE,
         .brightPassWidth = 1920,
         .brightPassHeight = 1080,
         .blurWidth = 1280,
         .blurHeight = 720,
         .outputWidth = 1920,
         .outputHeight = 1080,
+        // Kept HDR for the tone mapping that follows
+        .outputFormat = render::TextureFormat::RGBA16F,
     }};
     bloomEffect.setThreshold(1.0f);
     bloomEffect.setOffsetScale(1.2f);
     bloomEffect.setStrength(1.1f);
 
+    // Auto-exposure and tone mapping of the HDR result
+    render::postprocessing::ToneMappingEffect toneMapping;
+
     bool applyBloom = true;
+    bool applyToneMapping = true;
+    bool autoExposure = toneMapping.isAutoExposure();
+    bool aces = toneMapping.getOperator() == render::postprocessing::ToneMapOperator::ACES;
+    float exposureCompensation = toneMapping.getExposureCompensation();
+    bool progressive = true;
     bool splitView = true;
     bool animate = true;
     float threshold = bloomEffect.getThreshold();
@@ -234,6 +226,7 @@ int main() {
     while (!render::window::shouldClose()) {
         core::input::update();
         render::ui::beginFrame();
+        targetPool->beginFrame();
 
         float runtime = static_cast<float>(render::window::getRuntime());
         if (timeStep.update(runtime)) {
@@ -249,12 +242,17 @@ int main() {
 
         const auto viewport = ImGui::GetMainViewport();
         ImGui::SetNextWindowPos(ImVec2(viewport->WorkPos.x + 10, viewport->WorkPos.y + 10));
-        ImGui::SetNextWindowSize(ImVec2(300, 250));
+        ImGui::SetNextWindowSize(ImVec2(300, 400));
         ImGui::Begin("Bloom", nullptr, ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoResize);
         ImGui::TextWrapped("HDR neon orbs over a dark plaza. Bloom extracts bright pixels, blurs them, then composites.");
         ImGui::Separator();
         ImGui::Checkbox("Apply bloom", &applyBloom);
-        ImGui::Checkbox("Split view (raw | bloom)", &splitView);
+        if (ImGui::Checkbox("Progressive (mip chain)", &progressive)) {
+            bloomEffect.setMode(progressive
+                ? render::postprocessing::BloomMode::PROGRESSIVE
+                : render::postprocessing::BloomMode::GAUSSIAN);
+        }
+        ImGui::Checkbox("Split view (raw | processed)", &splitView);
         ImGui::Checkbox("Animate", &animate);
         if (ImGui::SliderFloat("Threshold", &threshold, 0.2f, 4.0f)) {
             bloomEffect.setThreshold(threshold);
@@ -266,11 +264,28 @@ int main() {
             bloomEffect.setOffsetScale(offsetScale);
         }
         ImGui::SliderFloat("Emissive gain", &emissiveGain, 1.0f, 40.0f);
+        ImGui::Separator();
+        ImGui::Checkbox("Tone mapping", &applyToneMapping);
+        if (ImGui::Checkbox("Auto-exposure", &autoExposure)) {
+            toneMapping.setAutoExposure(autoExposure);
+        }
+        ImGui::SameLine();
+        if (ImGui::Checkbox("ACES", &aces)) {
+            toneMapping.setOperator(aces
+                ? render::postprocessing::ToneMapOperator::ACES
+                : render::postprocessing::ToneMapOperator::REINHARD);
+        }
+        if (ImGui::SliderFloat("Exposure (EV)", &exposureCompensation, -4.0f, 4.0f)) {
+            toneMapping.setExposureCompensation(exposureCompensation);
+        }
+        ImGui::Text(
+            "Pooled targets: %zu (%.1f MB)",
+            targetPool->targetCount(), targetPool->memorySize() / (1024.0 * 1024.0)
+        );
         ImGui::End();
 
         auto windowSize = render::window::getSize();
-        if (windowSize != lastSize && windowSize.x > 0 && windowSize.y > 0) {
-            sceneFramebuffer.resize(static_cast<uint32_t>(windowSize.x), static_cast<uint32_t>(windowSize.y));
+        if (windowSize.x > 0 && windowSize.y > 0) {
             lastSize = windowSize;
         }
 
@@ -289,6 +304,7 @@ int main() {
         torusInstanceBuffer.setSubset(0, 1, &torusInstance);
 
         camController.update(camera, timeStep.dt());
+        toneMapping.setDeltaTime(timeStep.dt());
 
         sceneDataUBO.viewPos = camera.getPosition();
         sceneDataUBO.view = camera.getViewMatrix();
@@ -299,29 +315,45 @@ int main() {
         );
         ubo.setData(sceneDataUBO);
 
-        sceneFramebuffer.bind();
-        meshShader.use();
-        meshShader.setBool("applyTexture", false);
-        boxMesh.render();
-        orbMesh.render();
-        torusMesh.render();
+        const auto width = static_cast<uint32_t>(lastSize.x);
+        const auto height = static_cast<uint32_t>(lastSize.y);
+
+        renderGraph.reset();
+        render::RenderGraphTexture sceneColor;
+        renderGraph.addPass("scene", [&](render::RenderGraph::PassBuilder& builder) {
+            sceneColor = builder.write(builder.create("scene color", {width, height, render::TextureFormat::RGBA16F}));
+            builder.writeDepth(builder.create("scene depth", {width, height, render::TextureFormat::DEPTH24_STENCIL8}));
+        }, [&](const render::RenderGraph::PassContext&) {
+            meshShader.use();
+            meshShader.setBool("applyTexture", false);
+            boxMesh.render();
+            orbMesh.render();
+            torusMesh.render();
+        });
+
+        renderGraph.addPass("composite", [&](render::RenderGraph::PassBuilder& builder) {
+            builder.read(sceneColor);
+            builder.sideEffect();
+        }, [&](const render::RenderGraph::PassContext& ctx) {
+            const auto& sceneTexture = ctx.texture(sceneColor);
+            const auto* processedTexture = applyBloom ? &bloomEffect.apply(sceneTexture) : nullptr;
+            if (applyToneMapping) {
+                processedTexture = &toneMapping.apply(processedTexture ? *processedTexture : sceneTexture);
+            }
 
-        if (applyBloom) {
-            const auto& bloomTexture = bloomEffect.apply(sceneOutputTexture);
             render::Framebuffer::bindDefault(windowSize.x, windowSize.y, {
                 .clearColor = true, .clearStencil = false, .clearDepth = false
             });
-            if (splitView) {
-                util::renderScreenQuadSplit(sceneOutputTexture, bloomTexture);
+            if (!processedTexture) {
+                util::renderScreenQuadTexture(sceneTexture);
+            } else if (splitView) {
+                util::renderScreenQuadSplit(sceneTexture, *processedTexture);
             } else {
-                util::renderScreenQuadTexture(bloomTexture);
+                util::renderScreenQuadTexture(*processedTexture);
             }
-        } else {
-            render::Framebuffer::bindDefault(windowSize.x, windowSize.y, {
-                .clearColor = true, .clearStencil = false, .clearDepth = false
-            });
-            util::renderScreenQuadTexture(sceneOutputTexture);
-        }
+        });
+
+        renderGraph.execute();
 
         render::ui::endFrame();
         render::window::swapBuffers();
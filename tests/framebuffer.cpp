@@ -6,9 +6,17 @@
 #include "tmig/render/render.hpp"
 #include "tmig/render/instanced_mesh.hpp"
 #include "tmig/render/framebuffer.hpp"
+#include "tmig/render/renderbuffer.hpp"
+#include "tmig/render/dynamic_resolution.hpp"
+#include "tmig/render/render_target_pool.hpp"
+#include "tmig/render/postprocessing/upscale.hpp"
+#include "tmig/render/postprocessing/chain.hpp"
+#include "tmig/render/postprocessing/reduced_resolution.hpp"
+#include "tmig/render/postprocessing/blur.hpp"
 #include "tmig/render/uniform_buffer.hpp"
 #include "tmig/render/window.hpp"
 #include "tmig/render/shader.hpp"
+#include "tmig/render/program_pipeline.hpp"
 #include "tmig/render/texture2D.hpp"
 #include "tmig/render/ui.hpp"
 #include "tmig/util/camera_controller.hpp"
@@ -59,6 +67,8 @@ static glm::mat4 trs(const glm::vec3& pos, const glm::vec3& scale, float angle =
 int main() {
     srand(7);
 
+    // The scene gets its MSAA from a multisampled framebuffer, so the window needs no samples
+    render::window::init(600, 600, "tmig", 0);
     render::init();
     render::ui::init();
     render::window::setSize({1280, 720});
@@ -76,17 +86,26 @@ int main() {
         return 1;
     }
 
+    // The screen quad vertex stage is the one the post-processing effects below already share
+    auto screenQuadStage = render::getSharedStage(
+        render::ShaderStage::VERTEX,
+        "engine/shaders/screen_quad.vert"
+    );
     render::ShaderProgram postProcessingShader;
-    if (!postProcessingShader.compileFromFiles(
-        util::getResourcePath("engine/shaders/screen_quad.vert"),
+    if (!screenQuadStage || !postProcessingShader.compileStageFromFile(
+        render::ShaderStage::FRAGMENT,
         util::getResourcePath("shaders/post_processing.frag")
     )) {
         std::cerr << "Failed loading post_processing shader\n";
         return 1;
     }
 
+    render::ProgramPipeline postProcessingPipeline;
+    postProcessingPipeline.setStage(*screenQuadStage);
+    postProcessingPipeline.setStage(postProcessingShader);
+
     render::Texture2D texture;
-    if (!texture.loadFromFile(util::getResourcePath("images/awesomeface.png"))) {
+    if (!texture.loadFromFile(util::getResourcePath("images/awesomeface.png"), {.mipmaps = true})) {
         std::cerr << "Failed to load texture\n";
         return 1;
     }
@@ -94,7 +113,6 @@ int main() {
     texture.setWrapT(render::TextureWrapMode::MIRRORED_REPEAT);
     texture.setMinFilter(render::TextureMinFilter::LINEAR_MIPMAP_LINEAR);
     texture.setMagFilter(render::TextureMagFilter::LINEAR);
-    texture.generateMipmaps();
 
     std::vector<InstanceData> instances;
 
@@ -203,8 +221,9 @@ int main() {
     render::UniformBuffer<SceneData> ubo;
     ubo.bindTo(0);
 
+    // Depth is never sampled, so a renderbuffer will do; its content can be dropped once the frame is drawn
     render::Texture2D sceneOutputTexture;
-    render::Texture2D sceneDepthTexture;
+    render::Renderbuffer sceneDepthBuffer;
     sceneOutputTexture.setWrapS(render::TextureWrapMode::CLAMP_TO_EDGE);
     sceneOutputTexture.setWrapT(render::TextureWrapMode::CLAMP_TO_EDGE);
 
@@ -219,8 +238,9 @@ int main() {
             }},
         },
         .depthAttachment = render::FramebufferDepthAttachment{
-            .texture = &sceneDepthTexture,
             .format = render::DepthAttachmentFormat::DEPTH24_STENCIL8,
+            .renderbuffer = &sceneDepthBuffer,
+            .transient = true,
         },
     });
     if (status != render::Framebuffer::Status::COMPLETE) {
@@ -228,6 +248,56 @@ int main() {
         return 1;
     }
 
+    // Scene is drawn at 4x MSAA, then resolved into `fb` for post-processing; multisampled content is only
+    // needed until the resolve
+    render::Renderbuffer sceneMsaaBuffer;
+    render::Renderbuffer sceneMsaaDepthBuffer;
+    render::Framebuffer msaaFb;
+    status = msaaFb.setup({
+        .width = 1920,
+        .height = 1080,
+        .colorAttachments = {
+            {0, render::FramebufferAttachment{
+                .format = render::TextureFormat::RGBA8,
+                .renderbuffer = &sceneMsaaBuffer,
+                .transient = true,
+            }},
+        },
+        .depthAttachment = render::FramebufferDepthAttachment{
+            .format = render::DepthAttachmentFormat::DEPTH24_STENCIL8,
+            .renderbuffer = &sceneMsaaDepthBuffer,
+            .transient = true,
+        },
+        .samples = 4,
+    });
+    if (status != render::Framebuffer::Status::COMPLETE) {
+        std::cerr << "MSAA framebuffer failed; status: " << status << "\n";
+        return 1;
+    }
+
+    // Scene drawn at a resolution keeping the GPU under the target frame time, then upscaled + sharpened
+    render::DynamicResolution dynamicResolution{{.maxWidth = 2560, .maxHeight = 1440}};
+    render::postprocessing::UpscaleEffect upscale;
+    auto targetPool = render::getSharedRenderTargetPool();
+
+    // Stacked effects; consecutive point-wise ones are fused into a single pass
+    render::postprocessing::InvertEffect invertEffect;
+    render::postprocessing::GrayscaleEffect grayscaleEffect;
+    render::postprocessing::VignetteEffect vignetteEffect;
+    render::postprocessing::BlurEffect blurEffect;
+    render::postprocessing::PostProcessChain chain;
+
+    // Same blur on a half resolution copy of the scene, upsampled back (no G-buffer here, so bilinearly)
+    render::postprocessing::BlurEffect halfBlurEffect{{.width = 640, .height = 360}};
+    render::postprocessing::ReducedResolutionEffect reducedBlur{halfBlurEffect};
+    bool halfResolutionBlur = false;
+    bool chainInvert = false;
+    bool chainGrayscale = false;
+    bool chainBlur = false;
+    bool chainVignette = false;
+    bool computeBlur = false;
+    int blurRadius = static_cast<int>(blurEffect.getRadius());
+
     const char* effects[] = {
         "None", "Sharpen", "Outline", "Emboss", "Blur",
         "Invert", "Grayscale", "Chromatic aberration", "Vignette"
@@ -237,6 +307,10 @@ int main() {
     float offset = 1.0f / 600.0f;
     bool splitView = true;
     bool animate = true;
+    bool msaa = true;
+    bool dynamicRes = false;
+    float targetFps = 60.0f;
+    float sharpness = upscale.getSharpness();
     glm::ivec2 lastSize{1280, 720};
 
     util::TimeStep timeStep;
@@ -261,7 +335,7 @@ int main() {
 
         const auto viewport = ImGui::GetMainViewport();
         ImGui::SetNextWindowPos(ImVec2(viewport->WorkPos.x + 10, viewport->WorkPos.y + 10));
-        ImGui::SetNextWindowSize(ImVec2(340, 250));
+        ImGui::SetNextWindowSize(ImVec2(340, 530));
         ImGui::Begin("Framebuffer", nullptr, ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoResize);
         ImGui::TextWrapped(
             "Scene is rendered off-screen into a Framebuffer texture, then a screen-space "
@@ -273,12 +347,46 @@ int main() {
         ImGui::SliderFloat("Kernel offset", &offset, 0.0002f, 0.01f, "%.4f");
         ImGui::Checkbox("Split view (raw | processed)", &splitView);
         ImGui::Checkbox("Animate", &animate);
+        ImGui::Checkbox("4x MSAA", &msaa);
         ImGui::Text("FBO %ux%u  |  window %dx%d", fb.width(), fb.height(), lastSize.x, lastSize.y);
+        ImGui::Separator();
+        ImGui::Checkbox("Dynamic resolution (no MSAA)", &dynamicRes);
+        ImGui::SliderFloat("Target FPS", &targetFps, 30.0f, 240.0f, "%.0f");
+        if (ImGui::SliderFloat("Sharpness", &sharpness, 0.0f, 1.0f)) {
+            upscale.setSharpness(sharpness);
+        }
+        ImGui::Text(
+            "Scale %.2f  |  %ux%u  |  GPU %.2f ms",
+            dynamicResolution.scale(), dynamicResolution.renderWidth(), dynamicResolution.renderHeight(),
+            dynamicResolution.gpuFrameTime()
+        );
+        ImGui::Separator();
+        ImGui::Checkbox("Invert", &chainInvert);
+        ImGui::SameLine();
+        ImGui::Checkbox("Grayscale", &chainGrayscale);
+        ImGui::Checkbox("Blur", &chainBlur);
+        ImGui::SameLine();
+        ImGui::Checkbox("Vignette", &chainVignette);
+        ImGui::SameLine();
+        ImGui::Checkbox("Half-res blur", &halfResolutionBlur);
+        if (ImGui::Checkbox("Compute blur", &computeBlur)) {
+            const auto method = computeBlur
+                ? render::postprocessing::BlurMethod::COMPUTE
+                : render::postprocessing::BlurMethod::FRAGMENT;
+            blurEffect.setMethod(method);
+            halfBlurEffect.setMethod(method);
+        }
+        if (ImGui::SliderInt("Blur radius", &blurRadius, 1, render::postprocessing::BlurEffect::MAX_RADIUS)) {
+            blurEffect.setRadius(static_cast<uint32_t>(blurRadius));
+            halfBlurEffect.setRadius(static_cast<uint32_t>(blurRadius));
+        }
+        ImGui::Text("Chain: %zu effects in %zu passes", chain.size(), chain.passCount());
         ImGui::End();
 
         auto windowSize = render::window::getSize();
         if (windowSize != lastSize && windowSize.x > 0 && windowSize.y > 0) {
             fb.resize(static_cast<uint32_t>(windowSize.x), static_cast<uint32_t>(windowSize.y));
+            msaaFb.resize(static_cast<uint32_t>(windowSize.x), static_cast<uint32_t>(windowSize.y));
             lastSize = windowSize;
         }
 
@@ -308,27 +416,56 @@ int main() {
         );
         ubo.setData(sceneDataUBO);
 
-        fb.bind();
+        targetPool->beginFrame();
+        dynamicResolution.setTargetFrameTime(1000.0f / targetFps);
+        dynamicResolution.beginFrame(static_cast<uint32_t>(windowSize.x), static_cast<uint32_t>(windowSize.y));
+
+        if (dynamicRes) {
+            dynamicResolution.bind();
+        } else if (msaa) {
+            msaaFb.bind();
+        } else {
+            fb.bind();
+        }
         shader.use();
         shader.setBool("applyTexture", true);
         shader.setTexture("tex", texture, 0);
         boxMesh.render();
         torusMesh.render();
+        const render::Texture2D* sceneTexture = &sceneOutputTexture;
+        if (dynamicRes) {
+            upscale.setOutputSize(static_cast<uint32_t>(windowSize.x), static_cast<uint32_t>(windowSize.y));
+            upscale.setSourceRegion(dynamicResolution.uvScale());
+            sceneTexture = &upscale.apply(dynamicResolution.texture());
+        } else if (msaa) {
+            msaaFb.resolveTo(fb);
+        }
+
+        // Built every frame; fused shaders are cached, so this only compiles new combinations
+        chain.clear();
+        if (chainInvert)    chain.add(invertEffect);
+        if (chainGrayscale) chain.add(grayscaleEffect);
+        if (chainBlur)      chain.add(halfResolutionBlur
+                                ? static_cast<render::postprocessing::Effect&>(reducedBlur)
+                                : blurEffect);
+        if (chainVignette)  chain.add(vignetteEffect);
+        sceneTexture = &chain.apply(*sceneTexture);
 
         render::Framebuffer::bindDefault(windowSize.x, windowSize.y, {
             .clearColor = true, .clearStencil = false, .clearDepth = false
         });
 
-        postProcessingShader.use();
+        postProcessingPipeline.use();
         postProcessingShader.setInt("effect", effect);
         postProcessingShader.setFloat("intensity", intensity);
         postProcessingShader.setFloat("offset", offset);
         postProcessingShader.setBool("splitView", splitView);
-        postProcessingShader.setTexture("scene", sceneOutputTexture, 0);
+        postProcessingShader.setTexture("scene", *sceneTexture, 0);
 
         glDisable(GL_DEPTH_TEST);
         screenQuadMesh.render();
         glEnable(GL_DEPTH_TEST);
+        dynamicResolution.endFrame();
 
         render::ui::endFrame();
         render::window::swapBuffers();
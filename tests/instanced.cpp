@@ -75,7 +75,7 @@ int main() {
     }
 
     render::Texture2D texture;
-    if (!texture.loadFromFile(util::getResourcePath("images/container.jpg"))) {
+    if (!texture.loadFromFile(util::getResourcePath("images/container.jpg"), {.mipmaps = true})) {
         std::cerr << "Failed to load texture\n";
         return 1;
     }
@@ -83,7 +83,6 @@ int main() {
     texture.setWrapT(render::TextureWrapMode::MIRRORED_REPEAT);
     texture.setMinFilter(render::TextureMinFilter::LINEAR_MIPMAP_LINEAR);
     texture.setMagFilter(render::TextureMagFilter::LINEAR);
-    texture.generateMipmaps();
 
     constexpr int kMaxInstances = 200000;
     std::vector<InstanceData> instances(kMaxInstances);
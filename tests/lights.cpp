@@ -264,6 +264,8 @@ int main() {
         return 1;
     }
 
+    // Intermediate targets of every effect come from this pool
+    auto targetPool = render::getSharedRenderTargetPool();
     render::postprocessing::BloomEffect bloomEffect{{
         .brightPassWidth = 1920,
         .brightPassHeight = 1080,
@@ -297,6 +299,7 @@ int main() {
     while (!render::window::shouldClose()) {
         core::input::update();
         render::ui::beginFrame();
+        targetPool->beginFrame();
 
         float runtime = static_cast<float>(render::window::getRuntime());
         if (timeStep.update(runtime)) {
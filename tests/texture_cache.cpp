@@ -0,0 +1,88 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <filesystem>
+#include <algorithm>
+#include <functional>
+
+#include "tmig/render/render.hpp"
+#include "tmig/render/window.hpp"
+#include "tmig/render/texture2D.hpp"
+#include "tmig/util/resources.hpp"
+
+#include "glad/glad.h"
+
+using namespace tmig;
+
+// Compares cold loads (decode + mipmaps, baking on the way) with warm loads from baked textures.
+// Usage: texture_cache [image folder]; defaults to resources/images
+int main(int argc, char** argv) {
+    const std::filesystem::path imageFolder = argc > 1 ? argv[1] : util::getResourcePath("images");
+    const std::filesystem::path bakeFolder = std::filesystem::temp_directory_path() / "tmig_texture_bake";
+
+    std::vector<std::string> images;
+    for (const auto& entry : std::filesystem::directory_iterator{imageFolder}) {
+        std::string extension = entry.path().extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+        if (extension == ".png" || extension == ".jpg" || extension == ".jpeg" ||
+            extension == ".tga" || extension == ".bmp" || extension == ".hdr") {
+            images.push_back(entry.path().string());
+        }
+    }
+    if (images.empty()) {
+        std::cerr << "No images found in " << imageFolder << "\n";
+        return 1;
+    }
+
+    render::init();
+    render::window::setTitle("texture_cache");
+
+    const render::TextureLoadOptions options{.flipY = true, .srgb = true, .mipmaps = true};
+
+    // Milliseconds to load every image, including the GPU work
+    auto loadAll = [&]() {
+        const auto start = std::chrono::steady_clock::now();
+        size_t bytes = 0;
+        for (const auto& path : images) {
+            render::Texture2D texture;
+            if (!texture.loadFromFile(path, options)) {
+                std::cerr << "Failed loading " << path << "\n";
+                continue;
+            }
+            bytes += texture.memorySize();
+        }
+        glFinish();
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        return std::make_pair(elapsed.count(), bytes);
+    };
+
+    auto report = [&](const char* name, std::pair<double, size_t> result) {
+        std::cout << std::left << std::setw(28) << name
+                  << std::right << std::setw(10) << std::fixed << std::setprecision(2) << result.first << " ms"
+                  << std::setw(10) << std::setprecision(1) << result.second / (1024.0 * 1024.0) << " MB\n";
+    };
+
+    std::cout << images.size() << " images from " << imageFolder << "\n\n";
+
+    // Warm up the driver and the OS file cache, so the first measurement isn't penalized
+    render::setTextureBakeFolder("");
+    loadAll();
+    report("decode (no baking)", loadAll());
+
+    std::filesystem::remove_all(bakeFolder);
+    render::setTextureBakeFolder(bakeFolder.string());
+    report("cold (decode + bake)", loadAll());
+
+    constexpr int WARM_RUNS = 5;
+    std::pair<double, size_t> best{1e30, 0};
+    for (int i = 0; i < WARM_RUNS; i++) {
+        const auto result = loadAll();
+        if (result.first < best.first) best = result;
+    }
+    report("warm (baked, best of 5)", best);
+
+    std::filesystem::remove_all(bakeFolder);
+    return 0;
+}